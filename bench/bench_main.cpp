@@ -0,0 +1,501 @@
+// Headless, deterministic benchmark of game::do_turn.
+//
+// Loads the game data like the test harness does (without curses or SDL output)
+// and a saved benchmark world, which the first run creates, so every run starts
+// from the same overmap and submaps. It then sets up one or more scripted
+// scenarios in the reality bubble and advances them a fixed number of turns,
+// reporting throughput, turn latency percentiles, the per-phase timings collected
+// by the turn profiler and the peak memory of the whole run.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#include "avatar.h"
+#include "background_writer.h"
+#include "calendar.h"
+#include "debug.h"
+#include "field.h"
+#include "filesystem.h"
+#include "game.h"
+#include "item_group.h"
+#include "loading_ui.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "options.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "path_info.h"
+#include "pldata.h"
+#include "rng.h"
+#include "turn_profiler.h"
+#include "type_id.h"
+#include "vehicle.h"
+#include "worldfactory.h"
+
+struct bench_options {
+    std::vector<std::string> scenarios;
+    std::vector<mod_id> mods;
+    /** Values for game options, applied after the defaults above. */
+    std::vector<std::pair<std::string, std::string>> option_values;
+    std::string user_dir = "./";
+    std::string world = "cata_bench";
+    int turns = 1000;
+    int monsters = 200;
+    unsigned int seed = 42;
+};
+
+/** Not called scenario, which would clash with the game's scenario class. */
+struct bench_scenario {
+    std::string name;
+    std::string description;
+    /** Prepares the reality bubble, called once before the timed turns. */
+    std::function<void( const bench_options & )> setup;
+    /** Called after every turn, outside of the timed region. */
+    std::function<void()> after_turn;
+};
+
+struct scenario_result {
+    std::string name;
+    int turns = 0;
+    double seconds = 0.0;
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+// Player position used by all scenarios, between the buildings of the city so it
+// does not get in the way of the scenario itself. Like in the game it must be far
+// enough from the edge of the bubble for the scent map around the player.
+static const tripoint player_pos( 64, 86, 0 );
+
+static long peak_rss_kb()
+{
+#if defined(_WIN32)
+    return 0;
+#else
+    rusage usage;
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 ) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    // Reported in bytes on macOS, in kilobytes everywhere else.
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+/** Walls the player in with solid rock so no scenario can end the game. */
+static void enclose_player()
+{
+    g->u.setpos( player_pos );
+    for( const tripoint &p : g->m.points_in_radius( player_pos, 1 ) ) {
+        if( p != player_pos ) {
+            g->m.ter_set( p, t_rock );
+        }
+    }
+}
+
+/** A wooden building with furniture and household items. */
+static void build_house( const tripoint &corner, const int size )
+{
+    for( int x = 0; x < size; x++ ) {
+        for( int y = 0; y < size; y++ ) {
+            const tripoint p = corner + point( x, y );
+            const bool edge = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+            if( !edge ) {
+                g->m.ter_set( p, t_floor );
+                if( x % 4 == 1 && y % 3 == 1 ) {
+                    g->m.furn_set( p, one_in( 2 ) ? f_table : f_chair );
+                }
+            } else if( x == size / 2 && y == size - 1 ) {
+                g->m.ter_set( p, t_door_c );
+            } else if( ( x + y ) % 5 == 0 ) {
+                g->m.ter_set( p, t_window );
+            } else {
+                g->m.ter_set( p, t_wall_wood );
+            }
+        }
+    }
+    const tripoint inner_from = corner + point( 1, 1 );
+    const tripoint inner_to = corner + point( size - 2, size - 2 );
+    g->m.place_items( "livingroom", 60, inner_from, inner_to, false, calendar::turn );
+    g->m.place_items( "kitchen", 60, inner_from, inner_to, false, calendar::turn );
+}
+
+static void spawn_horde( const int count, const tripoint &center, const int radius )
+{
+    int spawned = 0;
+    for( int tries = 0; spawned < count && tries < count * 20; tries++ ) {
+        const tripoint p = center + point( rng( -radius, radius ), rng( -radius, radius ) );
+        if( !g->m.inbounds( p ) || !g->m.passable( p ) || g->critter_at( p ) != nullptr ) {
+            continue;
+        }
+        spawn_test_monster( "mon_zombie", p );
+        spawned++;
+    }
+}
+
+static std::vector<vehicle *> convoy;
+static std::vector<tripoint> convoy_start;
+
+static void setup_idle( const bench_options & )
+{
+    enclose_player();
+}
+
+static void setup_city( const bench_options &opts )
+{
+    const int block = 22;
+    for( int bx = 0; bx < 5; bx++ ) {
+        for( int by = 0; by < 5; by++ ) {
+            build_house( tripoint( 22 + bx * block, 22 + by * block, 0 ), block - 4 );
+        }
+    }
+    enclose_player();
+    spawn_horde( opts.monsters / 4, tripoint( 66, 66, 0 ), 60 );
+}
+
+static void setup_horde( const bench_options &opts )
+{
+    enclose_player();
+    spawn_horde( opts.monsters, tripoint( 80, 80, 0 ), 45 );
+}
+
+static void setup_convoy( const bench_options & )
+{
+    convoy.clear();
+    convoy_start.clear();
+    for( int lane = 0; lane < 6; lane++ ) {
+        const tripoint start( 30 + lane * 15, 100, 0 );
+        vehicle *veh = g->m.add_vehicle( vproto_id( "car" ), start, -90, 100, 0 );
+        if( veh == nullptr ) {
+            continue;
+        }
+        veh->tags.insert( "IN_CONTROL_OVERRIDE" );
+        veh->engine_on = true;
+        veh->cruise_velocity = std::min( 50 * 100, veh->safe_ground_velocity( false ) );
+        veh->velocity = veh->cruise_velocity;
+        convoy.push_back( veh );
+        convoy_start.push_back( veh->global_pos3() );
+    }
+    enclose_player();
+}
+
+static void after_turn_convoy()
+{
+    // Bring the vehicles back to where they started so they never leave the bubble.
+    for( size_t i = 0; i < convoy.size(); i++ ) {
+        tripoint pos = convoy[i]->global_pos3();
+        if( pos != convoy_start[i] ) {
+            vehicle *moved = g->m.displace_vehicle( pos, convoy_start[i] - pos );
+            if( moved != nullptr ) {
+                convoy[i] = moved;
+            }
+        }
+    }
+}
+
+static void setup_fire( const bench_options & )
+{
+    build_house( tripoint( 40, 40, 0 ), 50 );
+    for( int i = 0; i < 10; i++ ) {
+        g->m.add_field( tripoint( 45 + i * 4, 45 + ( i % 3 ) * 15, 0 ), fd_fire, 3 );
+    }
+    enclose_player();
+}
+
+static std::vector<bench_scenario> all_scenarios()
+{
+    return {
+        { "idle", "empty bubble, baseline cost of a turn", setup_idle, nullptr },
+        { "city", "25 furnished wooden buildings full of items and some zombies", setup_city, nullptr },
+        { "horde", "a zombie horde (--monsters) converging on the player", setup_horde, nullptr },
+        { "convoy", "six cars driving at 50 mph", setup_convoy, after_turn_convoy },
+        { "fire", "a large furnished building burning down", setup_fire, nullptr },
+    };
+}
+
+static void reset_bubble()
+{
+    clear_map();
+    convoy.clear();
+    convoy_start.clear();
+    g->u.setpos( player_pos );
+}
+
+static scenario_result run_scenario( const bench_scenario &scen, const bench_options &opts )
+{
+    rng_set_engine_seed( opts.seed );
+    srand( opts.seed );
+    reset_bubble();
+    scen.setup( opts );
+    turn_profiler::reset();
+
+    std::vector<double> latencies;
+    latencies.reserve( opts.turns );
+    const auto start = std::chrono::steady_clock::now();
+    for( int i = 0; i < opts.turns; i++ ) {
+        // Player has no moves left, so do_turn never asks for input.
+        g->u.moves = 0;
+        const auto turn_start = std::chrono::steady_clock::now();
+        g->do_turn();
+        const auto turn_end = std::chrono::steady_clock::now();
+        latencies.push_back( std::chrono::duration<double, std::milli>( turn_end - turn_start ).count() );
+        if( scen.after_turn ) {
+            scen.after_turn();
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    scenario_result result;
+    result.name = scen.name;
+    result.turns = opts.turns;
+    result.seconds = std::chrono::duration<double>( end - start ).count();
+    if( !latencies.empty() ) {
+        std::sort( latencies.begin(), latencies.end() );
+        const auto at = [&latencies]( const double percentile ) {
+            const size_t index = static_cast<size_t>( percentile / 100.0 * ( latencies.size() - 1 ) );
+            return latencies[index];
+        };
+        result.p50_ms = at( 50 );
+        result.p99_ms = at( 99 );
+        result.max_ms = latencies.back();
+    }
+    return result;
+}
+
+static void print_phases()
+{
+    for( int i = 0; i < turn_profiler::num_phases; i++ ) {
+        const turn_profiler::phase p = static_cast<turn_profiler::phase>( i );
+        const turn_profiler::phase_stats &stats = turn_profiler::get_stats( p );
+        if( stats.samples == 0 ) {
+            continue;
+        }
+        printf( "    %-22s mean %8.3f ms  p99 %8.3f ms  max %8.3f ms\n", turn_profiler::phase_name( p ),
+                stats.mean_ms(), stats.percentile_ms( 99 ),
+                std::chrono::duration<double, std::milli>( stats.max ).count() );
+    }
+}
+
+static void init_global_game_state( const bench_options &opts )
+{
+    if( !assure_dir_exist( opts.user_dir ) ) {
+        assert( !"Unable to make user_dir directory. Check permissions." );
+    }
+
+    PATH_INFO::init_base_path( "" );
+    PATH_INFO::init_user_dir( opts.user_dir.c_str() );
+    PATH_INFO::set_standard_filenames();
+
+    if( !assure_dir_exist( FILENAMES["config_dir"] ) ) {
+        assert( !"Unable to make config directory. Check permissions." );
+    }
+
+    if( !assure_dir_exist( FILENAMES["savedir"] ) ) {
+        assert( !"Unable to make save directory. Check permissions." );
+    }
+
+    get_options().init();
+    get_options().load();
+    // Keep the benchmark free of disk I/O and random events.
+    get_options().get_option( "AUTOSAVE" ).setValue( "false" );
+    get_options().get_option( "RANDOM_NPC" ).setValue( "false" );
+    get_options().get_option( "FORCE_REDRAW" ).setValue( "false" );
+    get_options().get_option( "TURN_PROFILER" ).setValue( "true" );
+    for( const auto &option : opts.option_values ) {
+        get_options().get_option( option.first ).setValue( option.second );
+    }
+    init_colors();
+
+    g.reset( new game );
+    g->new_game = true;
+    g->load_static_data();
+
+    world_generator->set_active_world( NULL );
+    world_generator->init();
+    const bool world_saved = world_generator->has_world( opts.world );
+    if( !world_saved ) {
+        WORLD new_world;
+        new_world.world_name = opts.world;
+        new_world.active_mod_order = opts.mods;
+        if( !new_world.save() ) {
+            throw std::runtime_error( "unable to create the benchmark world " + opts.world );
+        }
+        world_generator->init();
+    }
+    WORLDPTR bench_world = world_generator->get_world( opts.world );
+    assert( bench_world != NULL );
+    if( bench_world->active_mod_order != opts.mods ) {
+        throw std::runtime_error( "the world " + opts.world +
+                                  " uses different mods, pick another one with --world" );
+    }
+    world_generator->set_active_world( bench_world );
+
+    loading_ui ui( false );
+    g->load_core_data( ui );
+    g->load_world_modfiles( ui );
+
+    g->u = avatar();
+    g->u.create( PLTYPE_NOW );
+
+    g->m = map( get_option<bool>( "ZLEVELS" ) );
+
+    if( !world_saved ) {
+        overmap_special_batch empty_specials( { 0, 0 } );
+        overmap_buffer.create_custom_overmap( 0, 0, empty_specials );
+    }
+    g->m.load( g->get_levx(), g->get_levy(), g->get_levz(), false );
+    if( !world_saved ) {
+        // Later runs load exactly this overmap and these submaps.
+        try {
+            g->m.save();
+            overmap_buffer.save();
+            MAPBUFFER.save( false, false );
+            background_writer::wait();
+        } catch( const std::exception &err ) {
+            throw std::runtime_error( "unable to save the benchmark world " + opts.world + ": " +
+                                      err.what() );
+        }
+        printf( "Created the benchmark world %s\n", opts.world.c_str() );
+    }
+}
+
+static std::vector<std::string> split( const std::string &s )
+{
+    std::vector<std::string> ret;
+    size_t start = 0;
+    while( start <= s.size() ) {
+        const size_t pos = std::min( s.find( ',', start ), s.size() );
+        if( pos > start ) {
+            ret.push_back( s.substr( start, pos - start ) );
+        }
+        start = pos + 1;
+    }
+    return ret;
+}
+
+static bool starts_with( const char *arg, const char *prefix, std::string &rest )
+{
+    const size_t len = strlen( prefix );
+    if( strncmp( arg, prefix, len ) != 0 ) {
+        return false;
+    }
+    rest = arg + len;
+    return true;
+}
+
+static void print_usage()
+{
+    printf( "Usage: cata_bench [options]\n" );
+    printf( "  --scenarios=<a,b,...>    Scenarios to run (default: all).\n" );
+    printf( "  --turns=<n>              Turns to advance per scenario (default: 1000).\n" );
+    printf( "  --monsters=<n>           Size of the horde scenario (default: 200).\n" );
+    printf( "  --seed=<n>               Random seed (default: 42).\n" );
+    printf( "  --mods=<mod1,mod2,...>   Loads the list of mods before running.\n" );
+    printf( "  --option=<NAME>=<value>  Sets a game option, e.g. --option=MONSTER_FLOW_FIELDS=true.\n" );
+    printf( "  --world=<name>           Saved world to run in, created on the first run (default: cata_bench).\n" );
+    printf( "  --user-dir=<dir>         Set user dir (where the benchmark world is saved).\n" );
+    printf( "Scenarios:\n" );
+    for( const bench_scenario &scen : all_scenarios() ) {
+        printf( "  %-10s %s\n", scen.name.c_str(), scen.description.c_str() );
+    }
+}
+
+int main( int argc, const char *argv[] )
+{
+    bench_options opts;
+    for( int i = 1; i < argc; i++ ) {
+        std::string rest;
+        if( starts_with( argv[i], "--scenarios=", rest ) ) {
+            opts.scenarios = split( rest );
+        } else if( starts_with( argv[i], "--turns=", rest ) ) {
+            opts.turns = std::max( 1, atoi( rest.c_str() ) );
+        } else if( starts_with( argv[i], "--monsters=", rest ) ) {
+            opts.monsters = std::max( 0, atoi( rest.c_str() ) );
+        } else if( starts_with( argv[i], "--seed=", rest ) ) {
+            opts.seed = strtoul( rest.c_str(), nullptr, 10 );
+        } else if( starts_with( argv[i], "--mods=", rest ) ) {
+            for( const std::string &mod : split( rest ) ) {
+                opts.mods.emplace_back( mod );
+            }
+        } else if( starts_with( argv[i], "--option=", rest ) && rest.find( '=' ) != std::string::npos ) {
+            const size_t split_at = rest.find( '=' );
+            opts.option_values.emplace_back( rest.substr( 0, split_at ), rest.substr( split_at + 1 ) );
+        } else if( starts_with( argv[i], "--world=", rest ) && !rest.empty() ) {
+            opts.world = rest;
+        } else if( starts_with( argv[i], "--user-dir=", rest ) ) {
+            opts.user_dir = rest.empty() || rest.back() == '/' ? rest : rest + "/";
+        } else {
+            print_usage();
+            return strcmp( argv[i], "--help" ) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if( std::find( opts.mods.begin(), opts.mods.end(), mod_id( "dda" ) ) == opts.mods.end() ) {
+        opts.mods.insert( opts.mods.begin(), mod_id( "dda" ) );
+    }
+
+    std::vector<bench_scenario> to_run;
+    for( const bench_scenario &scen : all_scenarios() ) {
+        if( opts.scenarios.empty() ||
+            std::find( opts.scenarios.begin(), opts.scenarios.end(), scen.name ) != opts.scenarios.end() ) {
+            to_run.push_back( scen );
+        }
+    }
+    if( to_run.empty() ) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    test_mode = true;
+    setupDebug( DebugOutput::std_err );
+    srand( opts.seed );
+    rng_set_engine_seed( opts.seed );
+
+    try {
+        init_global_game_state( opts );
+    } catch( const std::exception &err ) {
+        fprintf( stderr, "Terminated: %s\n", err.what() );
+        fprintf( stderr,
+                 "Make sure that you're in the correct working directory and your data isn't corrupted.\n" );
+        return EXIT_FAILURE;
+    }
+
+    std::vector<scenario_result> results;
+    for( const bench_scenario &scen : to_run ) {
+        printf( "\nRunning %s (%d turns, seed %u)\n", scen.name.c_str(), opts.turns, opts.seed );
+        results.push_back( run_scenario( scen, opts ) );
+        print_phases();
+    }
+
+    printf( "\n%-10s %8s %10s %10s %10s %10s\n", "scenario", "turns", "turns/s", "p50 ms",
+            "p99 ms", "max ms" );
+    for( const scenario_result &res : results ) {
+        printf( "%-10s %8d %10.1f %10.3f %10.3f %10.3f\n", res.name.c_str(), res.turns,
+                res.turns / std::max( res.seconds, 1e-9 ), res.p50_ms, res.p99_ms, res.max_ms );
+    }
+    // The peak only ever grows during a process, so it covers loading the data and
+    // every scenario run. Run one scenario at a time to compare their memory use.
+    printf( "\nPeak RSS of the whole run: %ld kB\n", peak_rss_kb() );
+
+    return debug_has_error_been_observed() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
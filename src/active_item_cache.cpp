@@ -6,7 +6,7 @@
 #include "debug.h"
 #include "item.h"
 
-void active_item_cache::remove( std::list<item>::iterator it, point location )
+void active_item_cache::remove( item_colony::iterator it, point location )
 {
     const auto predicate = [&]( const item_reference & active_item ) {
         return location == active_item.location && active_item.item_iterator == it;
@@ -29,7 +29,7 @@ void active_item_cache::remove( std::list<item>::iterator it, point location )
     }
 }
 
-void active_item_cache::add( std::list<item>::iterator it, point location )
+void active_item_cache::add( item_colony::iterator it, point location )
 {
     if( has( it, location ) ) {
         return;
@@ -38,7 +38,7 @@ void active_item_cache::add( std::list<item>::iterator it, point location )
     active_item_set[ &*it ] = false;
 }
 
-bool active_item_cache::has( std::list<item>::iterator it, point ) const
+bool active_item_cache::has( item_colony::iterator it, point ) const
 {
     return active_item_set.find( &*it ) != active_item_set.end();
 }
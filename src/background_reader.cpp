@@ -0,0 +1,183 @@
+#include "background_reader.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+namespace
+{
+
+/**
+ * Prefetched contents beyond this are dropped, oldest first. Files that were prefetched
+ * for a direction the player then didn't go in are never taken.
+ */
+constexpr size_t max_result_bytes = 16 * 1024 * 1024;
+
+class reader_thread
+{
+    public:
+        ~reader_thread() {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            queue_changed.notify_all();
+            if( worker.joinable() ) {
+                worker.join();
+            }
+        }
+
+        void prefetch( const std::string &path ) {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                if( path == reading || results.count( path ) > 0 ||
+                    std::find( jobs.begin(), jobs.end(), path ) != jobs.end() ) {
+                    return;
+                }
+                if( !worker.joinable() ) {
+                    worker = std::thread( &reader_thread::run, this );
+                }
+                jobs.push_back( path );
+            }
+            queue_changed.notify_all();
+        }
+
+        cata::optional<std::string> take( const std::string &path ) {
+            std::unique_lock<std::mutex> lock( mutex );
+            const auto queued = std::find( jobs.begin(), jobs.end(), path );
+            if( queued != jobs.end() ) {
+                // Not started yet, the caller can just as well read it itself.
+                jobs.erase( queued );
+                return cata::nullopt;
+            }
+            queue_changed.wait( lock, [&]() {
+                return reading != path;
+            } );
+            const auto iter = results.find( path );
+            if( iter == results.end() ) {
+                return cata::nullopt;
+            }
+            cata::optional<std::string> result = std::move( iter->second );
+            forget( iter );
+            return result;
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock( mutex );
+            jobs.clear();
+            results.clear();
+            result_order.clear();
+            result_bytes = 0;
+            // The read in progress might be outdated as well.
+            discard_current = true;
+        }
+
+    private:
+        void run() {
+            std::unique_lock<std::mutex> lock( mutex );
+            while( true ) {
+                queue_changed.wait( lock, [&]() {
+                    return stopping || !jobs.empty();
+                } );
+                if( stopping ) {
+                    return;
+                }
+                reading = jobs.front();
+                jobs.pop_front();
+                discard_current = false;
+
+                lock.unlock();
+                cata::optional<std::string> contents = read_file( reading );
+                lock.lock();
+
+                if( !discard_current ) {
+                    result_bytes += contents ? contents->size() : 0;
+                    results.emplace( reading, std::move( contents ) );
+                    result_order.push_back( reading );
+                    while( result_bytes > max_result_bytes ) {
+                        forget( results.find( result_order.front() ) );
+                    }
+                }
+                reading.clear();
+                queue_changed.notify_all();
+            }
+        }
+
+        using result_map = std::unordered_map<std::string, cata::optional<std::string>>;
+
+        void forget( const result_map::iterator iter ) {
+            result_bytes -= iter->second ? iter->second->size() : 0;
+            result_order.erase( std::find( result_order.begin(), result_order.end(), iter->first ) );
+            results.erase( iter );
+        }
+
+        /** Runs on the worker thread, errors are left to the caller of @ref take to report. */
+        static cata::optional<std::string> read_file( const std::string &path ) {
+            std::ifstream fin( path, std::ios::binary );
+            if( !fin ) {
+                return cata::nullopt;
+            }
+            std::string contents( ( std::istreambuf_iterator<char>( fin ) ),
+                                  std::istreambuf_iterator<char>() );
+            if( fin.bad() ) {
+                return cata::nullopt;
+            }
+            return contents;
+        }
+
+        std::mutex mutex;
+        /** Signaled whenever a job is queued or finished. */
+        std::condition_variable queue_changed;
+        std::deque<std::string> jobs;
+        /** Contents of the files read so far, nothing for those that could not be read. */
+        result_map results;
+        /** Keys of @ref results, oldest first. */
+        std::deque<std::string> result_order;
+        /** Total size of the contents in @ref results. */
+        size_t result_bytes = 0;
+        /** The file being read, empty if none. */
+        std::string reading;
+        bool discard_current = false;
+        bool stopping = false;
+        std::thread worker;
+};
+
+reader_thread &get_reader()
+{
+    // Never destroyed: the global mapbuffer and game call clear() when they are
+    // destroyed at exit, which may well be after any static reader would be.
+    static reader_thread &reader = *new reader_thread();
+    return reader;
+}
+
+} // namespace
+
+namespace background_reader
+{
+
+void prefetch( const std::string &path )
+{
+    get_reader().prefetch( path );
+}
+
+cata::optional<std::string> take( const std::string &path )
+{
+    return get_reader().take( path );
+}
+
+void clear()
+{
+    get_reader().clear();
+}
+
+} // namespace background_reader
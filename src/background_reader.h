@@ -0,0 +1,37 @@
+#pragma once
+#ifndef BACKGROUND_READER_H
+#define BACKGROUND_READER_H
+
+#include <string>
+
+#include "optional.h"
+
+/**
+ * Reads files on a worker thread ahead of time, so that loading them later
+ * only has to parse the contents on the main thread.
+ *
+ * Prefetched contents are kept until they are taken, or until newer ones push
+ * them over a limit of 16 MiB. Code that changes files that might have been
+ * prefetched must call @ref background_reader::clear.
+ * All functions must be called from the main thread.
+ */
+namespace background_reader
+{
+
+/** Queues reading @p path, unless it is queued or has been read already. */
+void prefetch( const std::string &path );
+
+/**
+ * Returns the contents of @p path if it has been prefetched, waiting for the
+ * read if it is in progress, and forgets them.
+ * Returns nothing if @p path was not prefetched (or was still waiting in the
+ * queue), or if it could not be read; the caller has to read it itself then.
+ */
+cata::optional<std::string> take( const std::string &path );
+
+/** Forgets all queued and prefetched files. */
+void clear();
+
+} // namespace background_reader
+
+#endif
@@ -0,0 +1,236 @@
+#include "background_writer.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+#include "cata_utility.h"
+#include "filesystem.h"
+
+namespace
+{
+
+/**
+ * Contents queued but not yet written at which @ref background_writer::write
+ * waits for the worker to catch up, so a save doesn't hold all of it in memory.
+ */
+constexpr size_t max_queued_bytes = 32 * 1024 * 1024;
+
+struct write_job {
+    std::string path;
+    std::string contents;
+    /** If set, called on the worker to get the contents instead. */
+    std::function<std::string()> serialize;
+};
+
+class writer_thread
+{
+    public:
+        ~writer_thread() {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            queue_changed.notify_all();
+            if( worker.joinable() ) {
+                worker.join();
+            }
+        }
+
+        void write( const std::string &path, std::string contents ) {
+            {
+                std::unique_lock<std::mutex> lock( mutex );
+                // A single file bigger than the limit is still queued, once the queue is empty.
+                queue_changed.wait( lock, [&]() {
+                    return queued_bytes + contents.size() <= max_queued_bytes || jobs.empty();
+                } );
+                queued_bytes += contents.size();
+                queue( path, write_job{ path, std::move( contents ), nullptr } );
+            }
+            queue_changed.notify_all();
+        }
+
+        void write( const std::string &path, std::function<std::string()> serialize ) {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                queue( path, write_job{ path, std::string(), std::move( serialize ) } );
+            }
+            queue_changed.notify_all();
+        }
+
+        bool idle() {
+            std::lock_guard<std::mutex> lock( mutex );
+            return pending.empty();
+        }
+
+        bool is_pending( const std::string &path ) {
+            std::lock_guard<std::mutex> lock( mutex );
+            return pending.count( path ) > 0;
+        }
+
+        void wait_for( const std::string &path ) {
+            std::unique_lock<std::mutex> lock( mutex );
+            queue_changed.wait( lock, [&]() {
+                return pending.count( path ) == 0;
+            } );
+        }
+
+        void wait() {
+            std::unique_lock<std::mutex> lock( mutex );
+            queue_changed.wait( lock, [&]() {
+                return pending.empty();
+            } );
+        }
+
+        std::vector<std::string> take_errors() {
+            std::lock_guard<std::mutex> lock( mutex );
+            std::vector<std::string> result;
+            result.swap( errors );
+            return result;
+        }
+
+    private:
+        /** Needs the lock. */
+        void queue( const std::string &path, write_job job ) {
+            if( !worker.joinable() ) {
+                worker = std::thread( &writer_thread::run, this );
+            }
+            pending[path]++;
+            jobs.push_back( std::move( job ) );
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock( mutex );
+            while( true ) {
+                queue_changed.wait( lock, [&]() {
+                    return stopping || !jobs.empty();
+                } );
+                if( jobs.empty() ) {
+                    return;
+                }
+                write_job job = std::move( jobs.front() );
+                jobs.pop_front();
+                queued_bytes -= job.contents.size();
+
+                lock.unlock();
+                std::string error;
+                try {
+                    if( job.serialize ) {
+                        job.contents = job.serialize();
+                        // Frees whatever it held on to, still on this thread.
+                        job.serialize = nullptr;
+                    }
+                    write_file( job.path, job.contents );
+                } catch( const std::exception &err ) {
+                    error = job.path + ": " + err.what();
+                }
+                lock.lock();
+
+                if( !error.empty() ) {
+                    errors.push_back( error );
+                }
+                if( --pending[job.path] == 0 ) {
+                    pending.erase( job.path );
+                }
+                queue_changed.notify_all();
+            }
+        }
+
+        /** Runs on the worker thread, only touches @ref written_hashes besides the file. */
+        void write_file( const std::string &path, const std::string &contents ) {
+            const uint64_t hash = std::hash<std::string>()( contents );
+            const auto iter = written_hashes.find( path );
+            if( iter != written_hashes.end() && iter->second == hash && file_exist( path ) ) {
+                return;
+            }
+            // Forget the old contents first, in case writing fails halfway.
+            written_hashes.erase( path );
+
+            const std::string temp_path = path + ".tmp";
+            {
+                ofstream_wrapper_exclusive fout( temp_path );
+                fout.stream().write( contents.data(), contents.size() );
+                fout.close();
+            }
+            if( !rename_file( temp_path, path ) ) {
+                throw std::runtime_error( "replacing the file failed" );
+            }
+            written_hashes[path] = hash;
+        }
+
+        std::mutex mutex;
+        /** Signaled whenever a job is queued, taken or finished. */
+        std::condition_variable queue_changed;
+        std::deque<write_job> jobs;
+        /** Size of the contents in @ref jobs. */
+        size_t queued_bytes = 0;
+        /** Number of queued or running jobs for each path. */
+        std::unordered_map<std::string, int> pending;
+        std::vector<std::string> errors;
+        std::unordered_map<std::string, uint64_t> written_hashes;
+        bool stopping = false;
+        std::thread worker;
+};
+
+writer_thread &get_writer()
+{
+    static writer_thread writer;
+    return writer;
+}
+
+} // namespace
+
+namespace background_writer
+{
+
+void write( const std::string &path, std::string contents )
+{
+    get_writer().write( path, std::move( contents ) );
+}
+
+void write( const std::string &path, std::function<std::string()> serialize )
+{
+    get_writer().write( path, std::move( serialize ) );
+}
+
+bool idle()
+{
+    return get_writer().idle();
+}
+
+bool is_pending( const std::string &path )
+{
+    return get_writer().is_pending( path );
+}
+
+void wait_for( const std::string &path )
+{
+    get_writer().wait_for( path );
+}
+
+void wait()
+{
+    get_writer().wait();
+    const std::vector<std::string> errors = get_writer().take_errors();
+    if( !errors.empty() ) {
+        throw std::runtime_error( errors.front() );
+    }
+}
+
+std::vector<std::string> take_errors()
+{
+    return get_writer().take_errors();
+}
+
+} // namespace background_writer
@@ -0,0 +1,55 @@
+#pragma once
+#ifndef BACKGROUND_WRITER_H
+#define BACKGROUND_WRITER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Writes save files on a worker thread, so that saving only has to serialize
+ * the game state into memory on the main thread.
+ *
+ * Files are written in the order they were queued, each one first to a
+ * temporary file next to it with the exclusive I/O functions, which then
+ * replaces the old file. A file whose contents are the same as when it was
+ * last written here is left untouched.
+ * Contents waiting to be written are limited to a few dozen MiB, queueing more
+ * waits until the worker has caught up.
+ * Code that reads a file that might have been queued must call
+ * @ref background_writer::wait_for first.
+ */
+namespace background_writer
+{
+
+/** Queues @p contents to be written to @p path. The directory must exist already. */
+void write( const std::string &path, std::string contents );
+
+/**
+ * Queues the result of @p serialize to be written to @p path, @p serialize is
+ * called on the worker thread, and destroyed there as well. Only for data that
+ * nothing else uses anymore, e.g. submaps evicted from the @ref mapbuffer.
+ */
+void write( const std::string &path, std::function<std::string()> serialize );
+
+/** Whether all queued writes have finished. */
+bool idle();
+
+/** Whether a write to @p path is queued or in progress. */
+bool is_pending( const std::string &path );
+
+/** Blocks until all writes queued for @p path have finished. */
+void wait_for( const std::string &path );
+
+/**
+ * Blocks until all queued writes have finished.
+ * @throw std::runtime_error with the first error message if any write failed.
+ */
+void wait();
+
+/** Returns and forgets the messages of all writes that failed so far. */
+std::vector<std::string> take_errors();
+
+} // namespace background_writer
+
+#endif
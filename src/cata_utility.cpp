@@ -536,8 +536,7 @@ std::string serialize_wrapper( const std::function<void( JsonOut & )> &callback
 
 void deserialize_wrapper( const std::function<void( JsonIn & )> &callback, const std::string &data )
 {
-    std::istringstream buffer( data );
-    JsonIn jsin( buffer );
+    JsonIn jsin( data.data(), data.size() );
     callback( jsin );
 }
 
@@ -18,6 +18,7 @@
 #include <memory>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -95,6 +96,19 @@ namespace
 
 std::set<std::string> ignored_messages;
 
+/** Set by @ref debugmsg_throws. */
+thread_local bool debugmsg_throws_active = false;
+
+}
+
+debugmsg_throws::debugmsg_throws() : previous( debugmsg_throws_active )
+{
+    debugmsg_throws_active = true;
+}
+
+debugmsg_throws::~debugmsg_throws()
+{
+    debugmsg_throws_active = previous;
 }
 
 void realDebugmsg( const char *filename, const char *line, const char *funcname,
@@ -104,6 +118,10 @@ void realDebugmsg( const char *filename, const char *line, const char *funcname,
     assert( line != nullptr );
     assert( funcname != nullptr );
 
+    if( debugmsg_throws_active ) {
+        throw std::runtime_error( text );
+    }
+
     DebugLog( D_ERROR, D_MAIN ) << filename << ":" << line << " [" << funcname << "] "
                                 << text << std::flush;
 
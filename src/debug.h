@@ -79,6 +79,23 @@ inline void realDebugmsg( const char *const filename, const char *const line,
                          std::forward<Args>( args )... ) );
 }
 
+/**
+ * While an instance exists, @ref debugmsg on the calling thread neither logs nor shows
+ * anything, it throws a std::runtime_error with the message instead. For work on other
+ * threads that the main thread redoes, and then reports, if it fails.
+ */
+class debugmsg_throws
+{
+    public:
+        debugmsg_throws();
+        ~debugmsg_throws();
+        debugmsg_throws( const debugmsg_throws & ) = delete;
+        debugmsg_throws &operator=( const debugmsg_throws & ) = delete;
+
+    private:
+        bool previous;
+};
+
 /**
  * Used to generate game report information.
  */
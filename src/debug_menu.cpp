@@ -58,6 +58,7 @@
 #include "item.h"
 #include "sounds.h"
 #include "trait_group.h"
+#include "turn_profiler.h"
 #include "map_extras.h"
 #include "artifact.h"
 #include "vpart_position.h"
@@ -121,7 +122,8 @@ enum debug_menu_index {
     DEBUG_DISPLAY_TEMP,
     DEBUG_DISPLAY_VISIBILITY,
     DEBUG_LEARN_SPELLS,
-    DEBUG_LEVEL_SPELLS
+    DEBUG_LEVEL_SPELLS,
+    DEBUG_TURN_PROFILER
 };
 
 class mission_debug
@@ -184,6 +186,7 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_CRASH_GAME, true, 'C', _( "Crash game (test crash handling)" ) ) },
             { uilist_entry( DEBUG_DISPLAY_NPC_PATH, true, 'n', _( "Toggle NPC pathfinding on map" ) ) },
             { uilist_entry( DEBUG_TEST_WEATHER, true, 'W', _( "Test weather" ) ) },
+            { uilist_entry( DEBUG_TURN_PROFILER, true, 'p', _( "Toggle turn profiler overlay" ) ) },
         };
         uilist_initializer.insert( uilist_initializer.begin(), debug_only_options.begin(),
                                    debug_only_options.end() );
@@ -1012,7 +1015,7 @@ void debug()
             for( int i = 0; i < OMAPX; i++ ) {
                 for( int j = 0; j < OMAPY; j++ ) {
                     for( int k = -OVERMAP_DEPTH; k <= OVERMAP_HEIGHT; k++ ) {
-                        cur_om.seen( i, j, k ) = true;
+                        cur_om.set_seen( i, j, k, true );
                     }
                 }
             }
@@ -1416,6 +1419,10 @@ void debug()
             }
                      break;
 
+            case DEBUG_TURN_PROFILER:
+                turn_profiler::toggle_overlay();
+                break;
+
             case DEBUG_OM_TELEPORT:
                 debug_menu::teleport_overmap();
                 break;
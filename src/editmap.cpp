@@ -1649,10 +1649,10 @@ int editmap::mapgen_preview( const real_coords &tc, uilist &gmenu )
 
     // Coordinates of the overmap terrain that should be generated.
     const point omt_pos = ms_to_omt_copy( tc.abs_pos );
-    oter_id &omt_ref = overmap_buffer.ter( omt_pos.x, omt_pos.y, target.z );
+    const tripoint omt_loc( omt_pos, target.z );
     // Copy to store the original value, to restore it upon canceling
-    const oter_id orig_oters = omt_ref;
-    omt_ref = oter_id( gmenu.ret );
+    const oter_id orig_oters = overmap_buffer.ter( omt_loc );
+    overmap_buffer.ter_set( omt_loc, oter_id( gmenu.ret ) );
     tinymap tmpmap;
     // TODO: add a do-not-save-generated-submaps parameter
     // TODO: keep track of generated submaps to delete them properly and to avoid memory leaks
@@ -1687,7 +1687,7 @@ int editmap::mapgen_preview( const real_coords &tc, uilist &gmenu )
     do {
         if( gmenu.selected != lastsel ) {
             lastsel = gmenu.selected;
-            omt_ref = oter_id( gmenu.selected );
+            overmap_buffer.ter_set( omt_loc, oter_id( gmenu.selected ) );
             cleartmpmap( tmpmap );
             tmpmap.generate( omt_pos.x * 2, omt_pos.y * 2, target.z, calendar::turn );
             showpreview = true;
@@ -1763,7 +1763,8 @@ int editmap::mapgen_preview( const real_coords &tc, uilist &gmenu )
             } else if( gpmenu.ret == 3 ) {
                 popup( _( "Changed oter_id from '%s' (%s) to '%s' (%s)" ),
                        orig_oters->get_name(), orig_oters.id().c_str(),
-                       omt_ref->get_name(), omt_ref.id().c_str() );
+                       overmap_buffer.ter( omt_loc )->get_name(),
+                       overmap_buffer.ter( omt_loc ).id().c_str() );
             }
         } else if( gpmenu.keypress == 'm' ) {
             // TODO: keep preview as is and move target
@@ -1781,7 +1782,7 @@ int editmap::mapgen_preview( const real_coords &tc, uilist &gmenu )
     update_view( true );
     if( gpmenu.ret != 2 &&  // we didn't apply, so restore the original om_ter
         gpmenu.ret != 3 ) { // chose to change oter_id but not apply mapgen
-        omt_ref = orig_oters;
+        overmap_buffer.ter_set( omt_loc, orig_oters );
     }
     gmenu.border_color = c_magenta;
     gmenu.hilight_color = h_white;
@@ -834,7 +834,7 @@ void nuke( const tripoint &p )
         }
     }
     tmpmap.save();
-    overmap_buffer.ter( x, y, 0 ) = oter_id( "crater" );
+    overmap_buffer.ter_set( tripoint( x, y, 0 ), oter_id( "crater" ) );
     // Kill any npcs on that omap location.
     for( const auto &npc : overmap_buffer.get_npcs_near_omt( x, y, 0, 0 ) ) {
         npc->marked_for_death = true;
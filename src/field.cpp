@@ -542,20 +542,23 @@ Function: find_field
 Returns a field entry corresponding to the field_id parameter passed in. If no fields are found then returns NULL.
 Good for checking for existence of a field: if(myfield.find_field(fd_fire)) would tell you if the field is on fire.
 */
+static bool field_type_less( const std::pair<field_id, field_entry> &entry, const field_id type )
+{
+    return entry.first < type;
+}
+
 field_entry *field::find_field( const field_id field_to_find )
 {
-    const auto it = field_list.find( field_to_find );
-    if( it != field_list.end() ) {
-        return &it->second;
-    }
-    return nullptr;
+    return const_cast<field_entry *>( find_field_c( field_to_find ) );
 }
 
 const field_entry *field::find_field_c( const field_id field_to_find ) const
 {
-    const auto it = field_list.find( field_to_find );
-    if( it != field_list.end() ) {
-        return &it->second;
+    // Almost all squares hold at most a couple of fields, a linear search is fastest.
+    for( const auto &fld : field_list ) {
+        if( fld.first == field_to_find ) {
+            return &fld.second;
+        }
     }
     return nullptr;
 }
@@ -576,33 +579,38 @@ Density defaults to 1, and age to 0 (permanent) if not specified.
 bool field::add_field( const field_id field_to_add, const int new_density,
                        const time_duration &new_age )
 {
-    auto it = field_list.find( field_to_add );
+    if( field_list.empty() ) {
+        // Before looking for the position, reserving invalidates iterators.
+        field_list.reserve( 2 );
+    }
+    auto it = std::lower_bound( field_list.begin(), field_list.end(), field_to_add, field_type_less );
     if( all_field_types_enum_list[field_to_add].priority >=
         all_field_types_enum_list[draw_symbol].priority ) {
         draw_symbol = field_to_add;
     }
-    if( it != field_list.end() ) {
+    if( it != field_list.end() && it->first == field_to_add ) {
         //Already exists, but lets update it. This is tentative.
         it->second.set_field_density( it->second.get_field_intensity() + new_density );
         return false;
     }
-    field_list[field_to_add] = field_entry( field_to_add, new_density, new_age );
+    field_list.emplace( it, field_to_add, field_entry( field_to_add, new_density, new_age ) );
     return true;
 }
 
 bool field::remove_field( field_id const field_to_remove )
 {
-    const auto it = field_list.find( field_to_remove );
-    if( it == field_list.end() ) {
+    const auto it = std::lower_bound( field_list.begin(), field_list.end(), field_to_remove,
+                                      field_type_less );
+    if( it == field_list.end() || it->first != field_to_remove ) {
         return false;
     }
     remove_field( it );
     return true;
 }
 
-void field::remove_field( std::map<field_id, field_entry>::iterator const it )
+field::iterator field::remove_field( iterator const it )
 {
-    field_list.erase( it );
+    const auto next = field_list.erase( it );
     if( field_list.empty() ) {
         draw_symbol = fd_null;
     } else {
@@ -614,6 +622,7 @@ void field::remove_field( std::map<field_id, field_entry>::iterator const it )
             }
         }
     }
+    return next;
 }
 
 /*
@@ -625,26 +634,34 @@ unsigned int field::field_count() const
     return field_list.size();
 }
 
-std::map<field_id, field_entry>::iterator field::begin()
+field::iterator field::begin()
 {
     return field_list.begin();
 }
 
-std::map<field_id, field_entry>::const_iterator field::begin() const
+field::const_iterator field::begin() const
 {
     return field_list.begin();
 }
 
-std::map<field_id, field_entry>::iterator field::end()
+field::iterator field::end()
 {
     return field_list.end();
 }
 
-std::map<field_id, field_entry>::const_iterator field::end() const
+field::const_iterator field::end() const
 {
     return field_list.end();
 }
 
+field::iterator field::upper_bound( const field_id type )
+{
+    return std::upper_bound( field_list.begin(), field_list.end(), type,
+    []( const field_id lhs, const std::pair<field_id, field_entry> &entry ) {
+        return lhs < entry.first;
+    } );
+}
+
 std::string field_t::name( const int density ) const
 {
     const std::string &n = untranslated_name[std::min( std::max( 0, density ), MAX_FIELD_DENSITY - 1 )];
@@ -3,9 +3,10 @@
 #define FIELD_H
 
 #include <array>
-#include <map>
 #include <string>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include "calendar.h"
 #include "color.h"
@@ -209,10 +210,20 @@ class field_entry
  * Use @ref find_field to get the field entry of a specific type, or iterate over
  * all entries via @ref begin and @ref end (allows range based iteration).
  * There is @ref field_symbol to specific which field should be drawn on the map.
+ *
+ * The entries are kept in a vector sorted by field type, as almost all squares
+ * hold no more than two of them. Adding or removing an entry invalidates
+ * iterators and pointers to the other entries of the same square, so code that
+ * might do that while iterating (e.g. by killing a monster) should look entries
+ * up again by type and continue from @ref upper_bound.
 */
 class field
 {
     public:
+        using container = std::vector<std::pair<field_id, field_entry>>;
+        using iterator = container::iterator;
+        using const_iterator = container::const_iterator;
+
         field();
 
         /**
@@ -251,8 +262,9 @@ class field
         /**
          * Make sure to decrement the field counter in the submap.
          * Removes the field entry, the iterator must point into @ref field_list and must be valid.
+         * @return Iterator to the entry after the removed one.
          */
-        void remove_field( std::map<field_id, field_entry>::iterator );
+        iterator remove_field( iterator );
 
         //Returns the number of fields existing on the current tile.
         unsigned int field_count() const;
@@ -263,12 +275,15 @@ class field
         field_id field_symbol() const;
 
         //Returns the vector iterator to begin searching through the list.
-        std::map<field_id, field_entry>::iterator begin();
-        std::map<field_id, field_entry>::const_iterator begin() const;
+        iterator begin();
+        const_iterator begin() const;
 
         //Returns the vector iterator to end searching through the list.
-        std::map<field_id, field_entry>::iterator end();
-        std::map<field_id, field_entry>::const_iterator end() const;
+        iterator end();
+        const_iterator end() const;
+
+        /** Returns the first entry whose type is greater than @p type. */
+        iterator upper_bound( field_id type );
 
         /**
          * Returns the total move cost from all fields.
@@ -276,7 +291,7 @@ class field
         int move_cost() const;
 
     private:
-        std::map<field_id, field_entry>
+        container
         field_list; //A pointer lookup table of all field effects on the current tile.    //Draw_symbol currently is equal to the last field added to the square. You can modify this behavior in the class functions if you wish.
         field_id draw_symbol;
 };
@@ -1,12 +1,144 @@
 #include "flag.h"
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "debug.h"
 #include "json.h"
 
+namespace
+{
+
+/** The names interned before @ref flag_id::freeze, never changed afterwards. */
+struct frozen_flags {
+    std::unordered_map<std::string, int> ids;
+    /** Indexed by flag_id, points into @ref flag_registry::names. */
+    std::vector<const std::string *> names;
+};
+
+struct flag_registry {
+    std::mutex mutex;
+    /** Indexed by flag_id, a deque so the references handed out stay valid. */
+    std::deque<std::string> names = { std::string() };
+    std::unordered_map<std::string, int> ids = { { std::string(), 0 } };
+    /** Read without the lock, null until the first freeze. */
+    std::atomic<const frozen_flags *> frozen{ nullptr };
+    /**
+     * Every snapshot ever made. Another thread may still be reading an old one
+     * after a new one was published, and there are only a few (one per load).
+     */
+    std::vector<std::unique_ptr<const frozen_flags>> snapshots;
+};
+
+flag_registry &get_flag_registry()
+{
+    static flag_registry registry;
+    return registry;
+}
+
+} // namespace
+
+flag_id::flag_id( const std::string &name )
+{
+    flag_registry &registry = get_flag_registry();
+    if( const frozen_flags *frozen = registry.frozen.load( std::memory_order_acquire ) ) {
+        const auto iter = frozen->ids.find( name );
+        if( iter != frozen->ids.end() ) {
+            id_ = iter->second;
+            return;
+        }
+    }
+    std::lock_guard<std::mutex> lock( registry.mutex );
+    const auto iter = registry.ids.emplace( name, static_cast<int>( registry.names.size() ) ).first;
+    if( iter->second == static_cast<int>( registry.names.size() ) ) {
+        registry.names.push_back( name );
+    }
+    id_ = iter->second;
+}
+
+cata::optional<flag_id> flag_id::find( const std::string &name )
+{
+    flag_registry &registry = get_flag_registry();
+    flag_id result;
+    if( const frozen_flags *frozen = registry.frozen.load( std::memory_order_acquire ) ) {
+        const auto iter = frozen->ids.find( name );
+        if( iter != frozen->ids.end() ) {
+            result.id_ = iter->second;
+            return result;
+        }
+    }
+    std::lock_guard<std::mutex> lock( registry.mutex );
+    const auto iter = registry.ids.find( name );
+    if( iter == registry.ids.end() ) {
+        return cata::nullopt;
+    }
+    result.id_ = iter->second;
+    return result;
+}
+
+void flag_id::freeze()
+{
+    flag_registry &registry = get_flag_registry();
+    std::lock_guard<std::mutex> lock( registry.mutex );
+    std::unique_ptr<frozen_flags> frozen( new frozen_flags() );
+    frozen->ids = registry.ids;
+    frozen->names.reserve( registry.names.size() );
+    for( const std::string &name : registry.names ) {
+        frozen->names.push_back( &name );
+    }
+    registry.frozen.store( frozen.get(), std::memory_order_release );
+    registry.snapshots.emplace_back( std::move( frozen ) );
+}
+
+const std::string &flag_id::str() const
+{
+    flag_registry &registry = get_flag_registry();
+    const frozen_flags *frozen = registry.frozen.load( std::memory_order_acquire );
+    if( frozen && static_cast<size_t>( id_ ) < frozen->names.size() ) {
+        return *frozen->names[id_];
+    }
+    std::lock_guard<std::mutex> lock( registry.mutex );
+    return registry.names[id_];
+}
+
+std::vector<std::string> flag_set::sorted_names() const
+{
+    std::vector<std::string> names;
+    names.reserve( flags.size() );
+    for( const flag_id &f : flags ) {
+        names.push_back( f.str() );
+    }
+    std::sort( names.begin(), names.end() );
+    return names;
+}
+
+void flag_set::serialize( JsonOut &json ) const
+{
+    json.start_array();
+    for( const std::string &name : sorted_names() ) {
+        json.write( name );
+    }
+    json.end_array();
+}
+
+void flag_set::deserialize( JsonIn &jsin )
+{
+    clear();
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        insert( jsin.get_string() );
+    }
+}
+
 static std::unordered_map<std::string, json_flag> json_flags_all;
+/** Flags whose definition has inherit set to false, see @ref json_flag::inherits. */
+static flag_set json_flags_not_inherited;
 
 const json_flag &json_flag::get( const std::string &id )
 {
@@ -15,6 +147,11 @@ const json_flag &json_flag::get( const std::string &id )
     return iter != json_flags_all.end() ? iter->second : null_flag;
 }
 
+bool json_flag::inherits( const flag_id &f )
+{
+    return !json_flags_not_inherited.count( f );
+}
+
 void json_flag::load( JsonObject &jo )
 {
     auto id = jo.get_string( "id" );
@@ -23,6 +160,11 @@ void json_flag::load( JsonObject &jo )
     jo.read( "info", f.info_ );
     jo.read( "conflicts", f.conflicts_ );
     jo.read( "inherit", f.inherit_ );
+    if( f.inherit_ ) {
+        json_flags_not_inherited.erase( flag_id( id ) );
+    } else {
+        json_flags_not_inherited.insert( flag_id( id ) );
+    }
 }
 
 void json_flag::check_consistency()
@@ -41,4 +183,5 @@ void json_flag::check_consistency()
 void json_flag::reset()
 {
     json_flags_all.clear();
+    json_flags_not_inherited.clear();
 }
@@ -2,10 +2,212 @@
 #ifndef FLAG_H
 #define FLAG_H
 
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <set>
 #include <string>
+#include <vector>
 
+#include "flat_set.h"
+#include "optional.h"
+
+class JsonIn;
 class JsonObject;
+class JsonOut;
+
+/**
+ * Name of an item flag, interned to a small integer.
+ *
+ * Every distinct flag name gets its own id the first time a flag_id is
+ * constructed from it, and keeps it for the rest of the program. Comparing
+ * and hashing ids is much cheaper than doing the same with the names, so code
+ * that checks the same flag often should keep a static flag_id around instead
+ * of passing the name each time. Interning is thread safe.
+ *
+ * Looking up names and ids that were interned before the last call to
+ * @ref freeze does not lock anything, the items processed on worker threads
+ * only ever see those.
+ */
+class flag_id
+{
+    public:
+        /** The id of the empty name. */
+        flag_id() = default;
+        /** Interns @p name, it gets a new id if it has none yet. */
+        explicit flag_id( const std::string &name );
+
+        /** Returns the id of @p name, but only if it has been interned before. */
+        static cata::optional<flag_id> find( const std::string &name );
+
+        /**
+         * Makes all names interned so far readable without locking. Called once
+         * the game data has been loaded, names interned later (e.g. unknown flags
+         * from a save) still work, but need the lock.
+         */
+        static void freeze();
+
+        const std::string &str() const;
+
+        int to_i() const {
+            return id_;
+        }
+
+        bool operator==( const flag_id &rhs ) const {
+            return id_ == rhs.id_;
+        }
+        bool operator!=( const flag_id &rhs ) const {
+            return id_ != rhs.id_;
+        }
+        bool operator<( const flag_id &rhs ) const {
+            return id_ < rhs.id_;
+        }
+
+    private:
+        int id_ = 0;
+};
+
+namespace std
+{
+template<>
+struct hash<flag_id> {
+    std::size_t operator()( const flag_id &f ) const {
+        return std::hash<int>()( f.to_i() );
+    }
+};
+} // namespace std
+
+/**
+ * A set of item flags, stored as a sorted vector of @ref flag_id.
+ *
+ * It can be used like a set of flag names (counting, inserting, iterating
+ * and reading/writing JSON work on the names), but lookups by @ref flag_id
+ * never touch any string. Looking up a name that was never interned does not
+ * intern it. Iteration order is the order in which the names were interned,
+ * which depends on the loading order. Where the order is shown to the player
+ * or written out, use @ref sorted_names, JSON is written sorted by name as well.
+ */
+class flag_set
+{
+    private:
+        using container = cata::flat_set<flag_id>;
+
+    public:
+        using size_type = std::size_t;
+
+        class const_iterator
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = std::string;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const std::string *;
+                using reference = const std::string &;
+
+                const_iterator() = default;
+                explicit const_iterator( container::const_iterator it ) : it_( it ) {}
+
+                const std::string &operator*() const {
+                    return it_->str();
+                }
+                const std::string *operator->() const {
+                    return &it_->str();
+                }
+                const flag_id &id() const {
+                    return *it_;
+                }
+                const_iterator &operator++() {
+                    ++it_;
+                    return *this;
+                }
+                const_iterator operator++( int ) {
+                    const_iterator result = *this;
+                    ++it_;
+                    return result;
+                }
+                bool operator==( const const_iterator &rhs ) const {
+                    return it_ == rhs.it_;
+                }
+                bool operator!=( const const_iterator &rhs ) const {
+                    return it_ != rhs.it_;
+                }
+
+            private:
+                container::const_iterator it_;
+        };
+        using iterator = const_iterator;
+
+        flag_set() = default;
+        template<typename InputIt>
+        flag_set( InputIt first, InputIt last ) {
+            insert( first, last );
+        }
+        flag_set( const std::set<std::string> &names ) : flag_set( names.begin(), names.end() ) {}
+
+        size_type count( const flag_id &f ) const {
+            return flags.count( f );
+        }
+        size_type count( const std::string &name ) const {
+            const cata::optional<flag_id> f = flag_id::find( name );
+            return f ? flags.count( *f ) : 0;
+        }
+
+        void insert( const flag_id &f ) {
+            flags.insert( f );
+        }
+        void insert( const std::string &name ) {
+            flags.insert( flag_id( name ) );
+        }
+        template<typename InputIt>
+        void insert( InputIt first, InputIt last ) {
+            for( ; first != last; ++first ) {
+                insert( *first );
+            }
+        }
+
+        size_type erase( const flag_id &f ) {
+            return flags.erase( f );
+        }
+        size_type erase( const std::string &name ) {
+            const cata::optional<flag_id> f = flag_id::find( name );
+            return f ? flags.erase( *f ) : 0;
+        }
+
+        void clear() {
+            flags.clear();
+        }
+        bool empty() const {
+            return flags.empty();
+        }
+        size_type size() const {
+            return flags.size();
+        }
+
+        const_iterator begin() const {
+            return const_iterator( flags.begin() );
+        }
+        const_iterator end() const {
+            return const_iterator( flags.end() );
+        }
+
+        bool operator==( const flag_set &rhs ) const {
+            return flags == rhs.flags;
+        }
+        bool operator!=( const flag_set &rhs ) const {
+            return flags != rhs.flags;
+        }
+
+        /** Returns the names of the flags, sorted by name. */
+        std::vector<std::string> sorted_names() const;
+
+        /** Writes an array of the names, sorted by name. */
+        void serialize( JsonOut &json ) const;
+        /** Reads an array of names, replacing the current content. */
+        void deserialize( JsonIn &jsin );
+
+    private:
+        container flags;
+};
 
 class json_flag
 {
@@ -30,6 +232,12 @@ class json_flag
             return inherit_;
         }
 
+        /**
+         * Same as @ref inherit of the definition of @p f, but without looking
+         * up the definition by name.
+         */
+        static bool inherits( const flag_id &f );
+
         /** Is this a valid (non-null) flag */
         operator bool() const {
             return !id_.empty();
@@ -21,6 +21,7 @@
 #include <limits>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -30,6 +31,7 @@
 #include "auto_pickup.h"
 #include "avatar.h"
 #include "avatar_action.h"
+#include "background_writer.h"
 #include "bionics.h"
 #include "bodypart.h"
 #include "cata_utility.h"
@@ -95,6 +97,7 @@
 #include "overmap_ui.h"
 #include "overmapbuffer.h"
 #include "panels.h"
+#include "parallel.h"
 #include "path_info.h"
 #include "pickup.h"
 #include "popup.h"
@@ -114,6 +117,7 @@
 #include "trait_group.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profiler.h"
 #include "uistate.h"
 #include "veh_interact.h"
 #include "veh_type.h"
@@ -946,8 +950,22 @@ void game::create_starting_npcs()
                           tmp->getID() ) );
 }
 
+/**
+ * Waits for the files of earlier background saves. Reading them before that would load
+ * an older state, and deleting them would let the writes bring them back.
+ */
+static void finish_background_saves()
+{
+    try {
+        background_writer::wait(); // can throw
+    } catch( const std::exception &err ) {
+        popup( _( "Failed to save the maps: %s" ), err.what() );
+    }
+}
+
 bool game::cleanup_at_end()
 {
+    finish_background_saves();
     if( uquit == QUIT_DIED || uquit == QUIT_SUICIDE ) {
         // Put (non-hallucinations) into the overmap so they are not lost.
         for( monster &critter : all_monsters() ) {
@@ -1226,6 +1244,9 @@ bool game::cleanup_at_end()
     MAPBUFFER.reset();
     overmap_buffer.clear();
 
+    turn_profiler::write_reports();
+    turn_profiler::reset();
+
 #if defined(__ANDROID__)
     quick_shortcuts_map.clear();
 #endif
@@ -1362,7 +1383,10 @@ bool game::do_turn()
     if( new_game ) {
         new_game = false;
     } else {
-        gamemode->per_turn();
+        // There's no game mode when the turns are run without a loaded save, like in the benchmark.
+        if( gamemode ) {
+            gamemode->per_turn();
+        }
         calendar::turn.increment();
     }
 
@@ -1373,15 +1397,26 @@ bool game::do_turn()
         load_npcs();
     }
 
-    events.process();
-    mission::process_all();
+    static const option_handle<bool> turn_profiler_option( "TURN_PROFILER" );
+    static const option_handle<bool> autosave_option( "AUTOSAVE" );
+    static const option_handle<int> autosave_turns( "AUTOSAVE_TURNS" );
+    static const option_handle<bool> force_redraw( "FORCE_REDRAW" );
+
+    turn_profiler::set_enabled( turn_profiler_option.get() );
+
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::events );
+        events.process();
+        mission::process_all();
 
-    if( calendar::once_every( 1_days ) ) {
-        overmap_buffer.process_mongroups();
+        if( calendar::once_every( 1_days ) ) {
+            overmap_buffer.process_mongroups();
+        }
     }
 
     // Move hordes every 2.5 min
     if( calendar::once_every( time_duration::from_minutes( 2.5 ) ) ) {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::hordes );
         overmap_buffer.move_hordes();
         // Hordes that reached the reality bubble need to spawn,
         // make them spawn in invisible areas only.
@@ -1391,26 +1426,36 @@ bool game::do_turn()
     u.update_body();
 
     // Auto-save if autosave is enabled
-    if( get_option<bool>( "AUTOSAVE" ) &&
-        calendar::once_every( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
+    if( autosave_option.get() &&
+        calendar::once_every( 1_turns * autosave_turns.get() ) &&
         !u.is_dead_state() ) {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::autosave );
         autosave();
     }
 
-    weather.update_weather();
-    reset_light_level();
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::weather );
+        weather.update_weather();
+        reset_light_level();
+    }
 
     perhaps_add_random_npc();
-    process_activity();
-    // Process NPC sound events before they move or they hear themselves talking
-    for( npc &guy : all_npcs() ) {
-        if( rl_dist( guy.pos(), u.pos() ) < MAX_VIEW_DISTANCE ) {
-            sounds::process_sound_markers( &guy );
-        }
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::activity );
+        process_activity();
     }
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::sound_markers );
+        // Process NPC sound events before they move or they hear themselves talking
+        for( npc &guy : all_npcs() ) {
+            if( rl_dist( guy.pos(), u.pos() ) < MAX_VIEW_DISTANCE ) {
+                sounds::process_sound_markers( &guy );
+            }
+        }
 
-    // Process sound events into sound markers for display to the player.
-    sounds::process_sound_markers( &u );
+        // Process sound events into sound markers for display to the player.
+        sounds::process_sound_markers( &u );
+    }
 
     if( u.is_deaf() ) {
         sfx::do_hearing_loss();
@@ -1473,53 +1518,91 @@ bool game::do_turn()
     }
 
     // No-scent debug mutation has to be processed here or else it takes time to start working
-    if( !u.has_active_bionic( bionic_id( "bio_scent_mask" ) ) &&
-        !u.has_trait( trait_id( "DEBUG_NOSCENT" ) ) ) {
-        scent.set( u.pos(), u.scent );
-        overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::scent );
+        if( !u.has_active_bionic( bionic_id( "bio_scent_mask" ) ) &&
+            !u.has_trait( trait_id( "DEBUG_NOSCENT" ) ) ) {
+            scent.set( u.pos(), u.scent );
+            overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
+        }
+        scent.update( u.pos(), m );
     }
-    scent.update( u.pos(), m );
-
-    // We need floor cache before checking falling 'n stuff
-    m.build_floor_caches();
 
-    m.process_falling();
-    m.vehmove();
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::floor_caches );
+        // We need floor cache before checking falling 'n stuff
+        m.build_floor_caches();
 
-    // Process power and fuel consumption for all vehicles, including off-map ones.
-    // m.vehmove used to do this, but now it only give them moves instead.
-    for( auto &elem : MAPBUFFER ) {
-        tripoint sm_loc = elem.first;
-        point sm_topleft = sm_to_ms_copy( sm_loc.x, sm_loc.y );
-        point in_reality = m.getlocal( sm_topleft );
+        m.process_falling();
+    }
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::vehmove );
+        m.vehmove();
+    }
 
-        submap *sm = elem.second;
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::vehicle_idle );
+        // Process power and fuel consumption for all vehicles, including off-map ones.
+        // m.vehmove used to do this, but now it only give them moves instead.
+        MAPBUFFER.for_each_vehicle_submap( [this]( const tripoint & sm_loc, submap & sm ) {
+            point sm_topleft = sm_to_ms_copy( sm_loc.x, sm_loc.y );
+            point in_reality = m.getlocal( sm_topleft );
 
-        const bool in_bubble_z = m.has_zlevels() || sm_loc.z == get_levz();
-        for( auto &veh : sm->vehicles ) {
-            veh->idle( in_bubble_z && m.inbounds( in_reality ) );
+            const bool in_bubble_z = m.has_zlevels() || sm_loc.z == get_levz();
+            for( auto &veh : sm.vehicles ) {
+                veh->idle( in_bubble_z && m.inbounds( in_reality ) );
+            }
+        } );
+    }
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::map_prefetch );
+        static const option_handle<bool> prefetch_map( "PREFETCH_MAP" );
+        if( prefetch_map.get() ) {
+            prefetch_map_ahead();
         }
     }
-    m.process_fields();
-    m.process_active_items();
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::process_fields );
+        m.process_fields();
+    }
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::process_active_items );
+        m.process_active_items();
+    }
     m.creature_in_field( u );
 
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
-    // Update vision caches for monsters. If this turns out to be expensive,
-    // consider a stripped down cache just for monsters.
-    m.build_map_cache( get_levz(), true );
-    monmove();
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::process_sounds );
+        // Apply sounds from previous turn to monster and NPC AI.
+        sounds::process_sounds();
+    }
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::build_map_cache );
+        // Update vision caches for monsters. If this turns out to be expensive,
+        // consider a stripped down cache just for monsters.
+        m.build_map_cache( get_levz(), true );
+    }
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::monmove );
+        monmove();
+    }
     if( calendar::once_every( 3_minutes ) ) {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::overmap_npc_move );
         overmap_npc_move();
     }
     update_stair_monsters();
-    u.process_turn();
-    if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::player );
+        u.process_turn();
+    }
+    if( u.moves < 0 && force_redraw.get() ) {
         draw();
         refresh_display();
     }
-    u.process_active_items();
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::player_items );
+        u.process_active_items();
+    }
 
     if( get_levz() >= 0 && !u.is_underwater() ) {
         weather::effect( weather.weather )();
@@ -1573,6 +1656,8 @@ bool game::do_turn()
     // reset player noise
     u.volume = 0;
 
+    turn_profiler::end_turn();
+
     return false;
 }
 
@@ -2549,6 +2634,7 @@ void game::load_master()
 {
     using namespace std::placeholders;
     const auto datafile = get_world_base_save_path() + "/master.gsav";
+    background_writer::wait_for( datafile );
     read_from_file_optional( datafile, std::bind( &game::unserialize_master, this, _1 ) );
 }
 
@@ -2583,6 +2669,7 @@ void game::load( const save_t &name )
     const std::string worldpath = get_world_base_save_path() + "/";
     const std::string playerpath = worldpath + name.base_path();
 
+    finish_background_saves();
     // Now load up the master game data; factions (and more?)
     load_master();
     u = avatar();
@@ -2762,12 +2849,29 @@ void game::reset_npc_dispositions()
 }
 
 //Saves all factions and missions and npcs.
-bool game::save_factions_missions_npcs()
+/**
+ * Like @ref write_to_file, but if @p background is set, the file is queued for the
+ * @ref background_writer, behind the map files that were queued before it.
+ */
+static bool write_save_file( const std::string &path,
+                             const std::function<void( std::ostream & )> &writer,
+                             const char *fail_message, const bool background )
+{
+    if( !background ) {
+        return write_to_file( path, writer, fail_message );
+    }
+    std::ostringstream fout;
+    writer( fout );
+    background_writer::write( path, fout.str() );
+    return true;
+}
+
+bool game::save_factions_missions_npcs( const bool background )
 {
     std::string masterfile = get_world_base_save_path() + "/master.gsav";
-    return write_to_file_exclusive( masterfile, [&]( std::ostream & fout ) {
+    return write_save_file( masterfile, [&]( std::ostream & fout ) {
         serialize_master( fout );
-    }, _( "factions data" ) );
+    }, _( "factions data" ), background );
 }
 
 bool game::save_artifacts()
@@ -2776,12 +2880,15 @@ bool game::save_artifacts()
     return ::save_artifacts( artfilename );
 }
 
-bool game::save_maps()
+bool game::save_maps( const bool background )
 {
     try {
         m.save();
         overmap_buffer.save(); // can throw
-        MAPBUFFER.save(); // can throw
+        MAPBUFFER.save( false, !background ); // can throw
+        if( !background ) {
+            background_writer::wait(); // can throw
+        }
         return true;
     } catch( const std::exception &err ) {
         popup( _( "Failed to save the maps: %s" ), err.what() );
@@ -2789,27 +2896,27 @@ bool game::save_maps()
     }
 }
 
-bool game::save_player_data()
+bool game::save_player_data( const bool background )
 {
     const std::string playerfile = get_player_base_save_path();
 
-    const bool saved_data = write_to_file( playerfile + ".sav", [&]( std::ostream & fout ) {
+    const bool saved_data = write_save_file( playerfile + ".sav", [&]( std::ostream & fout ) {
         serialize( fout );
-    }, _( "player data" ) );
-    const bool saved_map_memory = write_to_file( playerfile + ".mm", [&]( std::ostream & fout ) {
+    }, _( "player data" ), background );
+    const bool saved_map_memory = write_save_file( playerfile + ".mm", [&]( std::ostream & fout ) {
         JsonOut jsout( fout );
         u.serialize_map_memory( jsout );
-    }, _( "player map memory" ) );
-    const bool saved_weather = write_to_file( playerfile + ".weather", [&]( std::ostream & fout ) {
+    }, _( "player map memory" ), background );
+    const bool saved_weather = write_save_file( playerfile + ".weather", [&]( std::ostream & fout ) {
         save_weather( fout );
-    }, _( "weather state" ) );
-    const bool saved_log = write_to_file( playerfile + ".log", [&]( std::ostream & fout ) {
+    }, _( "weather state" ), background );
+    const bool saved_log = write_save_file( playerfile + ".log", [&]( std::ostream & fout ) {
         fout << u.dump_memorial();
-    }, _( "player memorial" ) );
+    }, _( "player memorial" ), background );
 #if defined(__ANDROID__)
-    const bool saved_shortcuts = write_to_file( playerfile + ".shortcuts", [&]( std::ostream & fout ) {
+    const bool saved_shortcuts = write_save_file( playerfile + ".shortcuts", [&]( std::ostream & fout ) {
         save_shortcuts( fout );
-    }, _( "quick shortcuts" ) );
+    }, _( "quick shortcuts" ), background );
 #endif
 
     return saved_data && saved_map_memory && saved_weather && saved_log
@@ -2819,13 +2926,15 @@ bool game::save_player_data()
            ;
 }
 
-bool game::save()
+bool game::save( const bool background )
 {
     try {
-        if( !save_player_data() ||
-            !save_factions_missions_npcs() ||
-            !save_artifacts() ||
-            !save_maps() ||
+        // The maps go first, so that with background writes the player and the
+        // factions never get to disk ahead of the map they are in.
+        if( !save_artifacts() ||
+            !save_maps( background ) ||
+            !save_player_data( background ) ||
+            !save_factions_missions_npcs( background ) ||
             !get_auto_pickup().save_character() ||
             !get_safemode().save_character() ||
         !write_to_file_exclusive( get_world_base_save_path() + "/uistate.json", [&]( std::ostream & fout ) {
@@ -3180,8 +3289,10 @@ void game::draw_panels( size_t column, size_t index, bool force_draw )
     const bool draw_this_turn = current_turn > previous_turn || force_draw;
     auto &mgr = panel_manager::get_manager();
     int y = 0;
-    const bool sidebar_right = get_option<std::string>( "SIDEBAR_POSITION" ) == "right";
-    int spacer = get_option<bool>( "SIDEBAR_SPACERS" ) ? 1 : 0;
+    static const option_handle<std::string> sidebar_position( "SIDEBAR_POSITION" );
+    static const option_handle<bool> sidebar_spacers( "SIDEBAR_SPACERS" );
+    const bool sidebar_right = sidebar_position.get() == "right";
+    int spacer = sidebar_spacers.get() ? 1 : 0;
     int log_height = 0;
     for( const window_panel &panel : mgr.get_current_layout() ) {
         if( panel.get_height() != -2 && panel.toggle && panel.render() ) {
@@ -3342,13 +3453,17 @@ void game::draw_ter( const tripoint &center, const bool looking, const bool draw
         draw_veh_dir_indicator( false );
         draw_veh_dir_indicator( true );
     }
+    if( turn_profiler::overlay_enabled() ) {
+        turn_profiler::draw_overlay( w_terrain );
+    }
     // Place the cursor over the player as is expected by screen readers.
     wmove( w_terrain, POSY + g->u.pos().y - center.y, POSX + g->u.pos().x - center.x );
 }
 
 cata::optional<tripoint> game::get_veh_dir_indicator_location( bool next ) const
 {
-    if( !get_option<bool>( "VEHICLE_DIR_INDICATOR" ) ) {
+    static const option_handle<bool> vehicle_dir_indicator( "VEHICLE_DIR_INDICATOR" );
+    if( !vehicle_dir_indicator.get() ) {
         return cata::nullopt;
     }
     const optional_vpart_position vp = m.veh_at( u.pos() );
@@ -3673,8 +3788,9 @@ int game::assign_npc_id()
 
 Creature *game::is_hostile_nearby()
 {
-    int distance = ( get_option<int>( "SAFEMODEPROXIMITY" ) <= 0 ) ? MAX_VIEW_DISTANCE :
-                   get_option<int>( "SAFEMODEPROXIMITY" );
+    static const option_handle<int> safemode_proximity( "SAFEMODEPROXIMITY" );
+    int distance = ( safemode_proximity.get() <= 0 ) ? MAX_VIEW_DISTANCE :
+                   safemode_proximity.get();
     return is_hostile_within( distance );
 }
 
@@ -3773,8 +3889,12 @@ void game::mon_info( const catacurses::window &w, int hor_padding )
     const int startrow = 0;
 
     int newseen = 0;
-    const int iProxyDist = ( get_option<int>( "SAFEMODEPROXIMITY" ) <= 0 ) ? MAX_VIEW_DISTANCE :
-                           get_option<int>( "SAFEMODEPROXIMITY" );
+    static const option_handle<int> safemode_proximity( "SAFEMODEPROXIMITY" );
+    static const option_handle<int> safemode_ignore_turns( "SAFEMODEIGNORETURNS" );
+    static const option_handle<bool> autosafemode( "AUTOSAFEMODE" );
+    static const option_handle<int> autosafemode_turns( "AUTOSAFEMODETURNS" );
+    const int iProxyDist = ( safemode_proximity.get() <= 0 ) ? MAX_VIEW_DISTANCE :
+                           safemode_proximity.get();
     // 7 0 1    unique_types uses these indices;
     // 6 8 2    0-7 are provide by direction_from()
     // 5 4 3    8 is used for local monsters (for when we explain them below)
@@ -3791,7 +3911,7 @@ void game::mon_info( const catacurses::window &w, int hor_padding )
 
     static int previous_turn = 0;
     const int current_turn = calendar::turn;
-    const int sm_ignored_turns = get_option<int>( "SAFEMODEIGNORETURNS" );
+    const int sm_ignored_turns = safemode_ignore_turns.get();
 
     for( auto &c : u.get_visible_creatures( MAPSIZE_X ) ) {
         const auto m = dynamic_cast<monster *>( c );
@@ -3939,10 +4059,10 @@ void game::mon_info( const catacurses::window &w, int hor_padding )
         if( safe_mode == SAFE_MODE_ON ) {
             set_safe_mode( SAFE_MODE_STOP );
         }
-    } else if( current_turn > previous_turn && get_option<bool>( "AUTOSAFEMODE" ) &&
+    } else if( current_turn > previous_turn && autosafemode.get() &&
                newseen == 0 ) { // Auto-safe mode, but only if it's a new turn
         turnssincelastmon += current_turn - previous_turn;
-        if( turnssincelastmon >= get_option<int>( "AUTOSAFEMODETURNS" ) && safe_mode == SAFE_MODE_OFF ) {
+        if( turnssincelastmon >= autosafemode_turns.get() && safe_mode == SAFE_MODE_OFF ) {
             set_safe_mode( SAFE_MODE_ON );
             add_msg( m_info, _( "Safe mode ON!" ) );
         }
@@ -4122,22 +4242,54 @@ void game::monmove()
 
     mfactions monster_factions;
     const auto &playerfaction = mfaction_str_id( "player" );
+    const auto update_mfactions = [&]() {
+        force_mfactions_update = false;
+        // monster::plan() needs to know about all monsters on the same team as the monster.
+        monster_factions.clear();
+        for( monster &critter : all_monsters() ) {
+            if( critter.friendly == 0 ) {
+                // Only 1 faction per mon at the moment.
+                monster_factions[ critter.faction ].insert( &critter );
+            } else {
+                monster_factions[ playerfaction ].insert( &critter );
+            }
+        }
+        cached_lev = m.get_abs_sub();
+    };
+    update_mfactions();
+
+    // Choosing a target is the expensive part of monster::plan() and only reads the game
+    // state, so it is done up front for all monsters at once, spread over several threads.
+    // Each result is used for the first plan of its monster this turn, later plans (and
+    // all plans after the monster factions had to be rebuilt) choose their target anew.
+    std::unordered_map<const monster *, monster::target_selection> planned_targets;
+    {
+        // Fill the lazily computed light levels now, monster vision depends on them.
+        for( int z = 0; z <= OVERMAP_HEIGHT; z++ ) {
+            natural_light_level( z );
+        }
+        std::vector<monster *> planners;
+        for( monster &critter : all_monsters() ) {
+            if( !critter.has_effect( effect_controlled ) && !critter.has_effect( effect_ridden ) ) {
+                planners.push_back( &critter );
+            }
+        }
+        std::vector<monster::target_selection> selections( planners.size() );
+        cata::parallel_for( planners.size(), [&]( const size_t i ) {
+            selections[i] = planners[i]->find_target( monster_factions );
+        } );
+        planned_targets.reserve( planners.size() );
+        for( size_t i = 0; i < planners.size(); i++ ) {
+            planned_targets.emplace( planners[i], selections[i] );
+        }
+    }
+
     for( monster &critter : all_monsters() ) {
-        // The first time through, and any time the map has been shifted, or a monster changed its z-level
+        // Any time the map has been shifted, or a monster changed its z-level
         // recalculate monster factions.
         if( cached_lev != m.get_abs_sub() || force_mfactions_update ) {
-            force_mfactions_update = false;
-            // monster::plan() needs to know about all monsters on the same team as the monster.
-            monster_factions.clear();
-            for( monster &critter : all_monsters() ) {
-                if( critter.friendly == 0 ) {
-                    // Only 1 faction per mon at the moment.
-                    monster_factions[ critter.faction ].insert( &critter );
-                } else {
-                    monster_factions[ playerfaction ].insert( &critter );
-                }
-            }
-            cached_lev = m.get_abs_sub();
+            update_mfactions();
+            planned_targets.clear();
         }
 
         // Critters in impassable tiles get pushed away, unless it's not impassable for them
@@ -4173,7 +4325,16 @@ void game::monmove()
             // Controlled critters don't make their own plans
             if( !critter.has_effect( effect_controlled ) ) {
                 // Formulate a path to follow
-                critter.plan( monster_factions );
+                const auto planned = planned_targets.find( &critter );
+                if( planned != planned_targets.end() && ( planned->second.target == nullptr ||
+                        !planned->second.target->is_dead_state() ) ) {
+                    critter.plan( monster_factions, planned->second );
+                } else {
+                    critter.plan( monster_factions );
+                }
+                if( planned != planned_targets.end() ) {
+                    planned_targets.erase( planned );
+                }
             }
             critter.move(); // Move one square, possibly hit u
             critter.process_triggers();
@@ -10415,9 +10576,42 @@ point game::update_map( int &x, int &y )
     // Update what parts of the world map we can see
     update_overmap_seen();
 
+    static const option_handle<bool> pregenerate_overmaps( "PREGENERATE_OVERMAPS" );
+    if( pregenerate_overmaps.get() ) {
+        overmap_buffer.pregenerate_near( u.global_omt_location(), point( shiftx, shifty ) );
+    }
+
     return point( shiftx, shifty );
 }
 
+/** The shift that update_map does when the player is at @p pos. */
+static point map_shift_at( const rl_vec2d &pos )
+{
+    return point( static_cast<int>( std::floor( ( pos.x - HALF_MAPSIZE_X ) / SEEX ) ),
+                  static_cast<int>( std::floor( ( pos.y - HALF_MAPSIZE_Y ) / SEEY ) ) );
+}
+
+void game::prefetch_map_ahead()
+{
+    if( !u.in_vehicle ) {
+        return;
+    }
+    const vehicle *veh = veh_pointer_or_null( m.veh_at( u.pos() ) );
+    if( veh == nullptr || veh->velocity == 0 ) {
+        return;
+    }
+    const float tiles_per_turn = veh->velocity / vehicles::vmiph_per_tile;
+    const rl_vec2d step = veh->move_vec() * tiles_per_turn;
+    const rl_vec2d pos( u.posx(), u.posy() );
+    // Generating is slow, only do it for what the very next turn needs.
+    const point next_shift = map_shift_at( pos + step );
+    m.prefetch_shift( next_shift.x, next_shift.y, 1 );
+    const point later_shift = map_shift_at( pos + step * 3 );
+    if( later_shift != next_shift ) {
+        m.prefetch_shift( later_shift.x, later_shift.y, 0 );
+    }
+}
+
 void game::update_overmap_seen()
 {
     const tripoint ompos = u.global_omt_location();
@@ -10937,6 +11131,7 @@ void game::quickload()
 
     if( active_world->save_exists( save_t::from_player_name( u.name ) ) ) {
         if( moves_since_last_save != 0 ) { // See if we need to reload anything
+            finish_background_saves();
             MAPBUFFER.reset();
             overmap_buffer.clear();
             try {
@@ -10954,10 +11149,25 @@ void game::quickload()
 void game::autosave()
 {
     //Don't autosave if the min-autosave interval has not passed since the last autosave/quicksave.
-    if( time( nullptr ) < last_save_timestamp + 60 * get_option<int>( "AUTOSAVE_MINUTES" ) ) {
+    static const option_handle<int> autosave_minutes( "AUTOSAVE_MINUTES" );
+    if( time( nullptr ) < last_save_timestamp + 60 * autosave_minutes.get() ) {
+        return;
+    }
+    //Don't autosave if the player hasn't done anything since the last autosave/quicksave,
+    //or while the map files of the previous autosave are still being written.
+    if( !moves_since_last_save || !background_writer::idle() ) {
         return;
     }
-    quicksave();    //Driving checks are handled by quicksave()
+    for( const std::string &error : background_writer::take_errors() ) {
+        popup( _( "Failed to save the maps: %s" ), error );
+    }
+    add_msg( m_info, _( "Autosaving..." ) );
+
+    time_t now = time( nullptr );
+    // The map files are written in the background while the game goes on.
+    save( true );
+    moves_since_last_save = 0;
+    last_save_timestamp = now;
 }
 
 void intro()
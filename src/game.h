@@ -202,8 +202,13 @@ class game
         /** write statistics to stdout and @return true if successful */
         bool dump_stats( const std::string &what, dump_mode mode, const std::vector<std::string> &opts );
 
-        /** Returns false if saving failed. */
-        bool save();
+        /**
+         * Returns false if saving failed.
+         * @param background Whether the map, player and faction files may still
+         * be written by the @ref background_writer when this returns. Write errors
+         * of those are reported on a later autosave instead.
+         */
+        bool save( bool background = false );
 
         /** Returns a list of currently active character saves. */
         std::vector<std::string> list_active_characters();
@@ -494,6 +499,12 @@ class game
         // Helper to make calling with a player pointer less verbose.
         point update_map( player &p );
         point update_map( int &x, int &y );
+        /**
+         * Guesses where the vehicle the player is in will be in the next turns
+         * and prepares the map shifts that @ref update_map would do there,
+         * see @ref map::prefetch_shift.
+         */
+        void prefetch_map_ahead();
         void update_overmap_seen(); // Update which overmap tiles we can see
 
         void process_artifact( item &it, player &p );
@@ -683,13 +694,13 @@ class game
 
         //private save functions.
         // returns false if saving failed for whatever reason
-        bool save_factions_missions_npcs();
+        bool save_factions_missions_npcs( bool background = false );
         void reset_npc_dispositions();
         void serialize_master( std::ostream &fout );
         // returns false if saving failed for whatever reason
         bool save_artifacts();
         // returns false if saving failed for whatever reason
-        bool save_maps();
+        bool save_maps( bool background = false );
         void save_weather( std::ostream &fout );
 #if defined(__ANDROID__)
         void save_shortcuts( std::ostream &fout );
@@ -762,6 +773,7 @@ class game
         void mon_info( const catacurses::window &,
                        int hor_padding = 0 ); // Prints a list of nearby monsters
         void cleanup_dead();     // Delete any dead NPCs/monsters
+        void monmove();          // Monster movement
         bool prompt_dangerous_tile( const tripoint &dest_loc ) const;
     private:
         void wield();
@@ -814,7 +826,6 @@ class game
         void rebuild_mon_at_cache();
 
         // Routine loop functions, approximately in order of execution
-        void monmove();          // Monster movement
         void overmap_npc_move(); // NPC overmap movement
         void process_activity(); // Processes and enacts the player's activity
         void handle_key_blocking_activity(); // Abort reading etc.
@@ -842,7 +853,7 @@ class game
     private:
 
         //  int autosave_timeout();  // If autosave enabled, how long we should wait for user inaction before saving.
-        void autosave();         // automatic quicksaves - Performs some checks before calling quicksave()
+        void autosave();         // automatic saves - Performs some checks, then saves with the map files written in the background
     public:
         void quicksave();        // Saves the game without quitting
         void disp_NPCs();        // Currently for debug use.  Lists global NPCs.
@@ -879,7 +890,7 @@ class game
         Creature *is_hostile_within( int distance );
 
         void move_save_to_graveyard();
-        bool save_player_data();
+        bool save_player_data( bool background = false );
         // ########################## DATA ################################
     protected:
         // May be a bit hacky, but it's probably better than the header spaghetti
@@ -3,6 +3,7 @@
 #define HANDLE_LIQUID_H
 
 #include "item_location.h"
+#include "item_stack.h"
 
 #include <list>
 
@@ -68,7 +69,7 @@ bool consume_liquid( item &liquid, int radius = 0 );
  * The iterator is invalidated in that case. Otherwise the item remains but may have
  * fewer charges.
  */
-bool handle_liquid_from_ground( std::list<item>::iterator on_ground, const tripoint &pos,
+bool handle_liquid_from_ground( item_stack::iterator on_ground, const tripoint &pos,
                                 int radius = 0 );
 
 /**
@@ -3471,9 +3471,7 @@ static cata::optional<tripoint> getNearFilledGasTank( const tripoint &center, in
 
 static int getGasDiscountCardQuality( const item &it )
 {
-    std::set<std::string> tags = it.type->item_tags;
-
-    for( const std::string &tag : tags ) {
+    for( const std::string &tag : it.type->item_tags.sorted_names() ) {
 
         if( tag.size() > 15 && tag.substr( 0, 15 ) == "DISCOUNT_VALUE_" ) {
             return atoi( tag.substr( 15 ).c_str() );
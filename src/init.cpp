@@ -1,6 +1,7 @@
 #include "init.h"
 
 #include <cstddef>
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <sstream> // for throwing errors
@@ -51,6 +52,7 @@
 #include "overlay_ordering.h"
 #include "overmap_connection.h"
 #include "overmap_location.h"
+#include "parallel.h"
 #include "profession.h"
 #include "recipe_dictionary.h"
 #include "recipe_groups.h"
@@ -108,8 +110,7 @@ void DynamicDataLoader::load_deferred( deferred_json &data )
         auto it = data.begin();
         for( size_t idx = 0; idx != n; ++idx ) {
             try {
-                std::istringstream str( it->first );
-                JsonIn jsin( str );
+                JsonIn jsin( it->first.data(), it->first.size() );
                 JsonObject jo = jsin.get_object();
                 load_object( jo, it->second );
             } catch( const std::exception &err ) {
@@ -131,6 +132,56 @@ void DynamicDataLoader::load_deferred( deferred_json &data )
     }
 }
 
+namespace
+{
+/** A data file read into memory, with its top level objects indexed ahead of loading. */
+struct indexed_json_file {
+    std::string data;
+    std::unique_ptr<JsonIn> jsin;
+    // Declared after jsin, as destroying a JsonObject still accesses its JsonIn.
+    std::vector<JsonObject> objects;
+    std::string error;
+};
+} // namespace
+
+/**
+ * Collects the objects of a data file, which might contain a single object
+ * or an array of objects.
+ */
+static void index_json_objects( JsonIn &jsin, std::vector<JsonObject> &objects )
+{
+    if( jsin.test_object() ) {
+        objects.push_back( jsin.get_object() );
+        // if there's anything else in the file, it's an error.
+        jsin.eat_whitespace();
+        if( jsin.good() ) {
+            jsin.error( string_format( "expected single-object file but found '%c'", jsin.peek() ) );
+        }
+    } else if( jsin.test_array() ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            // Moved, not copied, so growing the vector doesn't move the stream back.
+            objects.push_back( jsin.get_object() );
+        }
+    } else {
+        // not an object or an array?
+        jsin.error( "expected object or array" );
+    }
+}
+
+/** Runs on worker threads, must not touch any global state. */
+static void read_and_index_json_file( const std::string &file, indexed_json_file &indexed )
+{
+    std::ifstream infile( file.c_str(), std::ifstream::in | std::ifstream::binary );
+    indexed.data.assign( std::istreambuf_iterator<char>( infile ), std::istreambuf_iterator<char>() );
+    indexed.jsin.reset( new JsonIn( indexed.data.data(), indexed.data.size() ) );
+    try {
+        index_json_objects( *indexed.jsin, indexed.objects );
+    } catch( const JsonError &err ) {
+        indexed.error = err.what();
+    }
+}
+
 static void load_ignored_type( JsonObject &jo )
 {
     // This does nothing!
@@ -370,7 +421,7 @@ void DynamicDataLoader::initialize()
 }
 
 void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
-        loading_ui &ui )
+        loading_ui & )
 {
     assert( !finalized && "Can't load additional data after finalization. Must be unloaded first." );
     // We assume that each folder is consistent in itself,
@@ -389,24 +440,37 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
-    // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        std::ifstream infile( file.c_str(), std::ifstream::in | std::ifstream::binary );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
-        try {
-            // parse it
-            JsonIn jsin( iss );
-            load_all_from_json( jsin, src, ui, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( file + ": " + err.what() );
+    load_json_files_in_order( files, [&]( const std::string & file, JsonObject & jo ) {
+        load_object( jo, src, path, file );
+    } );
+}
+
+void load_json_files_in_order( const std::vector<std::string> &files,
+                               const std::function<void( const std::string &, JsonObject & )> &load )
+{
+    // Files are read and their objects indexed on worker threads, a batch at a time
+    // to bound memory use. The objects are then loaded here in the original order,
+    // so copy-from and overrides behave exactly as when loading file by file.
+    const size_t batch_size = cata::parallel_worker_count() * 4;
+    for( size_t first = 0; first < files.size(); first += batch_size ) {
+        const size_t count = std::min( batch_size, files.size() - first );
+        std::vector<indexed_json_file> batch( count );
+        cata::parallel_for( count, [&]( const size_t i ) {
+            read_and_index_json_file( files[first + i], batch[i] );
+        }, 1 );
+        for( size_t i = 0; i < count; i++ ) {
+            const std::string &file = files[first + i];
+            if( !batch[i].error.empty() ) {
+                throw std::runtime_error( file + ": " + batch[i].error );
+            }
+            try {
+                for( JsonObject &jo : batch[i].objects ) {
+                    load( file, jo );
+                    jo.finish();
+                }
+            } catch( const JsonError &err ) {
+                throw std::runtime_error( file + ": " + err.what() );
+            }
         }
     }
 }
@@ -414,27 +478,12 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
 void DynamicDataLoader::load_all_from_json( JsonIn &jsin, const std::string &src, loading_ui &,
         const std::string &base_path, const std::string &full_path )
 {
-    if( jsin.test_object() ) {
-        // find type and dispatch single object
-        JsonObject jo = jsin.get_object();
+    std::vector<JsonObject> objects;
+    index_json_objects( jsin, objects );
+    // find type and dispatch each object
+    for( JsonObject &jo : objects ) {
         load_object( jo, src, base_path, full_path );
         jo.finish();
-        // if there's anything else in the file, it's an error.
-        jsin.eat_whitespace();
-        if( jsin.good() ) {
-            jsin.error( string_format( "expected single-object file but found '%c'", jsin.peek() ) );
-        }
-    } else if( jsin.test_array() ) {
-        jsin.start_array();
-        // find type and dispatch each object until array close
-        while( !jsin.end_array() ) {
-            JsonObject jo = jsin.get_object();
-            load_object( jo, src, base_path, full_path );
-            jo.finish();
-        }
-    } else {
-        // not an object or an array?
-        jsin.error( "expected object or array" );
     }
 }
 
@@ -581,6 +630,8 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
     }
 
     check_consistency( ui );
+    // All flags used by the data have been interned now.
+    flag_id::freeze();
     finalized = true;
 }
 
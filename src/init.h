@@ -162,4 +162,13 @@ class DynamicDataLoader
         }
 };
 
+/**
+ * Calls @p load for each object in the JSON @p files, in the order of the files
+ * and of the objects within each file, on the calling thread. The files are read
+ * and parsed on worker threads meanwhile, see @ref cata::parallel_for.
+ * @throw std::runtime_error naming the file if it is not valid JSON.
+ */
+void load_json_files_in_order( const std::vector<std::string> &files,
+                               const std::function<void( const std::string &, JsonObject & )> &load );
+
 #endif
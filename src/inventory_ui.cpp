@@ -982,8 +982,9 @@ void selection_column::on_change( const inventory_entry &entry )
 }
 
 // TODO: Move it into some 'item_stack' class.
-static std::vector<std::list<item *>> restack_items( const std::list<item>::const_iterator &from,
-                                   const std::list<item>::const_iterator &to, bool check_components = false )
+template<typename Iterator>
+static std::vector<std::list<item *>> restack_items( const Iterator &from, const Iterator &to,
+                                   bool check_components = false )
 {
     std::vector<std::list<item *>> res;
 
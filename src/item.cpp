@@ -96,6 +96,31 @@ const skill_id skill_cooking( "cooking" );
 const quality_id quality_jack( "JACK" );
 const quality_id quality_lift( "LIFT" );
 
+static const flag_id flag_BELTED( "BELTED" );
+static const flag_id flag_CABLE_SPOOL( "CABLE_SPOOL" );
+static const flag_id flag_CHARGEDIM( "CHARGEDIM" );
+static const flag_id flag_ETHEREAL_ITEM( "ETHEREAL_ITEM" );
+static const flag_id flag_FAKE_MILL( "FAKE_MILL" );
+static const flag_id flag_FAKE_SMOKE( "FAKE_SMOKE" );
+static const flag_id flag_FIT( "FIT" );
+static const flag_id flag_LITCIG( "LITCIG" );
+static const flag_id flag_OUTER( "OUTER" );
+static const flag_id flag_OVERSIZE( "OVERSIZE" );
+static const flag_id flag_RADIO_ACTIVATION( "RADIO_ACTIVATION" );
+static const flag_id flag_REACH3( "REACH3" );
+static const flag_id flag_REACH_ATTACK( "REACH_ATTACK" );
+static const flag_id flag_SKINTIGHT( "SKINTIGHT" );
+static const flag_id flag_UNDERSIZE( "UNDERSIZE" );
+static const flag_id flag_USES_BIONIC_POWER( "USES_BIONIC_POWER" );
+static const flag_id flag_USE_UPS( "USE_UPS" );
+static const flag_id flag_VARSIZE( "VARSIZE" );
+static const flag_id flag_WAIST( "WAIST" );
+static const flag_id flag_WATER_EXTINGUISH( "WATER_EXTINGUISH" );
+static const flag_id flag_WET( "WET" );
+static const flag_id flag_WIND_EXTINGUISH( "WIND_EXTINGUISH" );
+static const flag_id flag_furred( "furred" );
+static const flag_id flag_wooled( "wooled" );
+
 const species_id FISH( "FISH" );
 const species_id BIRD( "BIRD" );
 const species_id INSECT( "INSECT" );
@@ -920,8 +945,8 @@ item::sizing item::get_sizing( const Character &p, bool wearable ) const
         // but that is fine because we have separate logic to adjust encumberance per each. One day we
         // may want to have fit be a flag that only applies if a piece of clothing is sized for you as there
         // is a bit of cognitive dissonance when something 'fits' and is 'oversized' and the same time
-        const bool undersize = has_flag( "UNDERSIZE" );
-        const bool oversize = has_flag( "OVERSIZE" );
+        const bool undersize = has_flag( flag_UNDERSIZE );
+        const bool oversize = has_flag( flag_OVERSIZE );
 
         if( undersize ) {
             if( small ) {
@@ -2373,10 +2398,8 @@ std::string item::info( std::vector<iteminfo> &info, const iteminfo_query *parts
 
         if( parts->test( iteminfo_parts::DESCRIPTION_FLAGS ) ) {
             // concatenate base and acquired flags...
-            std::vector<std::string> flags;
-            std::set_union( type->item_tags.begin(), type->item_tags.end(),
-                            item_tags.begin(), item_tags.end(),
-                            std::back_inserter( flags ) );
+            std::set<std::string> flags( type->item_tags.begin(), type->item_tags.end() );
+            flags.insert( item_tags.begin(), item_tags.end() );
 
             // ...and display those which have an info description
             for( const auto &e : flags ) {
@@ -3782,8 +3805,8 @@ int item::reach_range( const player &p ) const
 {
     int res = 1;
 
-    if( has_flag( "REACH_ATTACK" ) ) {
-        res = has_flag( "REACH3" ) ? 3 : 2;
+    if( has_flag( flag_REACH_ATTACK ) ) {
+        res = has_flag( flag_REACH3 ) ? 3 : 2;
     }
 
     // for guns consider any attached gunmods
@@ -3807,10 +3830,17 @@ void item::unset_flags()
 }
 
 bool item::has_flag( const std::string &f ) const
+{
+    // A name that was never interned cannot be in any flag set.
+    const cata::optional<flag_id> id = flag_id::find( f );
+    return id && has_flag( *id );
+}
+
+bool item::has_flag( const flag_id &f ) const
 {
     bool ret = false;
 
-    if( json_flag::get( f ).inherit() ) {
+    if( json_flag::inherits( f ) ) {
         for( const auto e : is_gun() ? gunmods() : toolmods() ) {
             // gunmods fired separately do not contribute to base gun flags
             if( !e->is_gun() && e->has_flag( f ) ) {
@@ -4238,7 +4268,7 @@ int item::get_encumber_when_containing(
     }
 
     // Fit checked before changes, fitting shouldn't reduce penalties from patching.
-    if( has_flag( "FIT" ) && has_flag( "VARSIZE" ) ) {
+    if( has_flag( flag_FIT ) && has_flag( flag_VARSIZE ) ) {
         encumber = std::max( encumber / 2, encumber - 10 );
     }
 
@@ -4286,13 +4316,13 @@ layer_level item::get_layer() const
         return type->layer;
     }
 
-    if( has_flag( "SKINTIGHT" ) ) {
+    if( has_flag( flag_SKINTIGHT ) ) {
         return UNDERWEAR;
-    } else if( has_flag( "WAIST" ) ) {
+    } else if( has_flag( flag_WAIST ) ) {
         return WAIST_LAYER;
-    } else if( has_flag( "OUTER" ) ) {
+    } else if( has_flag( flag_OUTER ) ) {
         return OUTER_LAYER;
-    } else if( has_flag( "BELTED" ) ) {
+    } else if( has_flag( flag_BELTED ) ) {
         return BELTED_LAYER;
     } else {
         return REGULAR_LAYER;
@@ -4327,11 +4357,11 @@ int item::get_warmth() const
     }
     int result = t->warmth;
 
-    if( item_tags.count( "furred" ) > 0 ) {
+    if( item_tags.count( flag_furred ) > 0 ) {
         fur_lined = 35 * get_coverage() / 100;
     }
 
-    if( item_tags.count( "wooled" ) > 0 ) {
+    if( item_tags.count( flag_wooled ) > 0 ) {
         wool_lined = 20 * get_coverage() / 100;
     }
 
@@ -5735,7 +5765,7 @@ int item::ammo_remaining() const
 
     if( is_tool() || is_gun() ) {
         // includes auxiliary gunmods
-        if( has_flag( "USES_BIONIC_POWER" ) ) {
+        if( has_flag( flag_USES_BIONIC_POWER ) ) {
             int power = g->u.power_level;
             return power;
         }
@@ -5866,7 +5896,7 @@ int item::ammo_consume( int qty, const tripoint &pos )
 
     } else if( is_tool() || is_gun() ) {
         qty = std::min( qty, charges );
-        if( has_flag( "USES_BIONIC_POWER" ) ) {
+        if( has_flag( flag_USES_BIONIC_POWER ) ) {
             charges = g->u.power_level;
             g->u.charge_power( -qty );
         }
@@ -6317,7 +6347,7 @@ int item::units_remaining( const Character &ch, int limit ) const
     }
 
     auto res = ammo_remaining();
-    if( res < limit && has_flag( "USE_UPS" ) ) {
+    if( res < limit && has_flag( flag_USE_UPS ) ) {
         res += ch.charges_of( "UPS", limit - res );
     }
 
@@ -6713,7 +6743,7 @@ int item::getlight_emit() const
     if( lumint == 0 ) {
         return 0;
     }
-    if( has_flag( "CHARGEDIM" ) && is_tool() && !has_flag( "USE_UPS" ) ) {
+    if( has_flag( flag_CHARGEDIM ) && is_tool() && !has_flag( flag_USE_UPS ) ) {
         // Falloff starts at 1/5 total charge and scales linearly from there to 0.
         if( ammo_capacity() && ammo_remaining() < ( ammo_capacity() / 5 ) ) {
             lumint *= ammo_remaining() * 5.0 / ammo_capacity();
@@ -7329,7 +7359,7 @@ std::string item::components_to_string() const
 
 bool item::needs_processing() const
 {
-    return active || has_flag( "RADIO_ACTIVATION" ) || has_flag( "ETHEREAL_ITEM" ) ||
+    return active || has_flag( flag_RADIO_ACTIVATION ) || has_flag( flag_ETHEREAL_ITEM ) ||
            ( is_container() && !contents.empty() && contents.front().needs_processing() ) ||
            is_artifact() || is_food();
 }
@@ -7926,7 +7956,7 @@ bool item::process_extinguish( player *carrier, const tripoint &pos )
         extinguish = true;
     }
     if( in_inv && windpower > 5 && !g->is_sheltered( pos ) &&
-        this->has_flag( "WIND_EXTINGUISH" ) ) {
+        this->has_flag( flag_WIND_EXTINGUISH ) ) {
         windtoostrong = true;
         extinguish = true;
     }
@@ -7947,7 +7977,7 @@ bool item::process_extinguish( player *carrier, const tripoint &pos )
     }
 
     // cig dies out
-    if( has_flag( "LITCIG" ) ) {
+    if( has_flag( flag_LITCIG ) ) {
         if( typeId() == "cig_lit" ) {
             convert( "cig_butt" );
         } else if( typeId() == "cigar_lit" ) {
@@ -8068,7 +8098,7 @@ bool item::process_tool( player *carrier, const tripoint &pos )
     energy -= ammo_consume( energy, pos );
 
     // for items in player possession if insufficient charges within tool try UPS
-    if( carrier && has_flag( "USE_UPS" ) ) {
+    if( carrier && has_flag( flag_USE_UPS ) ) {
         if( carrier->use_charges_if_avail( "UPS", energy ) ) {
             energy = 0;
         }
@@ -8076,7 +8106,7 @@ bool item::process_tool( player *carrier, const tripoint &pos )
 
     // if insufficient available charges shutdown the tool
     if( energy > 0 ) {
-        if( carrier && has_flag( "USE_UPS" ) ) {
+        if( carrier && has_flag( flag_USE_UPS ) ) {
             carrier->add_msg_if_player( m_info, _( "You need an UPS to run the %s!" ), tname() );
         }
 
@@ -8121,7 +8151,7 @@ bool item::process( player *carrier, const tripoint &pos, bool activate,
         }
     }
 
-    if( has_flag( "ETHEREAL_ITEM" ) ) {
+    if( has_flag( flag_ETHEREAL_ITEM ) ) {
         if( !has_var( "ethereal" ) ) {
             return true;
         }
@@ -8168,27 +8198,27 @@ bool item::process( player *carrier, const tripoint &pos, bool activate,
         g->m.emit_field( pos, e );
     }
 
-    if( has_flag( "FAKE_SMOKE" ) && process_fake_smoke( carrier, pos ) ) {
+    if( has_flag( flag_FAKE_SMOKE ) && process_fake_smoke( carrier, pos ) ) {
         return true;
     }
-    if( has_flag( "FAKE_MILL" ) && process_fake_mill( carrier, pos ) ) {
+    if( has_flag( flag_FAKE_MILL ) && process_fake_mill( carrier, pos ) ) {
         return true;
     }
     if( is_corpse() && process_corpse( carrier, pos ) ) {
         return true;
     }
-    if( has_flag( "WET" ) && process_wet( carrier, pos ) ) {
+    if( has_flag( flag_WET ) && process_wet( carrier, pos ) ) {
         // Drying items are never destroyed, but we want to exit so they don't get processed as tools.
         return false;
     }
-    if( has_flag( "LITCIG" ) && process_litcig( carrier, pos ) ) {
+    if( has_flag( flag_LITCIG ) && process_litcig( carrier, pos ) ) {
         return true;
     }
-    if( ( has_flag( "WATER_EXTINGUISH" ) || has_flag( "WIND_EXTINGUISH" ) ) &&
+    if( ( has_flag( flag_WATER_EXTINGUISH ) || has_flag( flag_WIND_EXTINGUISH ) ) &&
         process_extinguish( carrier, pos ) ) {
         return false;
     }
-    if( has_flag( "CABLE_SPOOL" ) ) {
+    if( has_flag( flag_CABLE_SPOOL ) ) {
         // DO NOT process this as a tool! It really isn't!
         return process_cable( carrier, pos );
     }
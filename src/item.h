@@ -18,6 +18,7 @@
 #include "debug.h"
 #include "enums.h"
 #include "faction.h"
+#include "flag.h"
 #include "flat_set.h"
 #include "io_tags.h"
 #include "item_location.h"
@@ -1265,6 +1266,8 @@ class item : public visitable<item>
          */
         /*@{*/
         bool has_flag( const std::string &flag ) const;
+        /** Same as above, but without any string lookups, use it for flags checked often. */
+        bool has_flag( const flag_id &flag ) const;
         bool has_any_flag( const std::vector<std::string> &flags ) const;
 
         /** Idempotent filter setting an item specific flag. */
@@ -1976,7 +1979,7 @@ class item : public visitable<item>
         std::list<item> components;
         /** What faults (if any) currently apply to this item */
         std::set<fault_id> faults;
-        cata::flat_set<std::string> item_tags; // generic item specific flags
+        flag_set item_tags; // generic item specific flags
 
     private:
         const itype *curammo = nullptr;
@@ -206,7 +206,7 @@ void Item_factory::finalize_pre( itype &obj )
     if( obj.volume <= 0_ml ) {
         obj.volume = units::from_milliliter( 1 );
     }
-    for( const auto &tag : obj.item_tags ) {
+    for( const std::string &tag : obj.item_tags.sorted_names() ) {
         if( tag.size() > 6 && tag.substr( 0, 6 ) == "LIGHT_" ) {
             obj.light_emission = std::max( atoi( tag.substr( 6 ).c_str() ), 0 );
         }
@@ -2084,7 +2084,10 @@ void Item_factory::load_basic_info( JsonObject &jo, itype &def, const std::strin
         def.explosion = load_explosion_data( je );
     }
 
-    assign( jo, "flags", def.item_tags );
+    std::set<std::string> flags( def.item_tags.begin(), def.item_tags.end() );
+    if( assign( jo, "flags", flags ) ) {
+        def.item_tags = flags;
+    }
     assign( jo, "faults", def.faults );
 
     if( jo.has_member( "qualities" ) ) {
@@ -2199,8 +2202,7 @@ void Item_factory::migrate_item( const itype_id &id, item &obj )
 {
     auto iter = migrations.find( id );
     if( iter != migrations.end() ) {
-        std::copy( iter->second.flags.begin(), iter->second.flags.end(), std::inserter( obj.item_tags,
-                   obj.item_tags.begin() ) );
+        obj.item_tags.insert( iter->second.flags.begin(), iter->second.flags.end() );
         obj.charges = iter->second.charges;
 
         for( const auto &c : iter->second.contents ) {
@@ -1,12 +1,87 @@
 #include "item_stack.h"
 
 #include <algorithm>
-#include <list>
 #include <iterator>
 
 #include "item.h"
 #include "units.h"
 
+item_colony::item_colony( const item_colony &source )
+{
+    *this = source;
+}
+
+item_colony::item_colony( item_colony &&source ) noexcept
+{
+    *this = std::move( source );
+}
+
+item_colony &item_colony::operator=( const item_colony &source )
+{
+    if( this != &source ) {
+        clear();
+        for( const item &it : source ) {
+            insert( it );
+        }
+    }
+    return *this;
+}
+
+item_colony &item_colony::operator=( item_colony &&source ) noexcept
+{
+    // Moving the colony keeps its elements in place, and with them their links
+    nodes = std::move( source.nodes );
+    first = source.first;
+    last = source.last;
+    source.nodes.clear();
+    source.first = nullptr;
+    source.last = nullptr;
+    return *this;
+}
+
+item_colony::iterator item_colony::insert( const item &it )
+{
+    return insert_before( cend(), it );
+}
+
+item_colony::iterator item_colony::insert_before( const const_iterator position, const item &it )
+{
+    node *const added = &*nodes.emplace( it );
+    node *const next = const_cast<node *>( position.current );
+    added->next = next;
+    added->prev = next == nullptr ? last : next->prev;
+    ( added->prev == nullptr ? first : added->prev->next ) = added;
+    ( next == nullptr ? last : next->prev ) = added;
+    return iterator( added, this );
+}
+
+item_colony::iterator item_colony::erase( const const_iterator position )
+{
+    node *const removed = const_cast<node *>( position.current );
+    node *const next = removed->next;
+    ( removed->prev == nullptr ? first : removed->prev->next ) = next;
+    ( next == nullptr ? last : next->prev ) = removed->prev;
+    nodes.erase( nodes.get_iterator_from_pointer( removed ) );
+    return iterator( next, this );
+}
+
+void item_colony::clear()
+{
+    nodes.clear();
+    first = nullptr;
+    last = nullptr;
+}
+
+item_colony::iterator item_colony::get_iterator_from_pointer( item *it )
+{
+    return iterator( static_cast<node *>( it ), this );
+}
+
+void item_colony::change_minimum_group_size( const unsigned short size )
+{
+    nodes.change_minimum_group_size( size );
+}
+
 size_t item_stack::size() const
 {
     return mystack->size();
@@ -19,55 +94,60 @@ bool item_stack::empty() const
 
 void item_stack::clear()
 {
-    // An acceptable implementation for list; would be bad for vector
+    // Erasing from a colony doesn't move the other items around
     while( !empty() ) {
         erase( begin() );
     }
 }
 
-std::list<item>::iterator item_stack::begin()
+item_stack::iterator item_stack::begin()
 {
     return mystack->begin();
 }
 
-std::list<item>::iterator item_stack::end()
+item_stack::iterator item_stack::end()
 {
     return mystack->end();
 }
 
-std::list<item>::const_iterator item_stack::begin() const
+item_stack::const_iterator item_stack::begin() const
 {
     return mystack->cbegin();
 }
 
-std::list<item>::const_iterator item_stack::end() const
+item_stack::const_iterator item_stack::end() const
 {
     return mystack->cend();
 }
 
-std::list<item>::reverse_iterator item_stack::rbegin()
+item_stack::reverse_iterator item_stack::rbegin()
 {
     return mystack->rbegin();
 }
 
-std::list<item>::reverse_iterator item_stack::rend()
+item_stack::reverse_iterator item_stack::rend()
 {
     return mystack->rend();
 }
 
-std::list<item>::const_reverse_iterator item_stack::rbegin() const
+item_stack::const_reverse_iterator item_stack::rbegin() const
 {
     return mystack->crbegin();
 }
 
-std::list<item>::const_reverse_iterator item_stack::rend() const
+item_stack::const_reverse_iterator item_stack::rend() const
 {
     return mystack->crend();
 }
 
 item &item_stack::front()
 {
-    return mystack->front();
+    return *mystack->begin();
+}
+
+item_stack::iterator item_stack::get_iterator_from_pointer( item *it )
+{
+    return mystack->get_iterator_from_pointer( it );
 }
 
 item &item_stack::operator[]( size_t index )
@@ -3,11 +3,160 @@
 #define ITEM_STACK_H
 
 #include <cstddef>
-#include <list>
+#include <iterator>
 
+#include "colony.h"
 #include "units.h"
 #include "item.h"
 
+/**
+ * Storage for the items on a map tile or in a vehicle part. The items live in a
+ * colony, so they don't move and pointers and iterators to them stay valid until
+ * they are removed. A colony puts new elements into the slots of removed ones
+ * though, so the items are also linked in the order they were added, which is
+ * the order of iteration.
+ * Iterators stay valid when the storage is moved, except for end().
+ */
+class item_colony
+{
+    private:
+        /** An item with its neighbors in insertion order. */
+        struct node : item {
+            node *prev = nullptr;
+            node *next = nullptr;
+
+            explicit node( const item &it ) : item( it ) {}
+        };
+
+        template<typename T, typename N>
+        class iterator_base
+        {
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = item;
+                using difference_type = std::ptrdiff_t;
+                using pointer = T *;
+                using reference = T &;
+
+                iterator_base() = default;
+                /** Conversions between iterator and const_iterator, like colony has them. */
+                template<typename OT, typename ON>
+                iterator_base( const iterator_base<OT, ON> &other ) :
+                    current( const_cast<N *>( other.current ) ), owner( other.owner ) {}
+
+                reference operator*() const {
+                    return *current;
+                }
+                pointer operator->() const {
+                    return current;
+                }
+                iterator_base &operator++() {
+                    current = current->next;
+                    return *this;
+                }
+                iterator_base operator++( int ) {
+                    iterator_base ret = *this;
+                    ++*this;
+                    return ret;
+                }
+                iterator_base &operator--() {
+                    current = current == nullptr ? owner->last : current->prev;
+                    return *this;
+                }
+                iterator_base operator--( int ) {
+                    iterator_base ret = *this;
+                    --*this;
+                    return ret;
+                }
+                template<typename OT, typename ON>
+                bool operator==( const iterator_base<OT, ON> &rhs ) const {
+                    return current == rhs.current;
+                }
+                template<typename OT, typename ON>
+                bool operator!=( const iterator_base<OT, ON> &rhs ) const {
+                    return current != rhs.current;
+                }
+
+            private:
+                friend class item_colony;
+                template<typename, typename>
+                friend class iterator_base;
+
+                iterator_base( N *current, const item_colony *owner ) : current( current ), owner( owner ) {}
+
+                /** nullptr for end() */
+                N *current = nullptr;
+                const item_colony *owner = nullptr;
+        };
+
+    public:
+        using iterator = iterator_base<item, node>;
+        using const_iterator = iterator_base<const item, const node>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        item_colony() = default;
+        item_colony( const item_colony &source );
+        item_colony( item_colony &&source ) noexcept;
+        item_colony &operator=( const item_colony &source );
+        item_colony &operator=( item_colony &&source ) noexcept;
+
+        size_t size() const {
+            return nodes.size();
+        }
+        bool empty() const {
+            return nodes.empty();
+        }
+
+        iterator begin() {
+            return iterator( first, this );
+        }
+        iterator end() {
+            return iterator( nullptr, this );
+        }
+        const_iterator begin() const {
+            return const_iterator( first, this );
+        }
+        const_iterator end() const {
+            return const_iterator( nullptr, this );
+        }
+        const_iterator cbegin() const {
+            return begin();
+        }
+        const_iterator cend() const {
+            return end();
+        }
+        reverse_iterator rbegin() {
+            return reverse_iterator( end() );
+        }
+        reverse_iterator rend() {
+            return reverse_iterator( begin() );
+        }
+        const_reverse_iterator crbegin() const {
+            return const_reverse_iterator( cend() );
+        }
+        const_reverse_iterator crend() const {
+            return const_reverse_iterator( cbegin() );
+        }
+
+        /** Adds the item after all others. */
+        iterator insert( const item &it );
+        /** Adds the item right before @p position, e.g. where erase() took one from. */
+        iterator insert_before( const_iterator position, const item &it );
+        /** Removes the item, returns the one that came after it. */
+        iterator erase( const_iterator position );
+        void clear();
+        /** Iterator to the item, which must be stored here. */
+        iterator get_iterator_from_pointer( item *it );
+        /** See colony::change_minimum_group_size */
+        void change_minimum_group_size( unsigned short size );
+
+    private:
+        colony<node> nodes;
+        node *first = nullptr;
+        node *last = nullptr;
+};
+
 // A wrapper class to bundle up the references needed for a caller to safely manipulate
 // items and obtain information about items at a particular map x/y location.
 // Note this does not expose the container itself,
@@ -19,28 +168,39 @@
 class item_stack
 {
     protected:
-        std::list<item> *mystack;
+        item_colony *mystack;
 
     public:
-        item_stack( std::list<item> *mystack ) : mystack( mystack ) { }
+        using iterator = item_colony::iterator;
+        using const_iterator = item_colony::const_iterator;
+        using reverse_iterator = item_colony::reverse_iterator;
+        using const_reverse_iterator = item_colony::const_reverse_iterator;
+
+        item_stack( item_colony *mystack ) : mystack( mystack ) { }
 
         size_t size() const;
         bool empty() const;
-        virtual std::list<item>::iterator erase( std::list<item>::iterator it ) = 0;
+        virtual iterator erase( const_iterator it ) = 0;
         virtual void push_back( const item &newitem ) = 0;
-        virtual void insert_at( std::list<item>::iterator, const item &newitem ) = 0;
+        /**
+         * Puts the item back in front of @p index, where an item was erased from.
+         * Only meant for item processing, never merges charges.
+         */
+        virtual void insert_at( const_iterator index, const item &newitem ) = 0;
         virtual void clear();
         item &front();
         item &operator[]( size_t index );
+        /** Iterator to the item, which must be part of this stack. */
+        iterator get_iterator_from_pointer( item *it );
 
-        std::list<item>::iterator begin();
-        std::list<item>::iterator end();
-        std::list<item>::const_iterator begin() const;
-        std::list<item>::const_iterator end() const;
-        std::list<item>::reverse_iterator rbegin();
-        std::list<item>::reverse_iterator rend();
-        std::list<item>::const_reverse_iterator rbegin() const;
-        std::list<item>::const_reverse_iterator rend() const;
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+        reverse_iterator rbegin();
+        reverse_iterator rend();
+        const_reverse_iterator rbegin() const;
+        const_reverse_iterator rend() const;
 
         /** Maximum number of items allowed here */
         virtual int count_limit() const = 0;
@@ -14,6 +14,7 @@
 #include "damage.h"
 #include "enums.h" // point
 #include "explosion.h"
+#include "flag.h"
 #include "game_constants.h"
 #include "iuse.h" // use_function
 #include "optional.h"
@@ -807,7 +808,7 @@ struct itype {
         /** Fields to emit when item is in active state */
         std::set<emit_id> emits;
 
-        std::set<std::string> item_tags;
+        flag_set item_tags;
         std::set<matec_id> techniques;
 
         // Minimum stat(s) or skill(s) to use the item
@@ -1773,7 +1773,7 @@ static bool good_fishing_spot( tripoint pos )
 {
     std::vector<monster *> fishables = g->get_fishable( 60, pos );
     // isolated little body of water with no definite fish population
-    oter_id &cur_omt = overmap_buffer.ter( ms_to_omt_copy( g->m.getabs( pos ) ) );
+    const oter_id cur_omt = overmap_buffer.ter( ms_to_omt_copy( g->m.getabs( pos ) ) );
     std::string om_id = cur_omt.id().c_str();
     if( fishables.empty() && !g->m.has_flag( "CURRENT", pos ) &&
         om_id.find( "river_" ) == std::string::npos && !cur_omt->is_lake() && !cur_omt->is_lake_shore() ) {
@@ -8173,7 +8173,7 @@ int iuse::washclothes( player *p, item *, bool, const tripoint & )
                                        crafting_inv.charges_of( "detergent" ) );
 
     const inventory_filter_preset preset( []( const item_location & location ) {
-        return location->item_tags.find( "FILTHY" ) != location->item_tags.end();
+        return location->item_tags.count( "FILTHY" ) > 0;
     } );
     auto make_raw_stats = [available_water, available_cleanser](
                               const std::map<const item *, int> &items
@@ -80,12 +80,19 @@ JsonObject::JsonObject( JsonIn &j )
     while( !jsin->end_object() ) {
         std::string n = jsin->get_member_name();
         int p = jsin->tell();
-        if( n != "//" && n != "comment" && positions.count( n ) > 0 ) {
+        const auto iter = std::find_if( positions.begin(), positions.end(),
+        [&n]( const std::pair<std::string, int> &e ) {
+            return e.first == n;
+        } );
+        if( iter == positions.end() ) {
+            positions.emplace_back( std::move( n ), p );
+        } else if( n != "//" && n != "comment" ) {
             // members with name "//" or "comment" are used for comments and
             // should be ignored anyway.
             j.error( "duplicate entry in json object" );
+        } else {
+            iter->second = p;
         }
-        positions[n] = p;
         jsin->skip_value();
     }
     end = jsin->tell();
@@ -101,6 +108,16 @@ JsonObject::JsonObject( const JsonObject &jo )
     final_separator = jo.final_separator;
 }
 
+JsonObject::JsonObject( JsonObject &&jo ) noexcept :
+    positions( std::move( jo.positions ) ),
+    start( jo.start ),
+    end( jo.end ),
+    final_separator( jo.final_separator ),
+    jsin( jo.jsin )
+{
+    jo.jsin = nullptr;
+}
+
 JsonObject &JsonObject::operator=( const JsonObject &jo )
 {
     jsin = jo.jsin;
@@ -112,6 +129,18 @@ JsonObject &JsonObject::operator=( const JsonObject &jo )
     return *this;
 }
 
+JsonObject &JsonObject::operator=( JsonObject &&jo ) noexcept
+{
+    jsin = jo.jsin;
+    start = jo.start;
+    positions = std::move( jo.positions );
+    end = jo.end;
+    final_separator = jo.final_separator;
+    jo.jsin = nullptr;
+
+    return *this;
+}
+
 void JsonObject::finish()
 {
     if( jsin && jsin->good() ) {
@@ -129,10 +158,20 @@ bool JsonObject::empty()
     return positions.empty();
 }
 
+int JsonObject::find_position( const std::string &name ) const
+{
+    for( const auto &elem : positions ) {
+        if( elem.first == name ) {
+            return elem.second;
+        }
+    }
+    return 0;
+}
+
 int JsonObject::verify_position( const std::string &name,
                                  const bool throw_exception )
 {
-    int pos = positions[name]; // initialized to 0 if it doesn't exist
+    int pos = find_position( name );
     if( pos > start ) {
         return pos;
     } else if( throw_exception && !jsin ) {
@@ -217,7 +256,7 @@ bool JsonObject::get_bool( const std::string &name )
 
 bool JsonObject::get_bool( const std::string &name, const bool fallback )
 {
-    int pos = positions[name];
+    int pos = find_position( name );
     if( pos <= start ) {
         return fallback;
     }
@@ -234,7 +273,7 @@ int JsonObject::get_int( const std::string &name )
 
 int JsonObject::get_int( const std::string &name, const int fallback )
 {
-    int pos = positions[name];
+    int pos = find_position( name );
     if( pos <= start ) {
         return fallback;
     }
@@ -251,7 +290,7 @@ double JsonObject::get_float( const std::string &name )
 
 double JsonObject::get_float( const std::string &name, const double fallback )
 {
-    int pos = positions[name];
+    int pos = find_position( name );
     if( pos <= start ) {
         return fallback;
     }
@@ -268,7 +307,7 @@ std::string JsonObject::get_string( const std::string &name )
 
 std::string JsonObject::get_string( const std::string &name, const std::string &fallback )
 {
-    int pos = positions[name];
+    int pos = find_position( name );
     if( pos <= start ) {
         return fallback;
     }
@@ -280,7 +319,7 @@ std::string JsonObject::get_string( const std::string &name, const std::string &
 
 JsonArray JsonObject::get_array( const std::string &name )
 {
-    int pos = positions[name];
+    int pos = find_position( name );
     if( pos <= start ) {
         return JsonArray(); // empty array
     }
@@ -310,7 +349,7 @@ std::vector<std::string> JsonObject::get_string_array( const std::string &name )
 
 JsonObject JsonObject::get_object( const std::string &name )
 {
-    int pos = positions[name];
+    int pos = find_position( name );
     if( pos <= start ) {
         return JsonObject(); // empty object
     }
@@ -694,35 +733,91 @@ void add_array_to_set( std::set<std::string> &s, JsonObject &json, const std::st
 
 int JsonIn::tell()
 {
-    return stream->tellg();
+    if( stream ) {
+        return stream->tellg();
+    }
+    return buffer_pos;
+}
+bool JsonIn::good()
+{
+    if( stream ) {
+        return stream->good();
+    }
+    return !buffer_eof;
 }
-char JsonIn::peek()
+bool JsonIn::eof()
 {
-    return static_cast<char>( stream->peek() );
+    if( stream ) {
+        return stream->eof();
+    }
+    return buffer_eof;
 }
-bool JsonIn::good()
+bool JsonIn::fail()
 {
-    return stream->good();
+    if( stream ) {
+        return stream->fail();
+    }
+    return buffer_eof;
 }
 
 void JsonIn::seek( int pos )
 {
-    stream->clear();
-    stream->seekg( pos );
+    if( stream ) {
+        stream->clear();
+        stream->seekg( pos );
+    } else {
+        buffer_eof = false;
+        buffer_pos = std::min<size_t>( std::max( pos, 0 ), buffer_size );
+    }
     ate_separator = false;
 }
 
+void JsonIn::seek_by( int offset )
+{
+    if( stream ) {
+        stream->seekg( offset, std::istream::cur );
+    } else {
+        buffer_eof = false;
+        buffer_pos = std::min<size_t>( std::max<int>( buffer_pos + offset, 0 ), buffer_size );
+    }
+}
+
+void JsonIn::get_chars( char *text, const int n )
+{
+    if( stream ) {
+        stream->get( text, n );
+        return;
+    }
+    int i = 0;
+    while( i < n - 1 && buffer_pos < buffer_size && buffer[buffer_pos] != '\n' ) {
+        text[i++] = buffer[buffer_pos++];
+    }
+    text[i] = '\0';
+    if( buffer_pos >= buffer_size ) {
+        buffer_eof = true;
+    }
+}
+
 void JsonIn::eat_whitespace()
 {
+    if( !stream ) {
+        while( buffer_pos < buffer_size && is_whitespace( buffer[buffer_pos] ) ) {
+            ++buffer_pos;
+        }
+        if( buffer_pos >= buffer_size ) {
+            buffer_eof = true;
+        }
+        return;
+    }
     while( is_whitespace( peek() ) ) {
-        stream->get();
+        get_char();
     }
 }
 
 void JsonIn::uneat_whitespace()
 {
     while( tell() > 0 ) {
-        stream->seekg( -1, std::istream::cur );
+        seek_by( -1 );
         if( !is_whitespace( peek() ) ) {
             break;
         }
@@ -750,7 +845,7 @@ void JsonIn::skip_separator()
         if( ate_separator ) {
             error( "duplicate separator" );
         }
-        stream->get();
+        get_char();
         ate_separator = true;
     } else if( ch == ']' || ch == '}' || ch == ':' ) {
         // okay
@@ -779,7 +874,7 @@ void JsonIn::skip_pair_separator()
 {
     char ch;
     eat_whitespace();
-    stream->get( ch );
+    ch = get_char();
     if( ch != ':' ) {
         std::stringstream err;
         err << "expected pair separator ':', not '" << ch << "'";
@@ -794,16 +889,16 @@ void JsonIn::skip_string()
 {
     char ch;
     eat_whitespace();
-    stream->get( ch );
+    ch = get_char();
     if( ch != '"' ) {
         std::stringstream err;
         err << "expecting string but found '" << ch << "'";
         error( err.str(), -1 );
     }
-    while( stream->good() ) {
-        stream->get( ch );
+    while( good() ) {
+        ch = get_char();
         if( ch == '\\' ) {
-            stream->get( ch );
+            ch = get_char();
             continue;
         } else if( ch == '"' ) {
             break;
@@ -868,7 +963,7 @@ void JsonIn::skip_true()
 {
     char text[5];
     eat_whitespace();
-    stream->get( text, 5 );
+    get_chars( text, 5 );
     if( strcmp( text, "true" ) != 0 ) {
         std::stringstream err;
         err << "expected \"true\", but found \"" << text << "\"";
@@ -881,7 +976,7 @@ void JsonIn::skip_false()
 {
     char text[6];
     eat_whitespace();
-    stream->get( text, 6 );
+    get_chars( text, 6 );
     if( strcmp( text, "false" ) != 0 ) {
         std::stringstream err;
         err << "expected \"false\", but found \"" << text << "\"";
@@ -894,7 +989,7 @@ void JsonIn::skip_null()
 {
     char text[5];
     eat_whitespace();
-    stream->get( text, 5 );
+    get_chars( text, 5 );
     if( strcmp( text, "null" ) != 0 ) {
         std::stringstream err;
         err << "expected \"null\", but found \"" << text << "\"";
@@ -908,11 +1003,11 @@ void JsonIn::skip_number()
     char ch;
     eat_whitespace();
     // skip all of (+-0123456789.eE)
-    while( stream->good() ) {
-        stream->get( ch );
+    while( good() ) {
+        ch = get_char();
         if( ch != '+' && ch != '-' && ( ch < '0' || ch > '9' ) &&
             ch != 'e' && ch != 'E' && ch != '.' ) {
-            stream->unget();
+            unget_char();
             break;
         }
     }
@@ -935,16 +1030,30 @@ std::string JsonIn::get_string()
     eat_whitespace();
     int startpos = tell();
     // the first character had better be a '"'
-    stream->get( ch );
+    ch = get_char();
     if( ch != '"' ) {
         std::stringstream err;
         err << "expecting string but got '" << ch << "'";
         error( err.str(), -1 );
     }
+    // Most strings contain no escapes, those can be copied out of a buffer in one go.
+    if( !stream ) {
+        size_t end = buffer_pos;
+        while( end < buffer_size && buffer[end] != '"' && buffer[end] != '\\' &&
+               static_cast<unsigned char>( buffer[end] ) >= 0x20 ) {
+            ++end;
+        }
+        if( end < buffer_size && buffer[end] == '"' ) {
+            s.assign( buffer + buffer_pos, end - buffer_pos );
+            buffer_pos = end + 1;
+            end_value();
+            return s;
+        }
+    }
     // add chars to the string, one at a time, converting:
     // \", \\, \/, \b, \f, \n, \r, \t and \uxxxx according to JSON spec.
-    while( stream->good() ) {
-        stream->get( ch );
+    while( good() ) {
+        ch = get_char();
         if( ch == '\\' ) {
             if( backslash ) {
                 s += '\\';
@@ -971,7 +1080,7 @@ std::string JsonIn::get_string()
                 s += '\t';
             } else if( ch == 'u' ) {
                 // get the next four characters as hexadecimal
-                stream->get( unihex, 5 );
+                get_chars( unihex, 5 );
                 // insert the appropriate unicode character in utf8
                 // TODO: verify that unihex is in fact 4 hex digits.
                 char **endptr = nullptr;
@@ -998,11 +1107,10 @@ std::string JsonIn::get_string()
         }
     }
     // if we get to here, probably hit a premature EOF?
-    if( stream->eof() ) {
-        stream->clear();
+    if( eof() ) {
         seek( startpos );
         error( "couldn't find end of string, reached EOF." );
-    } else if( stream->fail() ) {
+    } else if( fail() ) {
         throw JsonError( "stream failure while reading string." );
     }
     throw JsonError( "something went wrong D:" );
@@ -1024,10 +1132,10 @@ double JsonIn::get_float()
     int e = 0;
     int mod_e = 0;
     eat_whitespace();
-    stream->get( ch );
+    ch = get_char();
     if( ch == '-' ) {
         neg = true;
-        stream->get( ch );
+        ch = get_char();
     } else if( ch != '.' && ( ch < '0' || ch > '9' ) ) {
         // not a valid float
         std::stringstream err;
@@ -1036,7 +1144,7 @@ double JsonIn::get_float()
     }
     if( ch == '0' ) {
         // allow a single leading zero in front of a '.' or 'e'/'E'
-        stream->get( ch );
+        ch = get_char();
         if( ch >= '0' && ch <= '9' ) {
             error( "leading zeros not strictly allowed", -1 );
         }
@@ -1044,40 +1152,40 @@ double JsonIn::get_float()
     while( ch >= '0' && ch <= '9' ) {
         i *= 10;
         i += ( ch - '0' );
-        stream->get( ch );
+        ch = get_char();
     }
     if( ch == '.' ) {
-        stream->get( ch );
+        ch = get_char();
         while( ch >= '0' && ch <= '9' ) {
             i *= 10;
             i += ( ch - '0' );
             mod_e -= 1;
-            stream->get( ch );
+            ch = get_char();
         }
     }
     if( neg ) {
         i *= -1;
     }
     if( ch == 'e' || ch == 'E' ) {
-        stream->get( ch );
+        ch = get_char();
         neg = false;
         if( ch == '-' ) {
             neg = true;
-            stream->get( ch );
+            ch = get_char();
         } else if( ch == '+' ) {
-            stream->get( ch );
+            ch = get_char();
         }
         while( ch >= '0' && ch <= '9' ) {
             e *= 10;
             e += ( ch - '0' );
-            stream->get( ch );
+            ch = get_char();
         }
         if( neg ) {
             e *= -1;
         }
     }
     // unget the final non-number character (probably a separator)
-    stream->unget();
+    unget_char();
     end_value();
     // now put it all together!
     return i * std::pow( 10.0f, e + mod_e );
@@ -1089,9 +1197,9 @@ bool JsonIn::get_bool()
     char text[5];
     std::stringstream err;
     eat_whitespace();
-    stream->get( ch );
+    ch = get_char();
     if( ch == 't' ) {
-        stream->get( text, 4 );
+        get_chars( text, 4 );
         if( strcmp( text, "rue" ) == 0 ) {
             end_value();
             return true;
@@ -1101,7 +1209,7 @@ bool JsonIn::get_bool()
             error( err.str(), -4 );
         }
     } else if( ch == 'f' ) {
-        stream->get( text, 5 );
+        get_chars( text, 5 );
         if( strcmp( text, "alse" ) == 0 ) {
             end_value();
             return false;
@@ -1129,7 +1237,7 @@ void JsonIn::start_array()
 {
     eat_whitespace();
     if( peek() == '[' ) {
-        stream->get();
+        get_char();
         ate_separator = false;
         return;
     } else {
@@ -1149,7 +1257,7 @@ bool JsonIn::end_array()
             uneat_whitespace();
             error( "separator not strictly allowed at end of array" );
         }
-        stream->get();
+        get_char();
         end_value();
         return true;
     } else {
@@ -1162,7 +1270,7 @@ void JsonIn::start_object()
 {
     eat_whitespace();
     if( peek() == '{' ) {
-        stream->get();
+        get_char();
         ate_separator = false; // not that we want to
         return;
     } else {
@@ -1182,7 +1290,7 @@ bool JsonIn::end_object()
             uneat_whitespace();
             error( "separator not strictly allowed at end of object" );
         }
-        stream->get();
+        get_char();
         end_value();
         return true;
     } else {
@@ -1394,9 +1502,9 @@ bool JsonIn::read( JsonDeserializer &j )
 // WARNING: for occasional use only.
 std::string JsonIn::line_number( int offset_modifier )
 {
-    if( stream->eof() ) {
+    if( eof() ) {
         return "EOF";
-    } else if( stream->fail() ) {
+    } else if( fail() ) {
         return "???";
     } // else stream is fine
     int pos = tell();
@@ -1405,12 +1513,12 @@ std::string JsonIn::line_number( int offset_modifier )
     char ch;
     seek( 0 );
     for( int i = 0; i < pos; ++i ) {
-        stream->get( ch );
+        ch = get_char();
         if( ch == '\r' ) {
             offset = 1;
             ++line;
             if( peek() == '\n' ) {
-                stream->get();
+                get_char();
                 ++i;
             }
         } else if( ch == '\n' ) {
@@ -1430,18 +1538,16 @@ void JsonIn::error( const std::string &message, int offset )
     std::ostringstream err;
     err << line_number( offset ) << ": " << message;
     // if we can't get more info from the stream don't try
-    if( !stream->good() ) {
+    if( !good() ) {
         throw JsonError( err.str() );
     }
     // also print surrounding few lines of context, if not too large
     err << "\n\n";
-    stream->seekg( offset, std::istream::cur );
+    seek_by( offset );
     size_t pos = tell();
     rewind( 3, 240 );
     size_t startpos = tell();
-    std::string buffer( pos - startpos, '\0' );
-    stream->read( &buffer[0], pos - startpos );
-    err << buffer;
+    err << substr( startpos, pos - startpos );
     if( !is_whitespace( peek() ) ) {
         err << peek();
     }
@@ -1455,10 +1561,10 @@ void JsonIn::error( const std::string &message, int offset )
     err << "^\n";
     seek( pos );
     // if that wasn't the end of the line, continue underneath pointer
-    char ch = stream->get();
+    char ch = get_char();
     if( ch == '\r' ) {
         if( peek() == '\n' ) {
-            stream->get();
+            get_char();
         }
     } else if( ch == '\n' ) {
         // pass
@@ -1470,12 +1576,12 @@ void JsonIn::error( const std::string &message, int offset )
     // print the next couple lines as well
     int line_count = 0;
     for( int i = 0; i < 240; ++i ) {
-        stream->get( ch );
+        ch = get_char();
         err << ch;
         if( ch == '\r' ) {
             ++line_count;
             if( peek() == '\n' ) {
-                err << stream->get();
+                err << get_char();
             }
         } else if( ch == '\n' ) {
             ++line_count;
@@ -1498,13 +1604,13 @@ void JsonIn::rewind( int max_lines, int max_chars )
         return;
     }
     int lines_found = 0;
-    stream->seekg( -1, std::istream::cur );
+    seek_by( -1 );
     for( int i = 0; i < max_chars; ++i ) {
         size_t tellpos = tell();
         if( peek() == '\n' ) {
             ++lines_found;
             if( tellpos > 0 ) {
-                stream->seekg( -1, std::istream::cur );
+                seek_by( -1 );
                 // note: does not update tellpos or count a character
                 if( peek() != '\r' ) {
                     continue;
@@ -1517,15 +1623,21 @@ void JsonIn::rewind( int max_lines, int max_chars )
             break;
         } else if( lines_found == max_lines ) {
             // don't include the last \n or \r
-            stream->seekg( 1, std::istream::cur );
+            seek_by( 1 );
             break;
         }
-        stream->seekg( -1, std::istream::cur );
+        seek_by( -1 );
     }
 }
 
 std::string JsonIn::substr( size_t pos, size_t len )
 {
+    if( !stream ) {
+        pos = std::min( pos, buffer_size );
+        len = std::min( len, buffer_size - pos );
+        buffer_pos = pos + len;
+        return std::string( buffer + pos, len );
+    }
     std::string ret;
     if( len == std::string::npos ) {
         stream->seekg( 0, std::istream::end );
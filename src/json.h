@@ -3,6 +3,7 @@
 #define JSON_H
 
 #include <cstddef>
+#include <cstdio>
 #include <type_traits>
 #include <iostream>
 #include <string>
@@ -11,6 +12,7 @@
 #include <array>
 #include <map>
 #include <set>
+#include <utility>
 #include <stdexcept>
 
 /* Cataclysm-DDA homegrown JSON tools
@@ -88,6 +90,8 @@ inline E string_to_enum_look_up( const C &container, const std::string &data )
  *
  * The JsonIn class provides a wrapper around a std::istream,
  * with methods for reading JSON data directly from the stream.
+ * It can also read straight from a buffer already held in memory,
+ * which avoids the per-character overhead of the stream.
  *
  * JsonObject and JsonArray provide higher-level wrappers,
  * and are a little easier to use in most cases,
@@ -166,15 +170,48 @@ inline E string_to_enum_look_up( const C &container, const std::string &data )
 class JsonIn
 {
     private:
-        std::istream *stream;
+        // Either stream is set, or the data is read from the buffer.
+        std::istream *stream = nullptr;
+        const char *buffer = nullptr;
+        size_t buffer_size = 0;
+        size_t buffer_pos = 0;
+        // Mirrors the eof state of a stream that has been read past its end.
+        bool buffer_eof = false;
         bool ate_separator = false;
 
         void skip_separator();
         void skip_pair_separator();
         void end_value();
 
+        // Character level access to whichever backend is in use.
+        int get_char() {
+            if( stream ) {
+                return stream->get();
+            }
+            if( buffer_pos < buffer_size ) {
+                return static_cast<unsigned char>( buffer[buffer_pos++] );
+            }
+            buffer_eof = true;
+            return EOF;
+        }
+        void unget_char() {
+            if( stream ) {
+                stream->unget();
+            } else if( !buffer_eof && buffer_pos > 0 ) {
+                --buffer_pos;
+            }
+        }
+        // like istream::get( char *, n ), reads up to n - 1 characters of the line
+        void get_chars( char *text, int n );
+        // moves relative to the current position
+        void seek_by( int offset );
+        bool eof();
+        bool fail();
+
     public:
         JsonIn( std::istream &s ) : stream( &s ) {}
+        /** Reads from the given memory, which must outlive the JsonIn. */
+        JsonIn( const char *data, size_t size ) : buffer( data ), buffer_size( size ) {}
         JsonIn( const JsonIn & ) = delete;
         JsonIn &operator=( const JsonIn & ) = delete;
 
@@ -187,7 +224,17 @@ class JsonIn
 
         int tell(); // get current stream position
         void seek( int pos ); // seek to specified stream position
-        char peek(); // what's the next char gonna be?
+        // what's the next char gonna be?
+        char peek() {
+            if( stream ) {
+                return static_cast<char>( stream->peek() );
+            }
+            if( buffer_pos < buffer_size ) {
+                return buffer[buffer_pos];
+            }
+            buffer_eof = true;
+            return static_cast<char>( EOF );
+        }
         bool good(); // whether stream is ok
 
         // advance seek head to the next non-whitespace character
@@ -647,22 +694,29 @@ class JsonOut
 class JsonObject
 {
     private:
-        std::map<std::string, int> positions;
+        // Value offset of each member, in the order they appear. Objects only
+        // have a handful of members, so a linear search beats a map.
+        std::vector<std::pair<std::string, int>> positions;
         int start;
         int end;
         bool final_separator;
         JsonIn *jsin;
+        // offset of the named member's value, 0 if there is none
+        int find_position( const std::string &name ) const;
         int verify_position( const std::string &name,
                              const bool throw_exception = true );
 
     public:
         JsonObject( JsonIn &jsin );
         JsonObject( const JsonObject &jsobj );
+        /** The moved from object no longer moves the stream when it is destroyed. */
+        JsonObject( JsonObject &&jsobj ) noexcept;
         JsonObject() : start( 0 ), end( 0 ), jsin( NULL ) {}
         ~JsonObject() {
             finish();
         }
         JsonObject &operator=( const JsonObject & );
+        JsonObject &operator=( JsonObject && ) noexcept;
 
         void finish(); // moves the stream to the end of the object
         size_t size();
@@ -734,7 +788,7 @@ class JsonObject
         // return true if the value was set, false otherwise.
         // return false if the member is not found.
         template <typename T> bool read( const std::string &name, T &t ) {
-            int pos = positions[name];
+            int pos = find_position( name );
             if( pos <= start ) {
                 return false;
             }
@@ -935,7 +989,7 @@ template <typename T>
 std::set<T> JsonObject::get_tags( const std::string &name )
 {
     std::set<T> res;
-    int pos = positions[ name ];
+    int pos = find_position( name );
     if( pos <= start ) {
         return res;
     }
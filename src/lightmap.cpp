@@ -6,6 +6,7 @@
 #include <cmath>
 #include <cstring>
 #include <list>
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -32,6 +33,7 @@
 #include "item.h"
 #include "line.h"
 #include "optional.h"
+#include "parallel.h"
 #include "player.h"
 #include "string_formatter.h"
 #include "tileray.h"
@@ -62,8 +64,8 @@ std::string four_quadrants::to_string() const
                           ( *this )[quadrant::SW], ( *this )[quadrant::NW] );
 }
 
-void map::add_light_from_items( const tripoint &p, std::list<item>::iterator begin,
-                                std::list<item>::iterator end )
+void map::add_light_from_items( const tripoint &p, item_stack::iterator begin,
+                                item_stack::iterator end )
 {
     for( auto itm_it = begin; itm_it != end; ++itm_it ) {
         float ilum = 0.0; // brightness
@@ -86,20 +88,18 @@ bool map::build_transparency_cache( const int zlev )
     auto &transparency_cache = map_cache.transparency_cache;
     auto &outside_cache = map_cache.outside_cache;
 
-    if( !map_cache.transparency_cache_dirty ) {
+    if( map_cache.transparency_cache_dirty.none() ) {
         return false;
     }
 
-    // Default to just barely not transparent.
-    std::uninitialized_fill_n(
-        &transparency_cache[0][0], MAPSIZE_X * MAPSIZE_Y,
-        static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR ) );
-
     const float sight_penalty = weather::sight_penalty( g->weather.weather );
 
-    // Traverse the submaps in order
+    // Traverse the submaps in order, skipping the ones that didn't change
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            if( !map_cache.transparency_cache_dirty[smx + smy * MAPSIZE] ) {
+                continue;
+            }
             const auto cur_submap = get_submap_at_grid( {smx, smy, zlev} );
 
             for( int sx = 0; sx < SEEX; ++sx ) {
@@ -108,6 +108,8 @@ bool map::build_transparency_cache( const int zlev )
                     const int y = sy + smy * SEEY;
 
                     auto &value = transparency_cache[x][y];
+                    // Default to just barely not transparent.
+                    value = LIGHT_TRANSPARENCY_OPEN_AIR;
 
                     if( !( cur_submap->ter[sx][sy].obj().transparent &&
                            cur_submap->frn[sx][sy].obj().transparent ) ) {
@@ -166,7 +168,7 @@ bool map::build_transparency_cache( const int zlev )
             }
         }
     }
-    map_cache.transparency_cache_dirty = false;
+    map_cache.transparency_cache_dirty.reset();
     return true;
 }
 
@@ -508,11 +510,13 @@ void map::generate_lightmap( const int zlev )
     */
     const tripoint cache_start( 0, 0, zlev );
     const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
+    std::vector<tripoint> bulk_sources;
     for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
         if( light_source_buffer[p.x][p.y] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x][p.y] );
+            bulk_sources.push_back( p );
         }
     }
+    apply_bulk_light_sources( zlev, bulk_sources );
 
     if( g->u.has_active_bionic( bionic_id( "bio_night" ) ) ) {
         for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
@@ -1174,12 +1178,9 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
     auto &map_cache = get_cache( target_z );
     float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.transparency_cache;
     float ( &seen_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.seen_cache;
-    float ( &camera_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.camera_cache;
 
     constexpr float light_transparency_solid = LIGHT_TRANSPARENCY_SOLID;
     constexpr int map_dimensions = MAPSIZE_X * MAPSIZE_Y;
-    std::uninitialized_fill_n(
-        &camera_cache[0][0], map_dimensions, light_transparency_solid );
 
     if( !fov_3d ) {
         std::uninitialized_fill_n(
@@ -1208,6 +1209,139 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
             seen_caches, transparency_caches, floor_caches, origin, 0, 1.0 );
     }
 
+    build_camera_cache( origin, target_z );
+}
+
+/**
+ * The octants of castLightAll, in the same order. Octant i covers the tiles
+ * origin + ( dx * xx + dy * xy, dx * yx + dy * yy ) with dy < 0 and dy <= dx <= 0.
+ */
+struct seen_octant {
+    int xx;
+    int xy;
+    int yx;
+    int yy;
+    void ( *cast )( float ( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
+                    const float ( &input_array )[MAPSIZE_X][MAPSIZE_Y],
+                    int offsetX, int offsetY, int offsetDistance, float numerator,
+                    int row, float start, float end, float cumulative_transparency );
+};
+
+template<int xx, int xy, int yx, int yy>
+static constexpr seen_octant make_seen_octant()
+{
+    return { xx, xy, yx, yy, castLight<xx, xy, yx, yy, float, float, sight_calc, sight_check, update_light, accumulate_transparency> };
+}
+
+static const std::array<seen_octant, 8> seen_octants = {{
+        make_seen_octant<0, 1, 1, 0>(), make_seen_octant<1, 0, 0, 1>(),
+        make_seen_octant < 0, -1, 1, 0 > (), make_seen_octant < -1, 0, 0, 1 > (),
+        make_seen_octant < 0, 1, -1, 0 > (), make_seen_octant < 1, 0, 0, -1 > (),
+        make_seen_octant < 0, -1, -1, 0 > (), make_seen_octant < -1, 0, 0, -1 > ()
+    }
+};
+
+// How far castLight reaches from the origin.
+static constexpr int seen_octant_radius = 60;
+
+/** Bit i is set if the offset from the origin lies in octant i (the origin itself is in none). */
+static int octants_containing( const int rx, const int ry )
+{
+    int result = 0;
+    for( size_t i = 0; i < seen_octants.size(); i++ ) {
+        const seen_octant &oct = seen_octants[i];
+        // The transformation is orthogonal, so its transpose is the inverse.
+        const int dx = rx * oct.xx + ry * oct.yx;
+        const int dy = rx * oct.xy + ry * oct.yy;
+        if( dy < 0 && dy >= -seen_octant_radius && dx <= 0 && dx >= dy ) {
+            result |= 1 << i;
+        }
+    }
+    return result;
+}
+
+void map::update_seen_cache( const tripoint &origin, const int target_z,
+                             const std::bitset<MAPSIZE *MAPSIZE> &changed_submaps )
+{
+    auto &map_cache = get_cache( target_z );
+    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.transparency_cache;
+    float ( &seen_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.seen_cache;
+
+    // The octants reaching into a changed submap. Unless the submap contains the origin,
+    // an octant overlapping it also contains some of its border tiles.
+    int changed = 0;
+    for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+        for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            if( !changed_submaps[smx + smy * MAPSIZE] ) {
+                continue;
+            }
+            const int minx = smx * SEEX - origin.x;
+            const int miny = smy * SEEY - origin.y;
+            const int maxx = minx + SEEX - 1;
+            const int maxy = miny + SEEY - 1;
+            if( minx <= 0 && maxx >= 0 && miny <= 0 && maxy >= 0 ) {
+                // The origin is inside, this touches every octant.
+                changed = ( 1 << seen_octants.size() ) - 1;
+                break;
+            }
+            for( int x = minx; x <= maxx; x++ ) {
+                changed |= octants_containing( x, miny ) | octants_containing( x, maxy );
+            }
+            for( int y = miny; y <= maxy; y++ ) {
+                changed |= octants_containing( minx, y ) | octants_containing( maxx, y );
+            }
+        }
+    }
+
+    // Tiles on the edge of an octant are shared with the neighboring octant, so those are
+    // cast again as well. They didn't change, so they only restore their share of the edge.
+    int recast = changed;
+    for( size_t i = 0; i < seen_octants.size(); i++ ) {
+        if( changed & ( 1 << i ) ) {
+            const seen_octant &oct = seen_octants[i];
+            // The edge tiles next to the origin: one on the axis, one on the diagonal.
+            recast |= octants_containing( -oct.xy, -oct.yy );
+            recast |= octants_containing( -oct.xx - oct.xy, -oct.yx - oct.yy );
+        }
+    }
+
+    for( size_t i = 0; i < seen_octants.size(); i++ ) {
+        if( !( changed & ( 1 << i ) ) ) {
+            continue;
+        }
+        const seen_octant &oct = seen_octants[i];
+        for( int distance = 1; distance <= seen_octant_radius; distance++ ) {
+            const int dy = -distance;
+            for( int dx = -distance; dx <= 0; dx++ ) {
+                const int x = origin.x + dx * oct.xx + dy * oct.xy;
+                const int y = origin.y + dx * oct.yx + dy * oct.yy;
+                if( x >= 0 && y >= 0 && x < MAPSIZE_X && y < MAPSIZE_Y ) {
+                    seen_cache[x][y] = LIGHT_TRANSPARENCY_SOLID;
+                }
+            }
+        }
+    }
+    for( size_t i = 0; i < seen_octants.size(); i++ ) {
+        if( recast & ( 1 << i ) ) {
+            seen_octants[i].cast( seen_cache, transparency_cache, origin.x, origin.y, 0, 1.0f,
+                                  1, 1.0f, 0.0f, LIGHT_TRANSPARENCY_OPEN_AIR );
+        }
+    }
+
+    build_camera_cache( origin, target_z );
+}
+
+void map::build_camera_cache( const tripoint &origin, const int target_z )
+{
+    auto &map_cache = get_cache( target_z );
+    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.transparency_cache;
+    float ( &seen_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.seen_cache;
+    float ( &camera_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.camera_cache;
+
+    constexpr float light_transparency_solid = LIGHT_TRANSPARENCY_SOLID;
+    std::uninitialized_fill_n(
+        &camera_cache[0][0], MAPSIZE_X * MAPSIZE_Y, light_transparency_solid );
+
     const optional_vpart_position vp = veh_at( origin );
     if( !vp ) {
         return;
@@ -1290,18 +1424,18 @@ static bool light_check( const float &transparency, const float &intensity )
     return transparency > LIGHT_TRANSPARENCY_SOLID && intensity > LIGHT_AMBIENT_LOW;
 }
 
-void map::apply_light_source( const tripoint &p, float luminance )
+/**
+ * Casts the light of a source at (x, y) into lm/sm. This only reads the transparency and the
+ * buffered bulk light sources, so several sources can be cast at the same time into separate
+ * lm/sm buffers.
+ */
+static void cast_light_source( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                               float ( &sm )[MAPSIZE_X][MAPSIZE_Y],
+                               const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y],
+                               const float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y],
+                               const int x, const int y, const bool inbounds, float luminance )
 {
-    auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
-    float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
-
-    const int x = p.x;
-    const int y = p.y;
-
-    if( inbounds( p ) ) {
+    if( inbounds ) {
         const float min_light = std::max( static_cast<float>( LL_LOW ), luminance );
         lm[x][y] = elementwise_max( lm[x][y], min_light );
         sm[x][y] = std::max( sm[x][y], luminance );
@@ -1371,6 +1505,65 @@ void map::apply_light_source( const tripoint &p, float luminance )
     }
 }
 
+void map::apply_light_source( const tripoint &p, float luminance )
+{
+    auto &cache = get_cache( p.z );
+    cast_light_source( cache.lm, cache.sm, cache.transparency_cache, cache.light_source_buffer,
+                       p.x, p.y, inbounds( p ), luminance );
+}
+
+/** Light cast by a share of the bulk light sources, merged into the level cache afterwards. */
+struct light_accumulator {
+    four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
+    float sm[MAPSIZE_X][MAPSIZE_Y];
+};
+
+// Below this many bulk light sources it isn't worth starting threads.
+static constexpr size_t min_bulk_sources_per_thread = 16;
+
+void map::apply_bulk_light_sources( const int zlev, const std::vector<tripoint> &sources )
+{
+    auto &cache = get_cache( zlev );
+    const size_t chunks = std::min<size_t>( cata::parallel_worker_count(),
+                                            sources.size() / min_bulk_sources_per_thread );
+    if( chunks < 2 ) {
+        for( const tripoint &p : sources ) {
+            apply_light_source( p, cache.light_source_buffer[p.x][p.y] );
+        }
+        return;
+    }
+
+    // Kept between calls, these are too big to allocate every turn.
+    static std::vector<std::unique_ptr<light_accumulator>> accumulators;
+    while( accumulators.size() < chunks ) {
+        accumulators.emplace_back( new light_accumulator() );
+    }
+
+    // Every chunk casts into its own buffers. Light only ever gets combined with max(),
+    // so merging the buffers gives exactly the same result as casting serially.
+    cata::parallel_for( chunks, [&]( const size_t chunk ) {
+        light_accumulator &acc = *accumulators[chunk];
+        std::memset( acc.lm, 0, sizeof( acc.lm ) );
+        std::memset( acc.sm, 0, sizeof( acc.sm ) );
+        for( size_t i = chunk; i < sources.size(); i += chunks ) {
+            const tripoint &p = sources[i];
+            cast_light_source( acc.lm, acc.sm, cache.transparency_cache, cache.light_source_buffer,
+                               p.x, p.y, inbounds( p ), cache.light_source_buffer[p.x][p.y] );
+        }
+    }, 1 );
+
+    // Merge column by column in parallel as well.
+    cata::parallel_for( MAPSIZE_X, [&]( const size_t x ) {
+        for( size_t chunk = 0; chunk < chunks; chunk++ ) {
+            const light_accumulator &acc = *accumulators[chunk];
+            for( int y = 0; y < MAPSIZE_Y; y++ ) {
+                cache.lm[x][y] = elementwise_max( cache.lm[x][y], acc.lm[x][y] );
+                cache.sm[x][y] = std::max( cache.sm[x][y], acc.sm[x][y] );
+            }
+        }
+    } );
+}
+
 void map::apply_directional_light( const tripoint &p, int direction, float luminance )
 {
     const int x = p.x;
@@ -2,6 +2,7 @@
 
 #include <climits>
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
@@ -47,6 +48,7 @@
 #include "options.h"
 #include "output.h"
 #include "overmapbuffer.h"
+#include "parallel.h"
 #include "pathfinding.h"
 #include "projectile.h"
 #include "rng.h"
@@ -97,12 +99,12 @@ const efftype_id effect_stunned( "stunned" );
 
 #define dbg(x) DebugLog((x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
 
-static std::list<item>  nulitems;          // Returned when &i_at() is asked for an OOB value
+static item_colony      nulitems;          // Returned when &i_at() is asked for an OOB value
 static field            nulfield;          // Returned when &field_at() is asked for an OOB value
 static level_cache      nullcache;         // Dummy cache for z-levels outside bounds
 
 // Map stack methods.
-std::list<item>::iterator map_stack::erase( std::list<item>::iterator it )
+map_stack::iterator map_stack::erase( map_stack::const_iterator it )
 {
     return myorigin->i_rem( location, it );
 }
@@ -112,8 +114,7 @@ void map_stack::push_back( const item &newitem )
     myorigin->add_item_or_charges( location, newitem );
 }
 
-void map_stack::insert_at( std::list<item>::iterator index,
-                           const item &newitem )
+void map_stack::insert_at( const_iterator index, const item &newitem )
 {
     myorigin->add_item_at( location, index, newitem );
 }
@@ -147,6 +148,8 @@ map::map( int mapsize, bool zlev )
     for( auto &ptr : pathfinding_caches ) {
         ptr = std::make_unique<pathfinding_cache>();
     }
+    routes = std::make_unique<route_cache>();
+    flow_fields = std::make_unique<flow_field_cache>();
 
     dbg( D_INFO ) << "map::map(): my_MAPSIZE: " << my_MAPSIZE << " z-levels enabled:" << zlevels;
     traplocs.resize( trap::count() );
@@ -1090,6 +1093,7 @@ vehicle *map::displace_vehicle( tripoint &p, const tripoint &dp )
         dst_submap->vehicles.push_back( std::move( *src_submap_veh_it ) );
         src_submap->vehicles.erase( src_submap_veh_it );
         dst_submap->is_uniform = false;
+        MAPBUFFER.note_vehicles( tripoint( abs_sub.x + veh->smx, abs_sub.y + veh->smy, veh->smz ) );
     }
 
     p = p2;
@@ -1268,7 +1272,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture )
     }
 
     if( old_t.transparent != new_t.transparent ) {
-        set_transparency_cache_dirty( p.z );
+        set_transparency_cache_dirty( p );
     }
 
     if( old_t.has_flag( TFLAG_INDOORS ) != new_t.has_flag( TFLAG_INDOORS ) ) {
@@ -1520,7 +1524,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     }
 
     if( old_t.transparent != new_t.transparent ) {
-        set_transparency_cache_dirty( p.z );
+        set_transparency_cache_dirty( p );
     }
 
     if( old_t.has_flag( TFLAG_INDOORS ) != new_t.has_flag( TFLAG_INDOORS ) ) {
@@ -4058,7 +4062,7 @@ map_stack map::i_at( const int x, const int y )
     return map_stack{ &current_submap->itm[l.x][l.y], tripoint( p, abs_sub.z ), this };
 }
 
-std::list<item>::iterator map::i_rem( const point &location, std::list<item>::iterator it )
+map_stack::iterator map::i_rem( const point &location, map_stack::const_iterator it )
 {
     return i_rem( tripoint( location, abs_sub.z ), it );
 }
@@ -4122,7 +4126,7 @@ map_stack map::i_at( const tripoint &p )
     return map_stack{ &current_submap->itm[l.x][l.y], p, this };
 }
 
-std::list<item>::iterator map::i_rem( const tripoint &p, std::list<item>::iterator it )
+map_stack::iterator map::i_rem( const tripoint &p, map_stack::const_iterator it )
 {
     point l;
     submap *const current_submap = get_submap_at( p, l );
@@ -4383,8 +4387,7 @@ item &map::add_item( const tripoint &p, item new_item )
     return add_item_at( p, current_submap->itm[l.x][l.y].end(), new_item );
 }
 
-item &map::add_item_at( const tripoint &p,
-                        std::list<item>::iterator index, item new_item )
+item &map::add_item_at( const tripoint &p, map_stack::const_iterator index, item new_item )
 {
     if( new_item.made_of( LIQUID ) && has_flag( "SWIMMABLE", p ) ) {
         return null_item_reference();
@@ -4407,7 +4410,7 @@ item &map::add_item_at( const tripoint &p,
     }
 
     current_submap->update_lum_add( l, new_item );
-    const auto new_pos = current_submap->itm[l.x][l.y].insert( index, new_item );
+    const auto new_pos = current_submap->itm[l.x][l.y].insert_before( index, new_item );
     if( new_item.needs_processing() ) {
         if( current_submap->active_items.empty() ) {
             submaps_with_active_items.insert( abs_sub + tripoint( p.x / SEEX, p.y / SEEY, p.z ) );
@@ -4516,7 +4519,7 @@ static bool item_is_in_activity( const item *it )
     } ) != targs->end();
 }
 
-static bool process_item( item_stack &items, std::list<item>::iterator &n, const tripoint &location,
+static bool process_item( item_stack &items, item_stack::iterator &n, const tripoint &location,
                           const bool activate, const float insulation, const temperature_flag flag )
 {
     if( !item_is_in_activity( &*n ) ) {
@@ -4543,7 +4546,7 @@ static bool process_item( item_stack &items, std::list<item>::iterator &n, const
     return false;
 }
 
-static bool process_map_items( item_stack &items, std::list<item>::iterator &n,
+static bool process_map_items( item_stack &items, item_stack::iterator &n,
                                const tripoint &location, const std::string &,
                                const float insulation, const temperature_flag flag )
 {
@@ -5134,7 +5137,7 @@ std::list<std::pair<tripoint, item *> > map::get_rc_items( int x, int y, int z )
     return rc_pairs;
 }
 
-static bool trigger_radio_item( item_stack &items, std::list<item>::iterator &n,
+static bool trigger_radio_item( item_stack &items, item_stack::iterator &n,
                                 const tripoint &pos, const std::string &signal,
                                 const float, const temperature_flag flag )
 {
@@ -5482,17 +5485,20 @@ bool map::add_field( const tripoint &p, const field_id type, int density, const
     if( current_submap->fld[l.x][l.y].add_field( type, density, age ) ) {
         //Only adding it to the count if it doesn't exist.
         current_submap->field_count++;
+        current_submap->note_field( l );
     }
 
     if( g != nullptr && this == &g->m && p == g->u.pos() ) {
         creature_in_field( g->u ); //Hit the player with the field if it spawned on top of them.
     }
 
+    const field_t &ft = all_field_types_enum_list[type];
     // Dirty the transparency cache now that field processing doesn't always do it
-    // TODO: Make it skip transparent fields
-    set_transparency_cache_dirty( p.z );
+    if( std::find( std::begin( ft.transparent ), std::end( ft.transparent ), false ) !=
+        std::end( ft.transparent ) ) {
+        set_transparency_cache_dirty( p );
+    }
 
-    const field_t &ft = all_field_types_enum_list[type];
     if( field_type_dangerous( type ) ) {
         set_pathfinding_cache_dirty( p.z );
     }
@@ -5520,7 +5526,7 @@ void map::remove_field( const tripoint &p, const field_id field_to_remove )
         const auto &fdata = all_field_types_enum_list[ field_to_remove ];
         for( bool i : fdata.transparent ) {
             if( !i ) {
-                set_transparency_cache_dirty( p.z );
+                set_transparency_cache_dirty( p );
                 break;
             }
         }
@@ -6787,12 +6793,84 @@ static void generate_uniform( const int x, const int y, const int z, const ter_i
     }
 }
 
-void map::loadn( const int gridx, const int gridy, const int gridz, const bool update_vehicles )
+/**
+ * Returns the submap at the absolute submap position @p abs_sm, loading it from
+ * disk or generating the overmap terrain it belongs to if needed.
+ */
+static submap *get_or_generate_submap( const tripoint &abs_sm )
 {
     // Cache empty overmap types
     static const oter_id rock( "empty_rock" );
     static const oter_id air( "open_air" );
 
+    submap *tmpsub = MAPBUFFER.lookup_submap( abs_sm );
+    if( tmpsub != nullptr ) {
+        return tmpsub;
+    }
+    // It doesn't exist; we must generate it!
+    dbg( D_INFO | D_WARNING ) << "map::loadn: Missing mapbuffer data. Regenerating.";
+
+    // Each overmap square is two nonants; to prevent overlap, generate only at
+    //  squares divisible by 2.
+    const int newmapx = abs_sm.x - ( abs( abs_sm.x ) % 2 );
+    const int newmapy = abs_sm.y - ( abs( abs_sm.y ) % 2 );
+    // Short-circuit if the map tile is uniform
+    int overx = newmapx;
+    int overy = newmapy;
+    sm_to_omt( overx, overy );
+
+    const oter_id terrain_type = overmap_buffer.ter( overx, overy, abs_sm.z );
+
+    // TODO: Replace with json mapgen functions.
+    if( terrain_type == air ) {
+        generate_uniform( newmapx, newmapy, abs_sm.z, t_open_air );
+    } else if( terrain_type == rock ) {
+        generate_uniform( newmapx, newmapy, abs_sm.z, t_rock );
+    } else {
+        tinymap tmp_map;
+        tmp_map.generate( newmapx, newmapy, abs_sm.z, calendar::turn );
+    }
+
+    // This is the same call to MAPBUFFER as above!
+    tmpsub = MAPBUFFER.lookup_submap( abs_sm );
+    if( tmpsub == nullptr ) {
+        dbg( D_ERROR ) << "failed to generate a submap at " << abs_sm.x << abs_sm.y << abs_sm.z;
+        debugmsg( "failed to generate a submap at %d,%d,%d", abs_sm.x, abs_sm.y, abs_sm.z );
+    }
+    return tmpsub;
+}
+
+void map::prefetch_shift( const int sx, const int sy, int generate )
+{
+    if( sx == 0 && sy == 0 ) {
+        return;
+    }
+    const int zmin = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
+    const int zmax = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
+    for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
+        for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
+            // Same test as in shift: these are the grid cells that get loaded anew.
+            if( gridx + sx >= 0 && gridx + sx < my_MAPSIZE &&
+                gridy + sy >= 0 && gridy + sy < my_MAPSIZE ) {
+                continue;
+            }
+            const int absx = abs_sub.x + sx + gridx;
+            const int absy = abs_sub.y + sy + gridy;
+            for( int gridz = zmin; gridz <= zmax; gridz++ ) {
+                MAPBUFFER.prefetch( tripoint( absx, absy, gridz ) );
+            }
+            // Mapgen is too expensive to do for all z-levels ahead of time.
+            const tripoint abs_sm( absx, absy, abs_sub.z );
+            if( generate > 0 && !MAPBUFFER.is_stored( abs_sm ) ) {
+                get_or_generate_submap( abs_sm );
+                generate--;
+            }
+        }
+    }
+}
+
+void map::loadn( const int gridx, const int gridy, const int gridz, const bool update_vehicles )
+{
     dbg( D_INFO ) << "map::loadn(game[" << g.get() << "], worldx[" << abs_sub.x
                   << "], worldy[" << abs_sub.y << "], gridx["
                   << gridx << "], gridy[" << gridy << "], gridz[" << gridz << "])";
@@ -6807,39 +6885,9 @@ void map::loadn( const int gridx, const int gridy, const int gridz, const bool u
     const int old_abs_z = abs_sub.z; // Ugly, but necessary at the moment
     abs_sub.z = gridz;
 
-    submap *tmpsub = MAPBUFFER.lookup_submap( absx, absy, gridz );
+    submap *tmpsub = get_or_generate_submap( tripoint( absx, absy, gridz ) );
     if( tmpsub == nullptr ) {
-        // It doesn't exist; we must generate it!
-        dbg( D_INFO | D_WARNING ) << "map::loadn: Missing mapbuffer data. Regenerating.";
-
-        // Each overmap square is two nonants; to prevent overlap, generate only at
-        //  squares divisible by 2.
-        const int newmapx = absx - ( abs( absx ) % 2 );
-        const int newmapy = absy - ( abs( absy ) % 2 );
-        // Short-circuit if the map tile is uniform
-        int overx = newmapx;
-        int overy = newmapy;
-        sm_to_omt( overx, overy );
-
-        const oter_id terrain_type = overmap_buffer.ter( overx, overy, gridz );
-
-        // TODO: Replace with json mapgen functions.
-        if( terrain_type == air ) {
-            generate_uniform( newmapx, newmapy, gridz, t_open_air );
-        } else if( terrain_type == rock ) {
-            generate_uniform( newmapx, newmapy, gridz, t_rock );
-        } else {
-            tinymap tmp_map;
-            tmp_map.generate( newmapx, newmapy, gridz, calendar::turn );
-        }
-
-        // This is the same call to MAPBUFFER as above!
-        tmpsub = MAPBUFFER.lookup_submap( absx, absy, gridz );
-        if( tmpsub == nullptr ) {
-            dbg( D_ERROR ) << "failed to generate a submap at " << absx << absy << abs_sub.z;
-            debugmsg( "failed to generate a submap at %d,%d,%d", absx, absy, abs_sub.z );
-            return;
-        }
+        return;
     }
 
     // New submap changes the content of the map and all caches must be recalculated
@@ -7735,6 +7783,7 @@ void map::build_outside_cache( const int zlev )
     if( zlev < 0 ) {
         std::uninitialized_fill_n(
             &outside_cache[0][0], ( MAPSIZE_X ) * ( MAPSIZE_Y ), false );
+        ch.outside_cache_dirty = false;
         return;
     }
 
@@ -7770,6 +7819,8 @@ void map::build_outside_cache( const int zlev )
     }
 
     ch.outside_cache_dirty = false;
+    // Transparency depends on being outside (weather)
+    ch.transparency_cache_dirty.set();
 }
 
 void map::build_obstacle_cache( const tripoint &start, const tripoint &end,
@@ -7929,25 +7980,70 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
+    const tripoint &p = g->u.pos();
+    // Initial value is illegal player position.
+    static tripoint player_prev_pos = tripoint_zero;
+    static int prev_zlev = 0;
+    if( player_prev_pos != p ) {
+        // The tile the player left may have been forced transparent below.
+        set_transparency_cache_dirty( player_prev_pos );
+    }
+
+    // Submaps of zlev whose transparency changes, when only those changed the seen cache
+    // can be updated instead of rebuilt.
+    std::bitset<MAPSIZE *MAPSIZE> changed_submaps;
+    std::array<bool, OVERMAP_LAYERS> transparency_rebuilt = {{}};
+    std::array<bool, OVERMAP_LAYERS> floor_rebuilt = {{}};
+    // The caches of each z-level only depend on the submaps of that level.
+    const auto build_level = [&]( const int z ) {
+        build_outside_cache( z );
+        if( z == zlev ) {
+            changed_submaps = get_cache( z ).transparency_cache_dirty;
+        }
+        transparency_rebuilt[z + OVERMAP_DEPTH] = build_transparency_cache( z );
+        floor_rebuilt[z + OVERMAP_DEPTH] = build_floor_cache( z );
+    };
+    int dirty_levels = 0;
+    for( int z = minz; z <= maxz; z++ ) {
+        const level_cache &ch = get_cache_ref( z );
+        if( ch.outside_cache_dirty || ch.transparency_cache_dirty.any() || ch.floor_cache_dirty ) {
+            dirty_levels++;
+        }
+    }
+    if( dirty_levels > 1 ) {
+        cata::parallel_for( maxz - minz + 1, [&]( const size_t i ) {
+            build_level( minz + static_cast<int>( i ) );
+        }, 1 );
+    } else {
+        for( int z = minz; z <= maxz; z++ ) {
+            build_level( z );
+        }
+    }
+
     bool seen_cache_dirty = false;
+    bool only_transparency_changed = !fov_3d && zlev == prev_zlev && player_prev_pos == p;
     for( int z = minz; z <= maxz; z++ ) {
-        build_outside_cache( z );
-        seen_cache_dirty |= build_transparency_cache( z );
-        seen_cache_dirty |= build_floor_cache( z );
+        seen_cache_dirty |= transparency_rebuilt[z + OVERMAP_DEPTH];
+        if( floor_rebuilt[z + OVERMAP_DEPTH] ) {
+            seen_cache_dirty = true;
+            only_transparency_changed = false;
+        }
         do_vehicle_caching( z );
     }
 
     // The tile player is standing on should always be transparent
-    const tripoint &p = g->u.pos();
     if( ( has_furn( p ) && !furn( p ).obj().transparent ) || !ter( p ).obj().transparent ) {
         get_cache( p.z ).transparency_cache[p.x][p.y] = LIGHT_TRANSPARENCY_CLEAR;
     }
 
-    // Initial value is illegal player position.
-    static tripoint player_prev_pos = tripoint_zero;
-    if( seen_cache_dirty || player_prev_pos != p ) {
-        build_seen_cache( g->u.pos(), zlev );
+    if( seen_cache_dirty || player_prev_pos != p || prev_zlev != zlev ) {
+        if( only_transparency_changed && !changed_submaps.all() ) {
+            update_seen_cache( p, zlev, changed_submaps );
+        } else {
+            build_seen_cache( p, zlev );
+        }
         player_prev_pos = p;
+        prev_zlev = zlev;
     }
     if( !skip_lightmap ) {
         generate_lightmap( zlev );
@@ -8507,7 +8603,7 @@ const level_cache &map::access_cache( int zlev ) const
 level_cache::level_cache()
 {
     const int map_dimensions = MAPSIZE_X * MAPSIZE_Y;
-    transparency_cache_dirty = true;
+    transparency_cache_dirty.set();
     outside_cache_dirty = true;
     floor_cache_dirty = false;
     constexpr four_quadrants four_zeros( 0.0f );
@@ -8516,7 +8612,8 @@ level_cache::level_cache()
     std::fill_n( &light_source_buffer[0][0], map_dimensions, 0.0f );
     std::fill_n( &outside_cache[0][0], map_dimensions, false );
     std::fill_n( &floor_cache[0][0], map_dimensions, false );
-    std::fill_n( &transparency_cache[0][0], map_dimensions, 0.0f );
+    std::fill_n( &transparency_cache[0][0], map_dimensions,
+                 static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR ) );
     std::fill_n( &seen_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &camera_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &visibility_cache[0][0], map_dimensions, LL_DARK );
@@ -8527,6 +8624,8 @@ level_cache::level_cache()
 pathfinding_cache::pathfinding_cache()
 {
     dirty = true;
+    regions_dirty = true;
+    generation = 0;
 }
 
 pathfinding_cache::~pathfinding_cache() = default;
@@ -8539,7 +8638,9 @@ pathfinding_cache &map::get_pathfinding_cache( int zlev ) const
 void map::set_pathfinding_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
-        get_pathfinding_cache( zlev ).dirty = true;
+        auto &cache = get_pathfinding_cache( zlev );
+        cache.dirty = true;
+        cache.generation++;
     }
 }
 
@@ -8626,6 +8727,7 @@ void map::update_pathfinding_cache( int zlev ) const
     }
 
     cache.dirty = false;
+    cache.regions_dirty = true;
 }
 
 void map::clip_to_bounds( tripoint &p ) const
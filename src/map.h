@@ -84,8 +84,14 @@ using VehicleList = std::vector<wrapped_vehicle>;
 using items_location = std::string;
 class map;
 
+enum pf_special : char;
 enum ter_bitflags : int;
+class route_cache;
+struct flow_field;
+struct flow_field_cache;
+struct pathfinder;
 struct pathfinding_cache;
+struct pathfinding_regions;
 struct pathfinding_settings;
 template<typename T>
 struct weighted_int_list;
@@ -96,11 +102,11 @@ class map_stack : public item_stack
         tripoint location;
         map *myorigin;
     public:
-        map_stack( std::list<item> *newstack, tripoint newloc, map *neworigin ) :
+        map_stack( item_colony *newstack, tripoint newloc, map *neworigin ) :
             item_stack( newstack ), location( newloc ), myorigin( neworigin ) {}
-        std::list<item>::iterator erase( std::list<item>::iterator it ) override;
+        iterator erase( const_iterator it ) override;
         void push_back( const item &newitem ) override;
-        void insert_at( std::list<item>::iterator index, const item &newitem ) override;
+        void insert_at( const_iterator index, const item &newitem ) override;
         int count_limit() const override {
             return MAX_ITEM_IN_SQUARE;
         }
@@ -147,7 +153,8 @@ struct level_cache {
     level_cache(); // Zeros all relevant values
     level_cache( const level_cache &other ) = default;
 
-    bool transparency_cache_dirty;
+    // Submaps (index x + y * MAPSIZE) whose transparency has to be rebuilt.
+    std::bitset<MAPSIZE *MAPSIZE> transparency_cache_dirty;
     bool outside_cache_dirty;
     bool floor_cache_dirty;
 
@@ -215,7 +222,14 @@ class map
         /*@{*/
         void set_transparency_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
-                get_cache( zlev ).transparency_cache_dirty = true;
+                get_cache( zlev ).transparency_cache_dirty.set();
+            }
+        }
+
+        /** Only the submap containing p needs its transparency rebuilt. */
+        void set_transparency_cache_dirty( const tripoint &p ) {
+            if( inbounds( p ) ) {
+                get_cache( p.z ).transparency_cache_dirty.set( p.x / SEEX + ( p.y / SEEY ) * MAPSIZE );
             }
         }
 
@@ -245,7 +259,7 @@ class map
             if( inbounds_z( zlev ) ) {
                 level_cache &ch = get_cache( zlev );
                 ch.floor_cache_dirty = true;
-                ch.transparency_cache_dirty = true;
+                ch.transparency_cache_dirty.set();
                 ch.outside_cache_dirty = true;
             }
         }
@@ -350,6 +364,12 @@ class map
          * Note: the map must have been loaded before this can be called.
          */
         void shift( const int sx, const int sy );
+        /**
+         * Prepares for a later call to shift( sx, sy ): starts reading the submaps
+         * that shift would load from disk in the background, and generates up to
+         * @p generate of those on the current z-level that have never been generated.
+         */
+        void prefetch_shift( int sx, int sy, int generate );
         /**
          * Moves the map vertically to (not by!) newz.
          * Does not actually shift anything, only forces cache updates.
@@ -511,6 +531,16 @@ class map
         std::vector<tripoint> route( const tripoint &f, const tripoint &t,
                                      const pathfinding_settings &settings,
         const std::set<tripoint> &pre_closed = {{ }} ) const;
+        /**
+         * Like @ref route, but the route is read from a distance field of the whole z-level
+         * towards `t`. The field is computed once and shared by all callers with the same
+         * destination and the same terrain handling in their settings (only the maximal
+         * distances may differ), until the terrain changes.
+         * This is much cheaper than many calls to @ref route when a crowd heads for the same
+         * destination. `f` and `t` must be on the same z-level.
+         */
+        std::vector<tripoint> flow_route( const tripoint &f, const tripoint &t,
+                                          const pathfinding_settings &settings ) const;
 
         // Vehicles: Common to 2D and 3D
         VehicleList get_vehicles();
@@ -896,7 +926,7 @@ class map
         // Items: 2D
         map_stack i_at( int x, int y );
         void i_clear( const int x, const int y );
-        std::list<item>::iterator i_rem( const point &location, std::list<item>::iterator it );
+        map_stack::iterator i_rem( const point &location, map_stack::const_iterator it );
         int i_rem( const int x, const int y, const int index );
         void i_rem( const int x, const int y, item *it );
         void spawn_item( const int x, const int y, const std::string &itype_id,
@@ -921,7 +951,7 @@ class map
         void i_clear( const tripoint &p );
         // i_rem() methods that return values act like container::erase(),
         // returning an iterator to the next item after removal.
-        std::list<item>::iterator i_rem( const tripoint &p, std::list<item>::iterator it );
+        map_stack::iterator i_rem( const tripoint &p, map_stack::const_iterator it );
         int i_rem( const tripoint &p, const int index );
         void i_rem( const tripoint &p, const item *it );
         void spawn_artifact( const tripoint &p );
@@ -944,7 +974,7 @@ class map
         item &add_item_or_charges( const tripoint &pos, item obj, bool overflow = true );
 
         /** Helper for map::add_item */
-        item &add_item_at( const tripoint &p, std::list<item>::iterator index, item new_item );
+        item &add_item_at( const tripoint &p, map_stack::const_iterator index, item new_item );
         /**
          * Place an item on the map, despite the parameter name, this is not necessarily a new item.
          * WARNING: does -not- check volume or stack charges. player functions (drop etc) should use
@@ -1465,6 +1495,7 @@ class map
 
         // Builds a transparency cache and returns true if the cache was invalidated.
         // Used to determine if seen cache should be rebuilt.
+        // Only the submaps marked in level_cache::transparency_cache_dirty are rebuilt.
         bool build_transparency_cache( int zlev );
         void build_sunlight_cache( int zlev );
     public:
@@ -1478,6 +1509,15 @@ class map
     protected:
         void generate_lightmap( int zlev );
         void build_seen_cache( const tripoint &origin, int target_z );
+        /**
+         * Updates a seen cache that was built from the same origin after the transparency
+         * of some submaps changed. Only the shadowcasting octants that reach into those
+         * submaps (and their neighbors, which share the boundary tiles) are cast again.
+         */
+        void update_seen_cache( const tripoint &origin, int target_z,
+                                const std::bitset<MAPSIZE *MAPSIZE> &changed_submaps );
+        /** Camera and mirror vision from inside a vehicle, needs an up to date seen cache. */
+        void build_camera_cache( const tripoint &origin, int target_z );
         void apply_character_light( player &p );
 
         int my_MAPSIZE;
@@ -1575,13 +1615,15 @@ class map
         // ...this, which will apply the light after at the end of generate_lightmap, and prevent redundant
         // light rays from causing massive slowdowns, if there's a huge amount of light.
         void add_light_source( const tripoint &p, float luminance );
+        // Applies the buffered light sources at the given points, spread over several threads.
+        void apply_bulk_light_sources( int zlev, const std::vector<tripoint> &sources );
         // Handle just cardinal directions and 45 deg angles.
         void apply_directional_light( const tripoint &p, int direction, float luminance );
         void apply_light_arc( const tripoint &p, int angle, float luminance, int wideangle = 30 );
         void apply_light_ray( bool lit[MAPSIZE_X][MAPSIZE_Y],
                               const tripoint &s, const tripoint &e, float luminance );
-        void add_light_from_items( const tripoint &p, std::list<item>::iterator begin,
-                                   std::list<item>::iterator end );
+        void add_light_from_items( const tripoint &p, item_stack::iterator begin,
+                                   item_stack::iterator end );
         std::unique_ptr<vehicle> add_vehicle_to_map( std::unique_ptr<vehicle> veh,
                 bool merge_wrecks );
 
@@ -1606,7 +1648,7 @@ class map
          * It's a really heinous function pointer so a typedef is the best
          * solution in this instance.
          */
-        using map_process_func = bool ( * )( item_stack &, std::list<item>::iterator &, const tripoint &,
+        using map_process_func = bool ( * )( item_stack &, item_stack::iterator &, const tripoint &,
                                              const std::string &, float, temperature_flag );
     private:
 
@@ -1661,6 +1703,10 @@ class map
         std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
+        /** Results of recent calls to @ref route. */
+        std::unique_ptr<route_cache> routes;
+        /** Distance fields used by @ref flow_route. */
+        std::unique_ptr<flow_field_cache> flow_fields;
         /**
          * Set of submaps that contain active items in absolute coordinates.
          */
@@ -1672,6 +1718,25 @@ class map
         }
 
         pathfinding_cache &get_pathfinding_cache( int zlev ) const;
+        /**
+         * The A* search of @ref route, within the area the workspace allows.
+         * Returns false if the area holds no path at all, true if the search found a path
+         * (stored in `ret`) or found that the path would be longer than allowed.
+         */
+        bool route_search( const tripoint &f, const tripoint &t, const pathfinding_settings &settings,
+                           const std::set<tripoint> &pre_closed, pathfinder &pf,
+                           std::vector<tripoint> &ret ) const;
+        /** Fills the distances of the field from its goal, see @ref flow_route. */
+        void compute_flow_field( flow_field &field ) const;
+        /**
+         * Cost of stepping onto `p` (whose pathfinding flags are `p_special`) for
+         * @ref route_search and @ref compute_flow_field, or one of the @ref pf_step values.
+         * Diagonal steps cost 1 more on top of this.
+         * @param from Where the step starts, nullptr if that isn't known. Doors that only
+         * open from the inside are then treated as closed.
+         */
+        int step_cost( const tripoint *from, const tripoint &p, pf_special p_special,
+                       const pathfinding_settings &settings ) const;
 
         visibility_variables visibility_variables_cache;
 
@@ -1681,6 +1746,8 @@ class map
         }
 
         const pathfinding_cache &get_pathfinding_cache_ref( int zlev ) const;
+        /** Coarse connectivity of the z-level, see @ref pathfinding_regions. No bounds check. */
+        const pathfinding_regions &get_pathfinding_regions( int zlev ) const;
 
         void update_pathfinding_cache( int zlev ) const;
 
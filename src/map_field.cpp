@@ -73,6 +73,55 @@ static const trait_id trait_ELECTRORECEPTORS( "ELECTRORECEPTORS" );
 static const trait_id trait_M_SKIN2( "M_SKIN2" );
 static const trait_id trait_M_SKIN3( "M_SKIN3" );
 
+namespace
+{
+/**
+ * The entry of one field type on a tile, looked up again on every access. Processing
+ * a field may add or remove other fields on the same tile, which moves the entries of
+ * that tile around, and may change the entry itself through the map.
+ * Once the entry is gone it reads as dead and ignores any changes.
+ */
+class tile_field_entry
+{
+    public:
+        tile_field_entry( field &fld, const field_id type ) : fld( fld ), type( type ) { }
+
+        field_id get_field_type() const {
+            return type;
+        }
+        int get_field_intensity() const {
+            const field_entry *const entry = fld.find_field( type );
+            return entry != nullptr ? entry->get_field_intensity() : 0;
+        }
+        void set_field_density( const int new_density ) {
+            if( field_entry *const entry = fld.find_field( type ) ) {
+                entry->set_field_density( new_density );
+            }
+        }
+        time_duration get_field_age() const {
+            const field_entry *const entry = fld.find_field( type );
+            return entry != nullptr ? entry->get_field_age() : 0_turns;
+        }
+        void set_field_age( const time_duration &new_age ) {
+            if( field_entry *const entry = fld.find_field( type ) ) {
+                entry->set_field_age( new_age );
+            }
+        }
+        bool is_field_alive() const {
+            field_entry *const entry = fld.find_field( type );
+            return entry != nullptr && entry->is_field_alive();
+        }
+        std::string name() const {
+            const field_entry *const entry = fld.find_field( type );
+            return entry != nullptr ? entry->name() : std::string();
+        }
+
+    private:
+        field &fld;
+        field_id type;
+};
+} // namespace
+
 void map::create_burnproducts( const tripoint &p, const item &fuel, const units::mass &burned_mass )
 {
     std::vector<material_id> all_mats = fuel.made_of();
@@ -106,27 +155,22 @@ bool map::process_fields()
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int z = minz; z <= maxz; z++ ) {
-        bool zlev_dirty = false;
         for( int x = 0; x < my_MAPSIZE; x++ ) {
             for( int y = 0; y < my_MAPSIZE; y++ ) {
                 submap *const current_submap = get_submap_at_grid( { x, y, z } );
-                if( current_submap->field_count > 0 ) {
-                    const bool cur_dirty = process_fields_in_submap( current_submap, x, y, z );
-                    zlev_dirty |= cur_dirty;
+                if( current_submap->field_count > 0 &&
+                    process_fields_in_submap( current_submap, x, y, z ) ) {
+                    // Some field that affects transparency changed.
+                    // Fields spread into the neighboring submaps as well.
+                    for( int dx = -1; dx <= 1; dx++ ) {
+                        for( int dy = -1; dy <= 1; dy++ ) {
+                            set_transparency_cache_dirty( tripoint( ( x + dx ) * SEEX, ( y + dy ) * SEEY, z ) );
+                        }
+                    }
+                    dirty_transparency_cache = true;
                 }
             }
         }
-
-        if( zlev_dirty ) {
-            // For now, just always dirty the transparency cache
-            // when a field might possibly be changed.
-            // TODO: check if there are any fields(mostly fire)
-            //       that frequently change, if so set the dirty
-            //       flag, otherwise only set the dirty flag if
-            //       something actually changed
-            set_transparency_cache_dirty( z );
-            dirty_transparency_cache = true;
-        }
     }
 
     return dirty_transparency_cache;
@@ -190,7 +234,7 @@ bool map::process_fields_in_submap( submap *const current_submap,
     };
 
     const auto spread_gas = [this, &get_neighbors](
-                                field_entry & cur, const tripoint & p, field_id curtype,
+                                tile_field_entry & cur, const tripoint & p, field_id curtype,
     int percent_spread, const time_duration & outdoor_age_speedup ) {
         const oter_id &cur_om_ter = overmap_buffer.ter( ms_to_omt_copy( g->m.getabs( p ) ) );
         bool sheltered = g->is_sheltered( p );
@@ -351,7 +395,13 @@ bool map::process_fields_in_submap( submap *const current_submap,
     size_t &locy = map_tile.y;
     //Loop through all tiles in this submap indicated by current_submap
     for( locx = 0; locx < SEEX; locx++ ) {
+        if( current_submap->field_tiles[locx] == 0 ) {
+            continue;
+        }
         for( locy = 0; locy < SEEY; locy++ ) {
+            if( !current_submap->may_have_field( point( locx, locy ) ) ) {
+                continue;
+            }
             // This is a translation from local coordinates to submap coordinates.
             // All submaps are in one long 1d array.
             thep.x = locx + submap_x * SEEX;
@@ -363,16 +413,18 @@ bool map::process_fields_in_submap( submap *const current_submap,
             field &curfield = current_submap->fld[locx][locy];
             for( auto it = curfield.begin(); it != curfield.end(); ) {
                 //Iterating through all field effects in the submap's field.
-                field_entry &cur = it->second;
                 // The field might have been killed by processing a neighbor field
-                if( !cur.is_field_alive() ) {
-                    if( !all_field_types_enum_list[cur.get_field_type()].transparent[cur.get_field_intensity() - 1] ) {
+                if( !it->second.is_field_alive() ) {
+                    const field_entry &dead = it->second;
+                    if( !all_field_types_enum_list[dead.get_field_type()].transparent[dead.get_field_intensity() - 1] ) {
                         dirty_transparency_cache = true;
                     }
                     current_submap->field_count--;
-                    curfield.remove_field( it++ );
+                    it = curfield.remove_field( it );
                     continue;
                 }
+                const field_id stored_type = it->first;
+                tile_field_entry cur( curfield, stored_type );
 
                 //Holds cur.get_field_type() as that is what the old system used before rewrite.
                 field_id curtype = cur.get_field_type();
@@ -1357,12 +1409,13 @@ bool map::process_fields_in_submap( submap *const current_submap,
                     cur.set_field_age( 0_turns );
                     cur.set_field_density( cur.get_field_intensity() - 1 );
                 }
-                if( !cur.is_field_alive() ) {
+                if( !cur.is_field_alive() && curfield.remove_field( stored_type ) ) {
                     current_submap->field_count--;
-                    curfield.remove_field( it++ );
-                } else {
-                    ++it;
                 }
+                it = curfield.upper_bound( stored_type );
+            }
+            if( curfield.field_count() == 0 ) {
+                current_submap->field_tiles[locx] &= ~( 1 << locy );
             }
         }
     }
@@ -1396,8 +1449,12 @@ void map::player_in_field( player &u )
     // Iterate through all field effects on this tile.
     // Do not remove the field with remove_field, instead set it's density to 0. It will be removed
     // later by the field processing, which will also adjust field_count accordingly.
-    for( auto &field_list_it : curfield ) {
-        field_entry &cur = field_list_it.second;
+    // The effects may add fields to this tile (e.g. blood), which moves the entries
+    // around, so each entry is looked up again by its type.
+    field_id type = fd_null;
+    for( auto it = curfield.begin(); it != curfield.end(); it = curfield.upper_bound( type ) ) {
+        type = it->first;
+        tile_field_entry cur( curfield, type );
         if( !cur.is_field_alive() ) {
             continue;
         }
@@ -1871,8 +1928,12 @@ void map::monster_in_field( monster &z )
     // Iterate through all field effects on this tile.
     // Do not remove the field with remove_field, instead set it's density to 0. It will be removed
     // later by the field processing, which will also adjust field_count accordingly.
-    for( auto &field_list_it : curfield ) {
-        field_entry &cur = field_list_it.second;
+    // The effects may add fields to this tile (e.g. blood), which moves the entries
+    // around, so each entry is looked up again by its type.
+    field_id type = fd_null;
+    for( auto it = curfield.begin(); it != curfield.end(); it = curfield.upper_bound( type ) ) {
+        type = it->first;
+        tile_field_entry cur( curfield, type );
         if( !cur.is_field_alive() ) {
             continue;
         }
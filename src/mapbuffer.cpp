@@ -2,13 +2,19 @@
 
 #include <sstream>
 #include <algorithm>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <set>
+#include <stdexcept>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "background_reader.h"
+#include "background_writer.h"
 #include "cata_utility.h"
 #include "computer.h"
 #include "coordinate_conversions.h"
@@ -18,6 +24,7 @@
 #include "json.h"
 #include "map.h"
 #include "mapdata.h"
+#include "options.h"
 #include "output.h"
 #include "submap.h"
 #include "translations.h"
@@ -51,15 +58,18 @@ void mapbuffer::reset()
         delete elem.second;
     }
     submaps.clear();
+    vehicle_submaps.clear();
+    background_reader::clear();
 }
 
 bool mapbuffer::add_submap( const tripoint &p, submap *sm )
 {
-    if( submaps.count( p ) != 0 ) {
+    if( !submaps.emplace( p, sm ).second ) {
         return false;
     }
-
-    submaps[p] = sm;
+    if( sm != nullptr && !sm->vehicles.empty() ) {
+        vehicle_submaps.insert( p );
+    }
 
     return true;
 }
@@ -84,14 +94,52 @@ bool mapbuffer::add_submap( int x, int y, int z, std::unique_ptr<submap> &sm )
 }
 
 void mapbuffer::remove_submap( tripoint addr )
+{
+    take_submap( addr );
+}
+
+std::unique_ptr<submap> mapbuffer::take_submap( const tripoint &addr )
 {
     auto m_target = submaps.find( addr );
     if( m_target == submaps.end() ) {
         debugmsg( "Tried to remove non-existing submap %d,%d,%d", addr.x, addr.y, addr.z );
-        return;
+        return nullptr;
     }
-    delete m_target->second;
+    std::unique_ptr<submap> result( m_target->second );
     submaps.erase( m_target );
+    vehicle_submaps.erase( addr );
+    return result;
+}
+
+submap *mapbuffer::find_submap( const tripoint &p ) const
+{
+    const auto iter = submaps.find( p );
+    return iter == submaps.end() ? nullptr : iter->second;
+}
+
+void mapbuffer::note_vehicles( const tripoint &p )
+{
+    vehicle_submaps.insert( p );
+}
+
+void mapbuffer::for_each_vehicle_submap( const std::function<void( const tripoint &, submap & )>
+        &fn )
+{
+    // Positions are noted eagerly and dropped here once their vehicles are gone.
+    std::vector<std::pair<tripoint, submap *>> found;
+    found.reserve( vehicle_submaps.size() );
+    for( auto iter = vehicle_submaps.begin(); iter != vehicle_submaps.end(); ) {
+        submap *sm = find_submap( *iter );
+        if( sm == nullptr || sm->vehicles.empty() ) {
+            iter = vehicle_submaps.erase( iter );
+        } else {
+            found.emplace_back( *iter, sm );
+            ++iter;
+        }
+    }
+    for( auto &elem : found ) {
+        fn( elem.first, *elem.second );
+    }
 }
 
 submap *mapbuffer::lookup_submap( int x, int y, int z )
@@ -116,8 +164,42 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
     return iter->second;
 }
 
-void mapbuffer::save( bool delete_after_save )
+/** The contents of a quad file with @p quad, in the format chosen by @p binary. */
+static std::string serialize_quad( const std::vector<std::pair<tripoint, const submap *>> &quad,
+                                   const bool binary )
+{
+    std::ostringstream fout;
+    if( binary ) {
+        serialize_submaps_binary( fout, quad );
+        return fout.str();
+    }
+    JsonOut jsout( fout );
+    jsout.start_array();
+    for( const auto &elem : quad ) {
+        jsout.start_object();
+
+        jsout.member( "version", savegame_version );
+        jsout.member( "coordinates" );
+
+        jsout.start_array();
+        jsout.write( elem.first.x );
+        jsout.write( elem.first.y );
+        jsout.write( elem.first.z );
+        jsout.end_array();
+
+        elem.second->store( jsout );
+
+        jsout.end_object();
+    }
+
+    jsout.end_array();
+    return fout.str();
+}
+
+void mapbuffer::save( bool delete_after_save, bool show_progress )
 {
+    // Saving replaces files, whatever was prefetched may be outdated.
+    background_reader::clear();
     std::stringstream map_directory;
     map_directory << g->get_world_base_save_path() << "/maps";
     assure_dir_exist( map_directory.str() );
@@ -131,9 +213,10 @@ void mapbuffer::save( bool delete_after_save )
     // A set of already-saved submaps, in global overmap coordinates.
     std::set<tripoint> saved_submaps;
     std::list<tripoint> submaps_to_delete;
+    std::vector<evicted_quad> quads_to_evict;
     int next_report = 0;
     for( auto &elem : submaps ) {
-        if( num_total_submaps > 100 && num_saved_submaps >= next_report ) {
+        if( show_progress && num_total_submaps > 100 && num_saved_submaps >= next_report ) {
             popup_nowait( _( "Please wait as the map saves [%d/%d]" ),
                           num_saved_submaps, num_total_submaps );
             next_report += std::max( 100, num_total_submaps / 20 );
@@ -165,7 +248,7 @@ void mapbuffer::save( bool delete_after_save )
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
         const bool zlev_del = !map_has_zlevels && om_addr.z != g->get_levz();
-        save_quad( dirname.str(), quad_path.str(), om_addr, submaps_to_delete,
+        save_quad( dirname.str(), quad_path.str(), om_addr, submaps_to_delete, quads_to_evict,
                    delete_after_save || zlev_del ||
                    om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
                    om_addr.x > map_origin.x + HALF_MAPSIZE ||
@@ -175,11 +258,27 @@ void mapbuffer::save( bool delete_after_save )
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
+    // Nothing uses the evicted submaps anymore, so they can be serialized on the
+    // writer thread instead of holding up the game. They are deleted there as well.
+    const bool binary = get_option<bool>( "BINARY_MAP_SAVES" );
+    for( evicted_quad &evicted : quads_to_evict ) {
+        std::shared_ptr<binary_submap_list> quad = std::make_shared<binary_submap_list>();
+        for( const tripoint &addr : evicted.submap_addrs ) {
+            quad->emplace_back( addr, take_submap( addr ) );
+        }
+        background_writer::write( evicted.path, [quad, binary]() {
+            std::vector<std::pair<tripoint, const submap *>> submaps;
+            for( const auto &elem : *quad ) {
+                submaps.emplace_back( elem.first, elem.second.get() );
+            }
+            return serialize_quad( submaps, binary );
+        } );
+    }
 }
 
 void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
                            const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                           bool delete_after_save )
+                           std::vector<evicted_quad> &quads_to_evict, bool delete_after_save )
 {
     std::vector<point> offsets;
     std::vector<tripoint> submap_addrs;
@@ -194,7 +293,8 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         submap_addr.x += offsets_offset.x;
         submap_addr.y += offsets_offset.y;
         submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr];
+        // Not operator[], inserting would invalidate the iteration in save().
+        const submap *sm = find_submap( submap_addr );
         if( sm != nullptr && !sm->is_uniform ) {
             all_uniform = false;
         }
@@ -204,7 +304,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         // Nothing to save - this quad will be regenerated faster than it would be re-read
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
-                if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
+                if( find_submap( submap_addr ) != nullptr ) {
                     submaps_to_delete.push_back( submap_addr );
                 }
             }
@@ -215,42 +315,58 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
 
     // Don't create the directory if it would be empty
     assure_dir_exist( dirname );
-    ofstream_wrapper_exclusive fout( filename );
-    JsonOut jsout( fout );
-    jsout.start_array();
+    std::vector<std::pair<tripoint, const submap *>> quad;
     for( auto &submap_addr : submap_addrs ) {
-        if( submaps.count( submap_addr ) == 0 ) {
-            continue;
+        const submap *sm = find_submap( submap_addr );
+        if( sm != nullptr ) {
+            quad.emplace_back( submap_addr, sm );
         }
-
-        submap *sm = submaps[submap_addr];
-
-        if( sm == nullptr ) {
-            continue;
+    }
+    if( delete_after_save ) {
+        // Serialized by the writer once save() has taken them out of the buffer.
+        evicted_quad evicted;
+        evicted.path = filename;
+        for( const auto &elem : quad ) {
+            evicted.submap_addrs.push_back( elem.first );
         }
+        quads_to_evict.push_back( evicted );
+        return;
+    }
+    background_writer::write( filename, serialize_quad( quad,
+                              get_option<bool>( "BINARY_MAP_SAVES" ) ) );
+}
 
-        jsout.start_object();
-
-        jsout.member( "version", savegame_version );
-        jsout.member( "coordinates" );
-
-        jsout.start_array();
-        jsout.write( submap_addr.x );
-        jsout.write( submap_addr.y );
-        jsout.write( submap_addr.z );
-        jsout.end_array();
-
-        sm->store( jsout );
-
-        jsout.end_object();
+/** Path of the file that stores the submap quad of the overmap terrain @p om_addr. */
+static std::string quad_file_path( const tripoint &om_addr )
+{
+    const tripoint segment_addr = omt_to_seg_copy( om_addr );
+    std::stringstream quad_path;
+    quad_path << g->get_world_base_save_path() << "/maps/" <<
+              segment_addr.x << "." << segment_addr.y << "." << segment_addr.z << "/" <<
+              om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
+    return quad_path.str();
+}
 
-        if( delete_after_save ) {
-            submaps_to_delete.push_back( submap_addr );
-        }
+void mapbuffer::prefetch( const tripoint &p )
+{
+    if( find_submap( p ) != nullptr ) {
+        return;
     }
+    const std::string quad_path = quad_file_path( sm_to_omt_copy( p ) );
+    // Loading it waits for the write anyway, and the file might still be the old one.
+    if( background_writer::is_pending( quad_path ) ) {
+        return;
+    }
+    background_reader::prefetch( quad_path );
+}
 
-    jsout.end_array();
-    fout.close();
+bool mapbuffer::is_stored( const tripoint &p ) const
+{
+    if( find_submap( p ) != nullptr ) {
+        return true;
+    }
+    const std::string quad_path = quad_file_path( sm_to_omt_copy( p ) );
+    return background_writer::is_pending( quad_path ) || file_exist( quad_path );
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -258,25 +374,39 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
 submap *mapbuffer::unserialize_submaps( const tripoint &p )
 {
     // Map the tripoint to the submap quad that stores it.
-    const tripoint om_addr = sm_to_omt_copy( p );
-    const tripoint segment_addr = omt_to_seg_copy( om_addr );
-    std::stringstream quad_path;
-    quad_path << g->get_world_base_save_path() << "/maps/" <<
-              segment_addr.x << "." << segment_addr.y << "." << segment_addr.z << "/" <<
-              om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
-
-    using namespace std::placeholders;
-    if( !read_from_file_optional_json( quad_path.str(),
-                                       std::bind( &mapbuffer::deserialize, this, _1 ) ) ) {
-        // If it doesn't exist, trigger generating it.
-        return nullptr;
+    const std::string quad_path = quad_file_path( sm_to_omt_copy( p ) );
+
+    // The quad might still be queued for writing, if it got evicted after an autosave.
+    background_writer::wait_for( quad_path );
+    cata::optional<std::string> data = background_reader::take( quad_path );
+    if( !data ) {
+        const auto reader = [&data]( std::istream & fin ) {
+            data = std::string( ( std::istreambuf_iterator<char>( fin ) ),
+                                std::istreambuf_iterator<char>() );
+        };
+        if( !read_from_file_optional( quad_path, reader ) ) {
+            // If it doesn't exist, trigger generating it.
+            return nullptr;
+        }
+    }
+    // Quads are written in either format, depending on the option at the time.
+    if( is_binary_submap_data( *data ) ) {
+        for( auto &loaded : deserialize_submaps_binary( *data ) ) {
+            if( !add_submap( loaded.first, loaded.second ) ) {
+                debugmsg( "submap %d,%d,%d was already loaded", loaded.first.x, loaded.first.y,
+                          loaded.first.z );
+            }
+        }
+    } else {
+        JsonIn jsin( data->data(), data->size() );
+        deserialize( jsin );
     }
-    if( submaps.count( p ) == 0 ) {
+    submap *const sm = find_submap( p );
+    if( sm == nullptr ) {
         debugmsg( "file %s did not contain the expected submap %d,%d,%d",
-                  quad_path.str(), p.x, p.y, p.z );
-        return nullptr;
+                  quad_path, p.x, p.y, p.z );
     }
-    return submaps[ p ];
+    return sm;
 }
 
 void mapbuffer::deserialize( JsonIn &jsin )
@@ -286,13 +416,12 @@ void mapbuffer::deserialize( JsonIn &jsin )
         std::unique_ptr<submap> sm = std::make_unique<submap>();
         tripoint submap_coordinates;
         jsin.start_object();
-        bool rubpow_update = false;
+        // Files without a version need no conversion.
+        int version = savegame_version;
         while( !jsin.end_object() ) {
             std::string submap_member_name = jsin.get_member_name();
             if( submap_member_name == "version" ) {
-                if( jsin.get_int() < 22 ) {
-                    rubpow_update = true;
-                }
+                version = jsin.get_int();
             } else if( submap_member_name == "coordinates" ) {
                 jsin.start_array();
                 int locx = jsin.get_int();
@@ -301,7 +430,7 @@ void mapbuffer::deserialize( JsonIn &jsin )
                 jsin.end_array();
                 submap_coordinates = tripoint( locx, locy, locz );
             } else {
-                sm->load( jsin, submap_member_name, rubpow_update );
+                sm->load( jsin, submap_member_name, version );
             }
         }
 
@@ -311,3 +440,299 @@ void mapbuffer::deserialize( JsonIn &jsin )
         }
     }
 }
+
+static const char binary_submap_magic[] = { 'C', 'D', 'D', 'A', 'M', 'A', 'P', '\0' };
+static constexpr uint32_t binary_submap_format_version = 1;
+
+namespace
+{
+/** Writes little endian integers, independent of the host byte order. */
+class binary_submap_writer
+{
+    public:
+        explicit binary_submap_writer( std::ostream &out ) : out( out ) { }
+
+        void write_u8( const uint8_t value ) {
+            out.put( static_cast<char>( value ) );
+        }
+        void write_u16( const uint16_t value ) {
+            write_u8( value & 0xff );
+            write_u8( value >> 8 );
+        }
+        void write_u32( const uint32_t value ) {
+            write_u16( value & 0xffff );
+            write_u16( value >> 16 );
+        }
+        void write_i32( const int32_t value ) {
+            write_u32( static_cast<uint32_t>( value ) );
+        }
+        void write_string( const std::string &str ) {
+            write_u32( str.size() );
+            out.write( str.data(), str.size() );
+        }
+        void write_raw( const char *data, const size_t size ) {
+            out.write( data, size );
+        }
+
+    private:
+        std::ostream &out;
+};
+
+class binary_submap_reader
+{
+    public:
+        explicit binary_submap_reader( const std::string &data ) : data( data ) { }
+
+        uint8_t read_u8() {
+            require( 1 );
+            return static_cast<uint8_t>( data[pos++] );
+        }
+        uint16_t read_u16() {
+            const uint16_t low = read_u8();
+            return low | ( read_u8() << 8 );
+        }
+        uint32_t read_u32() {
+            const uint32_t low = read_u16();
+            return low | ( static_cast<uint32_t>( read_u16() ) << 16 );
+        }
+        int32_t read_i32() {
+            return static_cast<int32_t>( read_u32() );
+        }
+        std::string read_string() {
+            const uint32_t size = read_u32();
+            require( size );
+            const size_t start = pos;
+            pos += size;
+            return data.substr( start, size );
+        }
+        /** Returns the position of @p size bytes that are skipped. */
+        size_t skip( const size_t size ) {
+            require( size );
+            const size_t start = pos;
+            pos += size;
+            return start;
+        }
+
+    private:
+        void require( const size_t size ) const {
+            if( data.size() - pos < size ) {
+                throw std::runtime_error( "binary map data is truncated" );
+            }
+        }
+
+        const std::string &data;
+        size_t pos = 0;
+};
+
+/** Strings used by the id layers of a quad, indexed in order of appearance. */
+class binary_submap_string_table
+{
+    public:
+        uint32_t index_of( const std::string &str ) {
+            const auto iter = indices.emplace( str, strings.size() );
+            if( iter.second ) {
+                strings.push_back( str );
+            }
+            return iter.first->second;
+        }
+
+        std::vector<std::string> strings;
+
+    private:
+        std::unordered_map<std::string, uint32_t> indices;
+};
+} // namespace
+
+/**
+ * Calls @p get_id for each tile in the order the JSON format uses, and
+ * writes runs of equal ids as run length and string table index.
+ */
+static void write_id_layer( binary_submap_writer &writer, binary_submap_string_table &table,
+                            const std::function<const std::string &( int, int )> &get_id )
+{
+    uint32_t last_index = 0;
+    uint16_t run = 0;
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            const uint32_t index = table.index_of( get_id( i, j ) );
+            if( run > 0 && index != last_index ) {
+                writer.write_u16( run );
+                writer.write_u32( last_index );
+                run = 0;
+            }
+            last_index = index;
+            run++;
+        }
+    }
+    writer.write_u16( run );
+    writer.write_u32( last_index );
+}
+
+/** Reads a layer written by @ref write_id_layer, calling @p set_id for each tile. */
+static void read_id_layer( binary_submap_reader &reader, const std::vector<std::string> &strings,
+                           const std::function<void( int, int, const std::string & )> &set_id )
+{
+    int cell = 0;
+    while( cell < SEEX * SEEY ) {
+        const uint16_t run = reader.read_u16();
+        const uint32_t index = reader.read_u32();
+        if( run == 0 || cell + run > SEEX * SEEY || index >= strings.size() ) {
+            throw std::runtime_error( "binary map layer is corrupt" );
+        }
+        for( int end = cell + run; cell < end; cell++ ) {
+            set_id( cell % SEEX, cell / SEEX, strings[index] );
+        }
+    }
+}
+
+static const std::string &ter_string( const submap &sm, const int i, const int j )
+{
+    return sm.ter[i][j].obj().id.str();
+}
+
+static const std::string &furn_string( const submap &sm, const int i, const int j )
+{
+    return sm.frn[i][j].obj().id.str();
+}
+
+static const std::string &trap_string( const submap &sm, const int i, const int j )
+{
+    return sm.trp[i][j].id().str();
+}
+
+void serialize_submaps_binary( std::ostream &out,
+                               const std::vector<std::pair<tripoint, const submap *>> &submaps )
+{
+    // The string table precedes the submaps, so collect it in a first pass
+    // instead of buffering the whole file.
+    binary_submap_string_table table;
+    for( const auto &elem : submaps ) {
+        const submap &sm = *elem.second;
+        for( int j = 0; j < SEEY; j++ ) {
+            for( int i = 0; i < SEEX; i++ ) {
+                table.index_of( ter_string( sm, i, j ) );
+                table.index_of( furn_string( sm, i, j ) );
+                table.index_of( trap_string( sm, i, j ) );
+            }
+        }
+    }
+
+    binary_submap_writer writer( out );
+    writer.write_raw( binary_submap_magic, sizeof( binary_submap_magic ) );
+    writer.write_u32( binary_submap_format_version );
+    writer.write_i32( savegame_version );
+    writer.write_u32( table.strings.size() );
+    for( const std::string &str : table.strings ) {
+        writer.write_string( str );
+    }
+
+    writer.write_u32( submaps.size() );
+    for( const auto &elem : submaps ) {
+        const submap &sm = *elem.second;
+        writer.write_i32( elem.first.x );
+        writer.write_i32( elem.first.y );
+        writer.write_i32( elem.first.z );
+        write_id_layer( writer, table, [&sm]( int i, int j ) -> const std::string & {
+            return ter_string( sm, i, j );
+        } );
+        write_id_layer( writer, table, [&sm]( int i, int j ) -> const std::string & {
+            return furn_string( sm, i, j );
+        } );
+        write_id_layer( writer, table, [&sm]( int i, int j ) -> const std::string & {
+            return trap_string( sm, i, j );
+        } );
+
+        int last_rad = 0;
+        uint16_t run = 0;
+        for( int j = 0; j < SEEY; j++ ) {
+            for( int i = 0; i < SEEX; i++ ) {
+                const int rad = sm.rad[i][j];
+                if( run > 0 && rad != last_rad ) {
+                    writer.write_u16( run );
+                    writer.write_i32( last_rad );
+                    run = 0;
+                }
+                last_rad = rad;
+                run++;
+            }
+        }
+        writer.write_u16( run );
+        writer.write_i32( last_rad );
+
+        std::ostringstream contents;
+        JsonOut jsout( contents );
+        jsout.start_object();
+        sm.store_contents( jsout );
+        jsout.end_object();
+        writer.write_string( contents.str() );
+    }
+}
+
+bool is_binary_submap_data( const std::string &data )
+{
+    return data.compare( 0, sizeof( binary_submap_magic ),
+                         std::string( binary_submap_magic, sizeof( binary_submap_magic ) ) ) == 0;
+}
+
+binary_submap_list deserialize_submaps_binary( const std::string &data )
+{
+    if( !is_binary_submap_data( data ) ) {
+        throw std::runtime_error( "not a binary map file" );
+    }
+    binary_submap_reader reader( data );
+    reader.skip( sizeof( binary_submap_magic ) );
+    const uint32_t format_version = reader.read_u32();
+    if( format_version != binary_submap_format_version ) {
+        throw std::runtime_error( string_format( "unsupported binary map format version %d",
+                                  format_version ) );
+    }
+    // The savegame version of the contents, all layer conversions predate this format.
+    const int version = reader.read_i32();
+
+    std::vector<std::string> strings( reader.read_u32() );
+    for( std::string &str : strings ) {
+        str = reader.read_string();
+    }
+
+    binary_submap_list result;
+    const uint32_t count = reader.read_u32();
+    for( uint32_t n = 0; n < count; n++ ) {
+        std::unique_ptr<submap> sm = std::make_unique<submap>();
+        tripoint pos;
+        pos.x = reader.read_i32();
+        pos.y = reader.read_i32();
+        pos.z = reader.read_i32();
+        submap &s = *sm;
+        read_id_layer( reader, strings, [&s]( int i, int j, const std::string & id ) {
+            s.ter[i][j] = ter_str_id( id ).id();
+        } );
+        read_id_layer( reader, strings, [&s]( int i, int j, const std::string & id ) {
+            s.frn[i][j] = furn_str_id( id ).id();
+        } );
+        read_id_layer( reader, strings, [&s]( int i, int j, const std::string & id ) {
+            s.trp[i][j] = trap_str_id( id ).id();
+        } );
+
+        int cell = 0;
+        while( cell < SEEX * SEEY ) {
+            const uint16_t run = reader.read_u16();
+            const int rad = reader.read_i32();
+            if( run == 0 || cell + run > SEEX * SEEY ) {
+                throw std::runtime_error( "binary map radiation is corrupt" );
+            }
+            for( int end = cell + run; cell < end; cell++ ) {
+                s.rad[cell % SEEX][cell / SEEX] = rad;
+            }
+        }
+
+        const uint32_t contents_size = reader.read_u32();
+        const size_t contents_pos = reader.skip( contents_size );
+        JsonIn jsin( data.data() + contents_pos, contents_size );
+        jsin.start_object();
+        while( !jsin.end_object() ) {
+            s.load( jsin, jsin.get_member_name(), version );
+        }
+        result.emplace_back( pos, std::move( sm ) );
+    }
+    return result;
+}
@@ -2,10 +2,15 @@
 #ifndef MAPBUFFER_H
 #define MAPBUFFER_H
 
+#include <functional>
+#include <iosfwd>
 #include <list>
-#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "enums.h"
 
@@ -22,10 +27,14 @@ class mapbuffer
         ~mapbuffer();
 
         /** Store all submaps in this instance into savefiles.
+         * The files are written by the @ref background_writer, call
+         * @ref background_writer::wait to make sure they are on disk.
+         * Submaps that are removed are serialized by the writer as well.
          * @param delete_after_save If true, the saved submaps are removed
          * from the mapbuffer (and deleted).
+         * @param show_progress Whether to show a popup while saving many submaps.
          **/
-        void save( bool delete_after_save = false );
+        void save( bool delete_after_save = false, bool show_progress = true );
 
         /** Delete all buffered submaps. **/
         void reset();
@@ -56,9 +65,33 @@ class mapbuffer
          */
         submap *lookup_submap( int x, int y, int z );
         submap *lookup_submap( const tripoint &p );
+        /**
+         * Starts reading the file with the submap at @p p (same coordinates as in
+         * @ref lookup_submap) on a worker thread (see @ref background_reader), so that
+         * loading it later does not have to wait for the disk.
+         * Does nothing if the submap is in this buffer already.
+         */
+        void prefetch( const tripoint &p );
+        /**
+         * Whether the submap at @p p is in this buffer or has been saved, i.e.
+         * whether @ref lookup_submap would find it without generating it.
+         */
+        bool is_stored( const tripoint &p ) const;
+
+        /**
+         * Notes that vehicles have been placed on the submap at @p p, which
+         * is already in this buffer. Submaps added with vehicles on them are
+         * noted automatically.
+         */
+        void note_vehicles( const tripoint &p );
+        /**
+         * Calls @p fn for each submap in this buffer that has vehicles on it,
+         * ordered by position, without visiting all the other submaps.
+         */
+        void for_each_vehicle_submap( const std::function<void( const tripoint &, submap & )> &fn );
 
     private:
-        using submap_map_t = std::map<tripoint, submap *>;
+        using submap_map_t = std::unordered_map<tripoint, submap *>;
 
     public:
         inline submap_map_t::iterator begin() {
@@ -72,14 +105,45 @@ class mapbuffer
         // There's a very good reason this is private,
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
+        /** Removes the submap at @p addr from the buffer without deleting it. */
+        std::unique_ptr<submap> take_submap( const tripoint &addr );
+        /** Like @ref lookup_submap, but never loads the submap from disk. */
+        submap *find_submap( const tripoint &p ) const;
         submap *unserialize_submaps( const tripoint &p );
         void deserialize( JsonIn &jsin );
+        /** A quad that is saved and removed from the buffer. */
+        struct evicted_quad {
+            std::string path;
+            std::vector<tripoint> submap_addrs;
+        };
         void save_quad( const std::string &dirname, const std::string &filename,
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                        bool delete_after_save );
+                        std::vector<evicted_quad> &quads_to_evict, bool delete_after_save );
         submap_map_t submaps;
+        /**
+         * Positions of the submaps that might have vehicles on them,
+         * a superset that @ref for_each_vehicle_submap prunes.
+         */
+        std::set<tripoint> vehicle_submaps;
 };
 
 extern mapbuffer MAPBUFFER;
 
+/**
+ * Binary quad files, an alternative to the JSON written by @ref submap::store.
+ * After a version header comes a table of all terrain, furniture and trap ids
+ * used in the file. Each submap then stores those three layers run-length
+ * encoded as indices into that table, the radiation layer run-length encoded,
+ * and everything else as compact JSON from @ref submap::store_contents.
+ */
+/**@{*/
+using binary_submap_list = std::vector<std::pair<tripoint, std::unique_ptr<submap>>>;
+void serialize_submaps_binary( std::ostream &out,
+                               const std::vector<std::pair<tripoint, const submap *>> &submaps );
+/** @throw std::exception if the data is not a valid binary quad file. */
+binary_submap_list deserialize_submaps_binary( const std::string &data );
+/** Whether the file contents start with the binary format header rather than JSON. */
+bool is_binary_submap_data( const std::string &data );
+/**@}*/
+
 #endif
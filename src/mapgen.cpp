@@ -30,6 +30,7 @@
 #include "map.h"
 #include "map_extras.h"
 #include "map_iterator.h"
+#include "mapbuffer.h"
 #include "mapdata.h"
 #include "mapgen_functions.h"
 #include "mapgenformat.h"
@@ -7104,6 +7105,8 @@ vehicle *map::add_vehicle( const vproto_id &type, const tripoint &p, const int d
         submap *place_on_submap = get_submap_at_grid( { placed_vehicle->smx, placed_vehicle->smy, placed_vehicle->smz} );
         place_on_submap->vehicles.push_back( std::move( placed_vehicle_up ) );
         place_on_submap->is_uniform = false;
+        MAPBUFFER.note_vehicles( tripoint( abs_sub.x + placed_vehicle->smx,
+                                           abs_sub.y + placed_vehicle->smy, placed_vehicle->smz ) );
 
         auto &ch = get_cache( placed_vehicle->smz );
         ch.vehicle_list.insert( placed_vehicle );
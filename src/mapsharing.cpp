@@ -1,6 +1,7 @@
 #include "mapsharing.h"
 
 #include <cstdlib>
+#include <mutex>
 
 #if defined(__linux__)
 #include <sys/file.h>
@@ -134,13 +135,19 @@ void releaseLock( int fd, const char *lockName )
 #endif // __linux__
 
 std::map<std::string, int> lockFiles;
+// Save files are also written by the background writer thread.
+static std::mutex lockFiles_mutex;
 
 void fopen_exclusive( std::ofstream &fout, const char *filename,
                       std::ios_base::openmode mode )  // TODO: put this in an ofstream_exclusive class?
 {
     std::string lockfile = std::string( filename ) + ".lock";
-    lockFiles[lockfile] = getLock( lockfile.c_str() );
-    if( lockFiles[lockfile] != -1 ) {
+    const int fd = getLock( lockfile.c_str() );
+    {
+        std::lock_guard<std::mutex> lock( lockFiles_mutex );
+        lockFiles[lockfile] = fd;
+    }
+    if( fd != -1 ) {
         fout.open( filename, mode );
     }
 }
@@ -149,6 +156,11 @@ void fclose_exclusive( std::ofstream &fout, const char *filename )
 {
     std::string lockFile = std::string( filename ) + ".lock";
     fout.close();
-    releaseLock( lockFiles[lockFile], lockFile.c_str() );
-    lockFiles[lockFile] = -1;
+    int fd;
+    {
+        std::lock_guard<std::mutex> lock( lockFiles_mutex );
+        fd = lockFiles[lockFile];
+        lockFiles[lockFile] = -1;
+    }
+    releaseLock( fd, lockFile.c_str() );
 }
@@ -99,8 +99,14 @@ struct mongroup {
      *  and return to them whenever possible.
      *  And "roam", who roam around the map randomly, not taking care to return
      *  anywhere.
+     *  Hordes that have not moved yet have none, and pick one when they first move.
      */
-    std::string horde_behaviour;
+    enum class behaviour : int {
+        none,
+        city,
+        roam,
+    };
+    behaviour horde_behaviour = behaviour::none;
     bool diffuse = false;   // group size ind. of dist. from center and radius invariant
     mongroup( const mongroup_id &ptype, int pposx, int pposy, int pposz,
               unsigned int prad, unsigned int ppop )
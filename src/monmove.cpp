@@ -21,6 +21,7 @@
 #include "monfaction.h"
 #include "mtype.h"
 #include "npc.h"
+#include "options.h"
 #include "rng.h"
 #include "scent_map.h"
 #include "sounds.h"
@@ -217,25 +218,23 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
     return INT_MAX;
 }
 
-void monster::plan( const mfactions &factions )
+monster::target_selection monster::find_target( const mfactions &factions ) const
 {
     // Bots are more intelligent than most living stuff
     bool smart_planning = has_flag( MF_PRIORITIZE_TARGETS );
-    Creature *target = nullptr;
+    target_selection result;
+    Creature *&target = result.target;
     // 8.6f is rating for tank drone 60 tiles away, moose 16 or boomer 33
-    float dist = !smart_planning ? 1000 : 8.6f;
-    bool fleeing = false;
+    float &dist = result.dist;
+    dist = !smart_planning ? 1000 : 8.6f;
+    bool &fleeing = result.fleeing;
     bool docile = friendly != 0 && has_effect( effect_docile );
 
-    const bool angers_hostile_weak = type->has_anger_trigger( mon_trigger::HOSTILE_WEAK );
     const int angers_hostile_near = type->has_anger_trigger( mon_trigger::HOSTILE_CLOSE ) ? 5 : 0;
     const int angers_mating_season = type->has_anger_trigger( mon_trigger::MATING_SEASON ) ? 3 : 0;
     const int angers_cub_threatened = type->has_anger_trigger( mon_trigger::PLAYER_NEAR_BABY ) ? 8 : 0;
     const int fears_hostile_near = type->has_fear_trigger( mon_trigger::HOSTILE_CLOSE ) ? 5 : 0;
 
-    auto all_monsters = g->all_monsters();
-    bool group_morale = has_flag( MF_GROUP_MORALE ) && morale < type->morale;
-    bool swarms = has_flag( MF_SWARMS );
     auto mood = attitude();
 
     // If we can see the player, move toward them or flee, simpleminded animals are too dumb to follow the player.
@@ -244,8 +243,8 @@ void monster::plan( const mfactions &factions )
         fleeing = fleeing || is_fleeing( g->u );
         target = &g->u;
         if( dist <= 5 ) {
-            anger += angers_hostile_near;
-            morale -= fears_hostile_near;
+            result.anger += angers_hostile_near;
+            result.morale -= fears_hostile_near;
             if( angers_mating_season > 0 ) {
                 bool mating_angry = false;
                 season_type season = season_of_year( calendar::turn );
@@ -259,25 +258,25 @@ void monster::plan( const mfactions &factions )
                     }
                 }
                 if( mating_angry ) {
-                    anger += angers_mating_season;
+                    result.anger += angers_mating_season;
                 }
             }
         }
         if( angers_cub_threatened > 0 ) {
-            for( monster &tmp : all_monsters ) {
+            for( monster &tmp : g->all_monsters() ) {
                 if( type->baby_monster == tmp.type->id ) {
                     // baby nearby; is the player too close?
                     dist = tmp.rate_target( g->u, dist, smart_planning );
                     if( dist <= 3 ) {
                         //proximity to baby; monster gets furious and less likely to flee
-                        anger += angers_cub_threatened;
-                        morale += angers_cub_threatened / 2;
+                        result.anger += angers_cub_threatened;
+                        result.morale += angers_cub_threatened / 2;
                     }
                 }
             }
         }
     } else if( friendly != 0 && !docile ) {
-        for( monster &tmp : all_monsters ) {
+        for( monster &tmp : g->all_monsters() ) {
             if( tmp.friendly == 0 ) {
                 float rating = rate_target( tmp, dist, smart_planning );
                 if( rating < dist ) {
@@ -289,11 +288,7 @@ void monster::plan( const mfactions &factions )
     }
 
     if( docile ) {
-        if( friendly != 0 && target != nullptr ) {
-            set_dest( target->pos() );
-        }
-
-        return;
+        return result;
     }
 
     for( npc &who : g->all_npcs() ) {
@@ -313,8 +308,8 @@ void monster::plan( const mfactions &factions )
         }
         fleeing = fleeing || fleeing_from;
         if( rating <= 5 ) {
-            anger += angers_hostile_near;
-            morale -= fears_hostile_near;
+            result.anger += angers_hostile_near;
+            result.morale -= fears_hostile_near;
             if( angers_mating_season > 0 ) {
                 bool mating_angry = false;
                 season_type season = season_of_year( calendar::turn );
@@ -328,7 +323,7 @@ void monster::plan( const mfactions &factions )
                     }
                 }
                 if( mating_angry ) {
-                    anger += angers_mating_season;
+                    result.anger += angers_mating_season;
                 }
             }
         }
@@ -350,13 +345,45 @@ void monster::plan( const mfactions &factions )
                     dist = rating;
                 }
                 if( rating <= 5 ) {
-                    anger += angers_hostile_near;
-                    morale -= fears_hostile_near;
+                    result.anger += angers_hostile_near;
+                    result.morale -= fears_hostile_near;
                 }
             }
         }
     }
 
+    return result;
+}
+
+void monster::plan( const mfactions &factions )
+{
+    plan( factions, find_target( factions ) );
+}
+
+void monster::plan( const mfactions &factions, const target_selection &selection )
+{
+    bool smart_planning = has_flag( MF_PRIORITIZE_TARGETS );
+    Creature *target = selection.target;
+    float dist = selection.dist;
+    bool fleeing = selection.fleeing;
+    bool docile = friendly != 0 && has_effect( effect_docile );
+
+    const bool angers_hostile_weak = type->has_anger_trigger( mon_trigger::HOSTILE_WEAK );
+
+    bool group_morale = has_flag( MF_GROUP_MORALE ) && morale < type->morale;
+    bool swarms = has_flag( MF_SWARMS );
+
+    anger += selection.anger;
+    morale += selection.morale;
+
+    if( docile ) {
+        if( friendly != 0 && target != nullptr ) {
+            set_dest( target->pos() );
+        }
+
+        return;
+    }
+
     // Friendly monsters here
     // Avoid for hordes of same-faction stuff or it could get expensive
     const auto actual_faction = friendly == 0 ? faction : mfaction_str_id( "player" );
@@ -702,7 +729,13 @@ void monster::move()
         if( pf_settings.max_dist >= rl_dist( pos(), goal ) &&
             ( path.empty() || rl_dist( pos(), path.front() ) >= 2 || path.back() != goal ) ) {
             // We need a new path
-            path = g->m.route( pos(), goal, pf_settings, get_path_avoid() );
+            static const option_handle<bool> flow_fields( "MONSTER_FLOW_FIELDS" );
+            if( flow_fields.get() && goal.z == posz() ) {
+                // Monsters heading for the same spot share one distance field
+                path = g->m.flow_route( pos(), goal, pf_settings );
+            } else {
+                path = g->m.route( pos(), goal, pf_settings, get_path_avoid() );
+            }
         }
 
         // Try to respect old paths, even if we can't pathfind at the moment
@@ -284,7 +284,8 @@ void monster::poly( const mtype_id &id )
 
 bool monster::can_upgrade()
 {
-    return upgrades && get_option<float>( "MONSTER_UPGRADE_FACTOR" ) > 0.0;
+    static const option_handle<float> upgrade_factor( "MONSTER_UPGRADE_FACTOR" );
+    return upgrades && upgrade_factor.get() > 0.0;
 }
 
 // For master special attack.
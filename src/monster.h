@@ -192,9 +192,26 @@ class monster : public Creature
 
         // How good of a target is given creature (checks for visibility)
         float rate_target( Creature &c, float best, bool smart = false ) const;
+        /**
+         * The read-only part of @ref plan: picks the best target among the player, NPCs
+         * and hostile monster factions and sums up the anger and morale changes caused
+         * by nearby hostiles. It does not modify the monster (nor anything else), so it
+         * can run concurrently for many monsters, see @ref game::monmove.
+         * Attitudes are evaluated with the anger and morale from before this plan.
+         */
+        struct target_selection {
+            Creature *target = nullptr;
+            float dist = 0;
+            bool fleeing = false;
+            int anger = 0;
+            int morale = 0;
+        };
+        target_selection find_target( const mfactions &factions ) const;
         // Pass all factions to mon, so that hordes of same-faction mons
         // do not iterate over each other
         void plan( const mfactions &factions );
+        /** Like @ref plan, but uses a target selection computed earlier by @ref find_target. */
+        void plan( const mfactions &factions, const target_selection &selection );
         void move(); // Actual movement
         void footsteps( const tripoint &p ); // noise made by movement
         void shove_vehicle( const tripoint &remote_destination,
@@ -53,6 +53,8 @@ std::map<std::string, std::string> TILESETS; // All found tilesets: <name, tiles
 std::map<std::string, std::string> SOUNDPACKS; // All found soundpacks: <name, soundpack_dir>
 std::map<std::string, int> mOptionsSort;
 
+int options_manager::values_generation = 0;
+
 options_manager &get_options()
 {
     static options_manager single_instance;
@@ -692,6 +694,7 @@ int options_manager::cOpt::getMaxLength() const
 //set to next item
 void options_manager::cOpt::setNext()
 {
+    note_values_changed();
     if( sType == "string_select" ) {
         int iNext = getItemPos( sSet ) + 1;
         if( iNext >= static_cast<int>( vItems.size() ) ) {
@@ -736,6 +739,7 @@ void options_manager::cOpt::setNext()
 //set to previous item
 void options_manager::cOpt::setPrev()
 {
+    note_values_changed();
     if( sType == "string_select" ) {
         int iPrev = static_cast<int>( getItemPos( sSet ) ) - 1;
         if( iPrev < 0 ) {
@@ -774,6 +778,7 @@ void options_manager::cOpt::setPrev()
 //set value
 void options_manager::cOpt::setValue( float fSetIn )
 {
+    note_values_changed();
     if( sType != "float" ) {
         debugmsg( "tried to set a float value to a %s option", sType );
         return;
@@ -787,6 +792,7 @@ void options_manager::cOpt::setValue( float fSetIn )
 //set value
 void options_manager::cOpt::setValue( int iSetIn )
 {
+    note_values_changed();
     if( sType != "int" ) {
         debugmsg( "tried to set an int value to a %s option", sType );
         return;
@@ -800,6 +806,7 @@ void options_manager::cOpt::setValue( int iSetIn )
 //set value
 void options_manager::cOpt::setValue( std::string sSetIn )
 {
+    note_values_changed();
     if( sType == "string_select" ) {
         if( getItemPos( sSetIn ) != -1 ) {
             sSet = sSetIn;
@@ -959,6 +966,7 @@ bool android_get_default_setting( const char *settings_name, bool default_value
 
 void options_manager::init()
 {
+    note_values_changed();
     options.clear();
     vPages.clear();
     mPageItems.clear();
@@ -1176,6 +1184,26 @@ void options_manager::add_options_general()
 
     get_option( "AUTOSAVE_MINUTES" ).setPrerequisite( "AUTOSAVE" );
 
+    add( "BINARY_MAP_SAVES", "general", translate_marker( "Binary map saves" ),
+         translate_marker( "If true, the map is saved in a compact binary format instead of JSON, which is faster to write and takes much less disk space.  Maps saved in either format can always be loaded." ),
+         false
+       );
+
+    add( "PREGENERATE_OVERMAPS", "general", translate_marker( "Generate overmaps in advance" ),
+         translate_marker( "If true, new overmaps are generated in the background when you get close to the edge of the known world, instead of pausing the game when you reach it." ),
+         false
+       );
+
+    add( "PREFETCH_MAP", "general", translate_marker( "Prepare the map ahead of vehicles" ),
+         translate_marker( "If true, the parts of the map a moving vehicle is about to reach are read from disk in the background, and generated a bit at a time, instead of all at once when the vehicle gets there." ),
+         false
+       );
+
+    add( "PARALLEL_HORDES", "general", translate_marker( "Move hordes in parallel" ),
+         translate_marker( "If true, the hordes of the overmaps around you are moved on several threads at once.  Faster with many hordes." ),
+         false
+       );
+
     mOptionsSort["general"]++;
 
     add( "CIRCLEDIST", "general", translate_marker( "Circular distances" ),
@@ -1836,6 +1864,18 @@ void options_manager::add_options_debug()
          translate_marker( "If true, file path names are going to be transcoded from system encoding to UTF-8 when reading and will be transcoded back when writing.  Mainly for CJK Windows users." ),
          true
        );
+
+    mOptionsSort["debug"]++;
+
+    add( "TURN_PROFILER", "debug", translate_marker( "Turn profiler" ),
+         translate_marker( "If true, the duration of each phase of a game turn is recorded.  The statistics are written to turn_profile.csv and turn_profile.json in the config directory when the game ends." ),
+         false
+       );
+
+    add( "MONSTER_FLOW_FIELDS", "debug", translate_marker( "Monster flow fields" ),
+         translate_marker( "If true, monsters heading for the same spot follow a shared distance map of the z-level instead of searching a route each.  Much faster with large hordes, the routes may differ slightly." ),
+         false
+       );
 }
 
 void options_manager::add_options_world_default()
@@ -2664,6 +2704,7 @@ std::string options_manager::show( bool ingame, const bool world_options_only )
                 ACTIVE_WORLD_OPTIONS = WOPTIONS_OLD;
             }
         }
+        note_values_changed();
     }
 
     if( lang_changed ) {
@@ -219,6 +219,16 @@ class options_manager
 
         cOpt &get_option( const std::string &name );
 
+        /**
+         * Incremented whenever the value of any option may have changed, or a
+         * different set of world options became active. See @ref option_handle.
+         */
+        static int values_generation;
+        /** Invalidates every @ref option_handle. */
+        static void note_values_changed() {
+            values_generation++;
+        }
+
         //add hidden external option with value
         void add_external( const std::string &sNameIn, const std::string &sPageIn, const std::string &sType,
                            const std::string &sMenuTextIn, const std::string &sTooltipIn );
@@ -292,4 +302,32 @@ inline T get_option( const std::string &name )
     return get_options().get_option( name ).value_as<T>();
 }
 
+/**
+ * Typed access to an option for code that reads it often, e.g. each turn or
+ * each frame. The option is looked up by name on the first read, after that
+ * the value is returned from a cache until any option changes (see
+ * @ref options_manager::values_generation). Meant to be a static object in
+ * the function or file that uses it, and like @ref get_option only to be
+ * read from the main thread.
+ */
+template<typename T>
+class option_handle
+{
+    public:
+        explicit option_handle( const std::string &name ) : name( name ) {}
+
+        T get() const {
+            if( generation != options_manager::values_generation ) {
+                value = get_option<T>( name );
+                generation = options_manager::values_generation;
+            }
+            return value;
+        }
+
+    private:
+        std::string name;
+        mutable T value = T();
+        mutable int generation = -1;
+};
+
 #endif
@@ -14,7 +14,9 @@
 #include <unordered_set>
 #include <set>
 #include <iostream>
+#include <sstream>
 
+#include "background_writer.h"
 #include "catacharset.h"
 #include "cata_utility.h"
 #include "coordinate_conversions.h"
@@ -1035,6 +1037,11 @@ overmap::overmap( const int x, const int y ) : loc( x, y )
     }
     settings = rsit->second;
 
+    gen_options.city_size = get_option<int>( "CITY_SIZE" );
+    gen_options.city_spacing = get_option<int>( "CITY_SPACING" );
+    gen_options.wander_spawns = get_option<bool>( "WANDER_SPAWNS" );
+    gen_options.disable_animal_clash = get_option<bool>( "DISABLE_ANIMAL_CLASH" );
+
     init_layers();
 }
 
@@ -1050,6 +1057,29 @@ void overmap::populate( overmap_special_batch &enabled_specials )
 }
 
 void overmap::populate()
+{
+    overmap_special_batch enabled_specials = get_enabled_specials();
+    populate( enabled_specials );
+}
+
+bool overmap::generate_detached( overmap_special_batch &enabled_specials, const overmap *north,
+                                 const overmap *east, const overmap *south, const overmap *west )
+{
+    detached = true;
+    detached_failed = false;
+    try {
+        // Only the main thread may show errors, it gets them when generating it again.
+        debugmsg_throws errors_fail_generation;
+        generate( north, east, south, west, enabled_specials );
+    } catch( const std::exception & ) {
+        // Generating it again on the main thread reports the error.
+        detached_failed = true;
+    }
+    detached = false;
+    return !detached_failed;
+}
+
+overmap_special_batch overmap::get_enabled_specials() const
 {
     overmap_special_batch enabled_specials = overmap_specials::get_default_batch( loc );
 
@@ -1093,7 +1123,7 @@ void overmap::populate()
         }
     }
 
-    populate( enabled_specials );
+    return enabled_specials;
 }
 
 oter_id overmap::get_default_terrain( int z ) const
@@ -1109,18 +1139,69 @@ oter_id overmap::get_default_terrain( int z ) const
     }
 }
 
+void map_layer::fill( const oter_id &terrain )
+{
+    uniform_terrain = terrain;
+    this->terrain.clear();
+    this->terrain.shrink_to_fit();
+}
+
+void map_layer::compact()
+{
+    if( terrain.empty() ) {
+        return;
+    }
+    const oter_id first = terrain.front();
+    const auto same = [&first]( const oter_id & t ) {
+        return t == first;
+    };
+    if( std::all_of( terrain.begin(), terrain.end(), same ) ) {
+        fill( first );
+    }
+}
+
+oter_id &map_layer::ter( const int x, const int y )
+{
+    if( terrain.empty() ) {
+        terrain.assign( OMAPX * OMAPY, uniform_terrain );
+    }
+    return terrain[x * OMAPY + y];
+}
+
+void map_layer::set_visible( const int x, const int y, const bool value )
+{
+    if( visible.empty() ) {
+        if( !value ) {
+            return;
+        }
+        visible.assign( OMAPX * OMAPY, false );
+    }
+    visible[x * OMAPY + y] = value;
+}
+
+void map_layer::set_explored( const int x, const int y, const bool value )
+{
+    if( explored.empty() ) {
+        if( !value ) {
+            return;
+        }
+        explored.assign( OMAPX * OMAPY, false );
+    }
+    explored[x * OMAPY + y] = value;
+}
+
 void overmap::init_layers()
 {
     for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
-        const oter_id tid = get_default_terrain( k - OVERMAP_DEPTH );
+        layer[k] = map_layer();
+        layer[k].fill( get_default_terrain( k - OVERMAP_DEPTH ) );
+    }
+}
 
-        for( int i = 0; i < OMAPX; ++i ) {
-            for( int j = 0; j < OMAPY; ++j ) {
-                layer[k].terrain[i][j] = tid;
-                layer[k].visible[i][j] = false;
-                layer[k].explored[i][j] = false;
-            }
-        }
+void overmap::compact_layers()
+{
+    for( map_layer &l : layer ) {
+        l.compact();
     }
 }
 
@@ -1130,7 +1211,8 @@ oter_id &overmap::ter( const int x, const int y, const int z )
         return ot_null;
     }
 
-    return layer[z + OVERMAP_DEPTH].terrain[x][y];
+    terrain_index_dirty = true;
+    return layer[z + OVERMAP_DEPTH].ter( x, y );
 }
 
 oter_id &overmap::ter( const tripoint &p )
@@ -1144,7 +1226,7 @@ const oter_id overmap::get_ter( const int x, const int y, const int z ) const
         return ot_null;
     }
 
-    return layer[z + OVERMAP_DEPTH].terrain[x][y];
+    return layer[z + OVERMAP_DEPTH].get_ter( x, y );
 }
 
 const oter_id overmap::get_ter( const tripoint &p ) const
@@ -1152,22 +1234,76 @@ const oter_id overmap::get_ter( const tripoint &p ) const
     return get_ter( p.x, p.y, p.z );
 }
 
-bool &overmap::seen( int x, int y, int z )
+void overmap::build_terrain_index() const
+{
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        const map_layer &l = layer[z + OVERMAP_DEPTH];
+        terrain_index_layer &index = terrain_index[z + OVERMAP_DEPTH];
+        index.clear();
+        const oter_id default_type = get_default_terrain( z );
+        if( l.is_uniform() && l.get_ter( 0, 0 ) == default_type ) {
+            continue;
+        }
+        for( int i = 0; i < OMAPX; i++ ) {
+            for( int j = 0; j < OMAPY; j++ ) {
+                const oter_id t = l.get_ter( i, j );
+                if( t != default_type ) {
+                    index[t.to_i()].push_back( i * OMAPY + j );
+                }
+            }
+        }
+    }
+    terrain_index_dirty = false;
+}
+
+void overmap::for_each_terrain( const int z, const std::vector<bool> &types,
+                                const std::function<void( const tripoint & )> &callback ) const
+{
+    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        return;
+    }
+    const auto matches = [&types]( const oter_id & type ) {
+        return static_cast<size_t>( type.to_i() ) < types.size() && types[type.to_i()];
+    };
+    if( matches( get_default_terrain( z ) ) ) {
+        // Not in the index, look at every tile instead.
+        const map_layer &l = layer[z + OVERMAP_DEPTH];
+        for( int i = 0; i < OMAPX; i++ ) {
+            for( int j = 0; j < OMAPY; j++ ) {
+                if( matches( l.get_ter( i, j ) ) ) {
+                    callback( tripoint( i, j, z ) );
+                }
+            }
+        }
+        return;
+    }
+    if( terrain_index_dirty ) {
+        build_terrain_index();
+    }
+    for( const auto &entry : terrain_index[z + OVERMAP_DEPTH] ) {
+        if( static_cast<size_t>( entry.first ) >= types.size() || !types[entry.first] ) {
+            continue;
+        }
+        for( const uint16_t packed : entry.second ) {
+            callback( tripoint( packed / OMAPY, packed % OMAPY, z ) );
+        }
+    }
+}
+
+bool overmap::seen( const int x, const int y, const int z ) const
 {
     if( !inbounds( tripoint( x, y, z ) ) ) {
-        nullbool = false;
-        return nullbool;
+        return false;
     }
-    return layer[z + OVERMAP_DEPTH].visible[x][y];
+    return layer[z + OVERMAP_DEPTH].is_visible( x, y );
 }
 
-bool &overmap::explored( int x, int y, int z )
+void overmap::set_seen( const int x, const int y, const int z, const bool value )
 {
     if( !inbounds( tripoint( x, y, z ) ) ) {
-        nullbool = false;
-        return nullbool;
+        return;
     }
-    return layer[z + OVERMAP_DEPTH].explored[x][y];
+    layer[z + OVERMAP_DEPTH].set_visible( x, y, value );
 }
 
 bool overmap::is_explored( const int x, const int y, const int z ) const
@@ -1175,7 +1311,15 @@ bool overmap::is_explored( const int x, const int y, const int z ) const
     if( !inbounds( tripoint( x, y, z ) ) ) {
         return false;
     }
-    return layer[z + OVERMAP_DEPTH].explored[x][y];
+    return layer[z + OVERMAP_DEPTH].is_explored( x, y );
+}
+
+void overmap::set_explored( const int x, const int y, const int z, const bool value )
+{
+    if( !inbounds( tripoint( x, y, z ) ) ) {
+        return;
+    }
+    layer[z + OVERMAP_DEPTH].set_explored( x, y, value );
 }
 
 bool overmap::mongroup_check( const mongroup &candidate ) const
@@ -1365,6 +1509,7 @@ void overmap::generate( const overmap *north, const overmap *east,
     // Place the monsters, now that the terrain is laid out
     place_mongroups();
     place_radios();
+    compact_layers();
     dbg( D_INFO ) << "overmap::generate done";
 }
 
@@ -1642,7 +1787,7 @@ std::vector<point> overmap::find_terrain( const std::string &term, int zlevel )
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
             if( seen( x, y, zlevel ) &&
-                lcmatch( ter( x, y, zlevel )->get_name(), term ) ) {
+                lcmatch( get_ter( x, y, zlevel )->get_name(), term ) ) {
                 found.push_back( global_base_point() + point( x, y ) );
             }
         }
@@ -1709,7 +1854,7 @@ void mongroup::wander( const overmap &om )
     const city *target_city = nullptr;
     int target_distance = 0;
 
-    if( horde_behaviour == "city" ) {
+    if( horde_behaviour == behaviour::city ) {
         // Find a nearby city to return to..
         for( const city &check_city : om.cities ) {
             // Check if this is the nearest city so far.
@@ -1735,20 +1880,48 @@ void mongroup::wander( const overmap &om )
     }
 }
 
-void overmap::move_hordes()
+/** How many times less likely a horde on @p ter is to move than one on open ground. */
+static int horde_movement_chance( const oter_id &ter )
 {
-    // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype( zg ) tmpzg;
-    //MOVE ZOMBIE GROUPS
-    for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
-        if( !mg.horde ) {
-            ++it;
-            continue;
+    if( ter == ot_forest || ter == ot_forest_water ) {
+        return 3;
+    } else if( ter == ot_forest_thick ) {
+        return 6;
+    } else if( ter == ot_river_center ) {
+        return 10;
+    }
+    return 1;
+}
+
+overmap::horde_moves overmap::gather_hordes()
+{
+    horde_moves moves;
+    for( auto it = zg.begin(); it != zg.end(); ++it ) {
+        if( it->second.horde ) {
+            moves.groups.push_back( it );
         }
+    }
+    const size_t count = moves.groups.size();
+
+    // Decrease movement chance according to the terrain we're currently on.
+    moves.movement_chance.resize( count );
+    moves.avg_speed.resize( count );
+    for( size_t i = 0; i < count; i++ ) {
+        const mongroup &mg = moves.groups[i]->second;
+        moves.movement_chance[i] = horde_movement_chance( get_ter( mg.pos ) );
+        moves.avg_speed[i] = mg.avg_speed();
+    }
+    return moves;
+}
 
-        if( mg.horde_behaviour.empty() ) {
-            mg.horde_behaviour = one_in( 2 ) ? "city" : "roam";
+void overmap::plan_horde_moves( horde_moves &moves )
+{
+    const size_t count = moves.groups.size();
+    moves.moved.assign( count, false );
+    for( size_t i = 0; i < count; i++ ) {
+        mongroup &mg = moves.groups[i]->second;
+        if( mg.horde_behaviour == mongroup::behaviour::none ) {
+            mg.horde_behaviour = one_in( 2 ) ? mongroup::behaviour::city : mongroup::behaviour::roam;
         }
 
         // Gradually decrease interest.
@@ -1758,17 +1931,6 @@ void overmap::move_hordes()
             mg.wander( *this );
         }
 
-        // Decrease movement chance according to the terrain we're currently on.
-        const oter_id &walked_into = ter( mg.pos.x, mg.pos.y, mg.pos.z );
-        int movement_chance = 1;
-        if( walked_into == ot_forest || walked_into == ot_forest_water ) {
-            movement_chance = 3;
-        } else if( walked_into == ot_forest_thick ) {
-            movement_chance = 6;
-        } else if( walked_into == ot_river_center ) {
-            movement_chance = 10;
-        }
-
         // If the average horde speed is 50% that of normal, then the chance to
         // move should be 1/2 what it would be if the speed was 100%.
         // Since the max speed for a horde is one map space per 2.5 minutes,
@@ -1777,7 +1939,8 @@ void overmap::move_hordes()
         // 200 or over will move at max speed, and slower hordes will move less
         // frequently. The average horde speed for regular Z's is around 100,
         // or one space per 5 minutes.
-        if( one_in( movement_chance ) && rng( 0, 100 ) < mg.interest && rng( 0, 200 ) < mg.avg_speed() ) {
+        if( one_in( moves.movement_chance[i] ) && rng( 0, 100 ) < mg.interest &&
+            rng( 0, 200 ) < moves.avg_speed[i] ) {
             // TODO: Handle moving to adjacent overmaps.
             if( mg.pos.x > mg.target.x ) {
                 mg.pos.x--;
@@ -1791,17 +1954,38 @@ void overmap::move_hordes()
             if( mg.pos.y < mg.target.y ) {
                 mg.pos.y++;
             }
+            moves.moved[i] = true;
+        }
+    }
+}
 
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.insert( std::pair<tripoint, mongroup>( mg.pos, mg ) );
-            zg.erase( it++ );
-        } else {
-            ++it;
+void overmap::apply_horde_moves( horde_moves &moves )
+{
+    // The moved groups still sit under their old position in zg, re-key them.
+    // Moving them out instead of copying keeps their monsters where they are.
+    std::vector<mongroup> moved;
+    for( size_t i = 0; i < moves.groups.size(); i++ ) {
+        if( moves.moved[i] ) {
+            moved.push_back( std::move( moves.groups[i]->second ) );
+            zg.erase( moves.groups[i] );
         }
     }
-    // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    for( mongroup &mg : moved ) {
+        const tripoint pos = mg.pos;
+        zg.emplace( pos, std::move( mg ) );
+    }
+}
 
+void overmap::move_hordes()
+{
+    horde_moves moves = gather_hordes();
+    plan_horde_moves( moves );
+    apply_horde_moves( moves );
+    absorb_wandering_zombies();
+}
+
+void overmap::absorb_wandering_zombies()
+{
     if( get_option<bool>( "WANDER_SPAWNS" ) ) {
         static const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
 
@@ -2066,7 +2250,7 @@ void overmap::place_forest_trails()
 void overmap::place_forest_trailheads()
 {
     // No trailheads if there are no cities.
-    const int city_size = get_option<int>( "CITY_SIZE" );
+    const int city_size = gen_options.city_size;
     if( city_size <= 0 ) {
         return;
     }
@@ -2685,11 +2869,11 @@ spawns happen at... <cue Clue music>
 20:56 <kevingranade>: game:pawn_mon() in game.cpp:7380*/
 void overmap::place_cities()
 {
-    int op_city_size = get_option<int>( "CITY_SIZE" );
+    int op_city_size = gen_options.city_size;
     if( op_city_size <= 0 ) {
         return;
     }
-    int op_city_spacing = get_option<int>( "CITY_SPACING" );
+    int op_city_spacing = gen_options.city_spacing;
 
     // spacing dictates how much of the map is covered in cities
     //   city  |  cities  |   size N cities per overmap
@@ -3987,6 +4171,11 @@ void overmap::place_specials( overmap_special_batch &enabled_specials )
     return placement.instances_placed <
            placement.special_details->occurrences.min;
 } ) ) {
+        if( detached ) {
+            // That needs the overmap buffer, which only the main thread may touch.
+            detached_failed = true;
+            return;
+        }
         // Randomly select from among the nearest uninitialized overmap positions.
         int previous_distance = 0;
         std::vector<point> nearest_candidates;
@@ -4059,7 +4248,7 @@ void overmap::place_mongroups()
 {
     // Cities are full of zombies
     for( auto &elem : cities ) {
-        if( get_option<bool>( "WANDER_SPAWNS" ) ) {
+        if( gen_options.wander_spawns ) {
             if( !one_in( 16 ) || elem.size > 5 ) {
                 mongroup m( mongroup_id( "GROUP_ZOMBIE" ), ( elem.pos.x * 2 ), ( elem.pos.y * 2 ), 0,
                             static_cast<int>( elem.size * 2.5 ),
@@ -4072,7 +4261,7 @@ void overmap::place_mongroups()
         }
     }
 
-    if( get_option<bool>( "DISABLE_ANIMAL_CLASH" ) ) {
+    if( gen_options.disable_animal_clash ) {
         // Figure out where swamps are, and place swamp monsters
         for( int x = 3; x < OMAPX - 3; x += 7 ) {
             for( int y = 3; y < OMAPY - 3; y += 7 ) {
@@ -4168,8 +4357,11 @@ void overmap::open( overmap_special_batch &enabled_specials )
     const std::string plrfilename = overmapbuffer::player_filename( loc.x, loc.y );
     const std::string terfilename = overmapbuffer::terrain_filename( loc.x, loc.y );
 
+    background_writer::wait_for( plrfilename );
+    background_writer::wait_for( terfilename );
     using namespace std::placeholders;
     if( read_from_file_optional( terfilename, std::bind( &overmap::unserialize, this, _1 ) ) ) {
+        compact_layers();
         read_from_file_optional( plrfilename, std::bind( &overmap::unserialize_view, this, _1 ) );
     } else { // No map exists!  Prepare neighbors, and generate one.
         std::vector<const overmap *> pointers;
@@ -4187,19 +4379,18 @@ void overmap::open( overmap_special_batch &enabled_specials )
     }
 }
 
-// Note: this may throw io errors from std::ofstream
 void overmap::save() const
 {
     const std::string plrfilename = overmapbuffer::player_filename( loc.x, loc.y );
     const std::string terfilename = overmapbuffer::terrain_filename( loc.x, loc.y );
 
-    ofstream_wrapper fout_player( plrfilename );
+    std::ostringstream fout_player;
     serialize_view( fout_player );
-    fout_player.close();
+    background_writer::write( plrfilename, fout_player.str() );
 
-    ofstream_wrapper_exclusive fout_terrain( terfilename );
+    std::ostringstream fout_terrain;
     serialize( fout_terrain );
-    fout_terrain.close();
+    background_writer::write( terfilename, fout_terrain.str() );
 }
 
 void overmap::add_mon_group( const mongroup &group )
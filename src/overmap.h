@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
 #include <map>
@@ -89,11 +90,47 @@ struct radio_tower {
     }
 };
 
-struct map_layer {
-    oter_id terrain[OMAPX][OMAPY];
-    bool visible[OMAPX][OMAPY];
-    bool explored[OMAPX][OMAPY];
-    std::vector<om_note> notes;
+/**
+ * The terrain, visibility and notes of one z-level of an overmap.
+ * Most z-levels are nothing but open air or solid rock, so a layer whose
+ * terrain is all the same only stores that one terrain, and the visibility
+ * bits are only allocated once a tile of the layer is seen or explored.
+ */
+class map_layer
+{
+    public:
+        /** Makes every tile @p terrain, and frees the per-tile terrain. */
+        void fill( const oter_id &terrain );
+        /** Frees the per-tile terrain if all tiles have the same terrain. */
+        void compact();
+        bool is_uniform() const {
+            return terrain.empty();
+        }
+
+        oter_id get_ter( const int x, const int y ) const {
+            return terrain.empty() ? uniform_terrain : terrain[x * OMAPY + y];
+        }
+        /** Allocates the per-tile terrain if the layer was uniform. */
+        oter_id &ter( int x, int y );
+
+        bool is_visible( const int x, const int y ) const {
+            return !visible.empty() && visible[x * OMAPY + y];
+        }
+        void set_visible( int x, int y, bool value );
+        bool is_explored( const int x, const int y ) const {
+            return !explored.empty() && explored[x * OMAPY + y];
+        }
+        void set_explored( int x, int y, bool value );
+
+        std::vector<om_note> notes;
+
+    private:
+        oter_id uniform_terrain;
+        /** Terrain of each tile, indexed by x * OMAPY + y; empty if the layer is uniform. */
+        std::vector<oter_id> terrain;
+        /** Bits indexed like @ref terrain, empty while no tile is set. */
+        std::vector<bool> visible;
+        std::vector<bool> explored;
 };
 
 struct om_special_sectors {
@@ -160,6 +197,18 @@ class overmap
          **/
         void populate( overmap_special_batch &enabled_specials );
         void populate();
+        /**
+         * Generates the content of a new overmap like @ref populate does when there
+         * is no saved one, but without using the overmap buffer, so it can run on
+         * another thread. The neighbours (each may be null) must not change meanwhile.
+         * Game options are read when the overmap is constructed and the specials
+         * come from @ref get_enabled_specials, both on the main thread.
+         * @returns false if that was not possible, the overmap must be discarded then.
+         */
+        bool generate_detached( overmap_special_batch &enabled_specials, const overmap *north,
+                                const overmap *east, const overmap *south, const overmap *west );
+        /** The specials the region settings allow on this overmap. */
+        overmap_special_batch get_enabled_specials() const;
 
         const point &pos() const {
             return loc;
@@ -181,13 +230,21 @@ class overmap
          */
         std::vector<point> find_terrain( const std::string &term, int zlevel );
 
+        /** Gives write access to the terrain, so it invalidates @ref terrain_index. Use get_ter for reading. */
         oter_id &ter( const int x, const int y, const int z );
         oter_id &ter( const tripoint &p );
         const oter_id get_ter( const int x, const int y, const int z ) const;
         const oter_id get_ter( const tripoint &p ) const;
-        bool   &seen( int x, int y, int z );
-        bool   &explored( int x, int y, int z );
+        /**
+         * Calls @p callback with the local coordinates of every tile on z-level @p z
+         * whose terrain is one of @p types, which is indexed by oter_id::to_i().
+         */
+        void for_each_terrain( int z, const std::vector<bool> &types,
+                               const std::function<void( const tripoint & )> &callback ) const;
+        bool seen( int x, int y, int z ) const;
+        void set_seen( int x, int y, int z, bool value );
         bool is_explored( const int x, const int y, const int z ) const;
+        void set_explored( int x, int y, int z, bool value );
 
         bool has_note( int x, int y, int z ) const;
         const std::string &note( int x, int y, int z ) const;
@@ -240,6 +297,7 @@ class overmap
         }
 
         void clear_mon_groups();
+        void add_mon_group( const mongroup &group );
     private:
         std::multimap<tripoint, mongroup> zg;
     public:
@@ -275,20 +333,48 @@ class overmap
 
         std::vector<std::shared_ptr<npc>> npcs;
 
-        bool nullbool = false;
         point loc = point_zero;
 
         std::array<map_layer, OVERMAP_LAYERS> layer;
         std::unordered_map<tripoint, scent_trace> scents;
 
+        /**
+         * For each z-level, the tiles of each terrain type (by oter_id::to_i()),
+         * packed as x * OMAPY + y. The default terrain of the z-level is left out,
+         * it covers most of the tiles and is hardly ever searched for.
+         * Rebuilt by @ref for_each_terrain when @ref terrain_index_dirty is set.
+         */
+        using terrain_index_layer = std::unordered_map<int, std::vector<uint16_t>>;
+        mutable std::array<terrain_index_layer, OVERMAP_LAYERS> terrain_index;
+        mutable bool terrain_index_dirty = true;
+        void build_terrain_index() const;
+
         // Records the locations where a given overmap special was placed, which
         // can be used after placement to lookup whether a given location was created
         // as part of a special.
         std::unordered_map<tripoint, overmap_special_id> overmap_special_placements;
 
         regional_settings settings;
+        /**
+         * The game options that generation depends on. Read along with the region
+         * settings, so that @ref generate_detached doesn't need to access them.
+         */
+        struct generation_options {
+            int city_size = 0;
+            int city_spacing = 0;
+            bool wander_spawns = false;
+            bool disable_animal_clash = false;
+        };
+        generation_options gen_options;
 
         oter_id get_default_terrain( int z ) const;
+        /** Calls @ref map_layer::compact on all layers, once they are fully generated or loaded. */
+        void compact_layers();
+
+        /** Set by @ref generate_detached while it runs. */
+        bool detached = false;
+        /** Set when generation needed something it may not do while @ref detached. */
+        bool detached_failed = false;
 
         // Initialize
         void init_layers();
@@ -327,6 +413,36 @@ class overmap
         void process_mongroups();
         void move_hordes();
 
+        /**
+         * The hordes of @ref zg in flat arrays, all indexed alike, as gathered
+         * by @ref gather_hordes and planned by @ref plan_horde_moves.
+         */
+        struct horde_moves {
+            std::vector<std::multimap<tripoint, mongroup>::iterator> groups;
+            /** The horde moves with a chance of 1 in this, depending on the terrain. */
+            std::vector<int> movement_chance;
+            /** @ref mongroup::avg_speed of the horde. */
+            std::vector<float> avg_speed;
+            /** Whether the horde moved, its position in @ref zg is outdated then. */
+            std::vector<bool> moved;
+        };
+        /**
+         * Collects the hordes and everything about them that needs the monster
+         * types. Those lazily cache their ids, so this must run on the main thread.
+         */
+        horde_moves gather_hordes();
+        /**
+         * Updates the interest, target and position of all hordes, but leaves them
+         * under their old position in @ref zg. Only touches this overmap (and the
+         * random number generator of the calling thread), so several overmaps can
+         * be planned at the same time.
+         */
+        void plan_horde_moves( horde_moves &moves );
+        /** Files the hordes that moved in @p moves under their new position. */
+        void apply_horde_moves( horde_moves &moves );
+        /** Lets zombies outside the reality bubble join hordes, see "WANDER_SPAWNS". */
+        void absorb_wandering_zombies();
+
         static bool obsolete_terrain( const std::string &ter );
         void convert_terrain( const std::unordered_map<tripoint, std::string> &needs_conversion );
 
@@ -417,8 +533,6 @@ class overmap
         void place_mongroups();
         void place_radios();
 
-        void add_mon_group( const mongroup &group );
-
         void load_monster_groups( JsonIn &jo );
         void load_legacy_monstergroups( JsonIn &jo );
         void save_monster_groups( JsonOut &jo ) const;
@@ -0,0 +1,198 @@
+#include "overmap_pregen.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+#include "enums.h"
+#include "overmap.h"
+#include "rng.h"
+
+namespace
+{
+
+struct pregen_job {
+    std::unique_ptr<overmap> om;
+    std::array<std::unique_ptr<overmap>, 4> neighbours;
+    overmap_special_batch specials;
+    /** Drawn from the main thread's engine when queued, the worker's engine is seeded with it. */
+    unsigned int seed;
+};
+
+class pregen_thread
+{
+    public:
+        ~pregen_thread() {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+                jobs.clear();
+            }
+            queue_changed.notify_all();
+            if( worker.joinable() ) {
+                worker.join();
+            }
+        }
+
+        void queue( pregen_job job ) {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                if( !worker.joinable() ) {
+                    worker = std::thread( &pregen_thread::run, this );
+                }
+                pending.insert( job.om->pos() );
+                jobs.push_back( std::move( job ) );
+            }
+            queue_changed.notify_all();
+        }
+
+        bool is_pending( const point &om_pos ) {
+            std::lock_guard<std::mutex> lock( mutex );
+            return pending.count( om_pos ) > 0;
+        }
+
+        std::vector<std::unique_ptr<overmap>> take_finished() {
+            std::lock_guard<std::mutex> lock( mutex );
+            std::vector<std::unique_ptr<overmap>> result;
+            result.swap( finished );
+            for( const std::unique_ptr<overmap> &om : result ) {
+                pending.erase( om->pos() );
+            }
+            return result;
+        }
+
+        std::unique_ptr<overmap> take( const point &om_pos ) {
+            std::unique_lock<std::mutex> lock( mutex );
+            if( pending.count( om_pos ) == 0 ) {
+                return nullptr;
+            }
+            const auto queued = std::find_if( jobs.begin(), jobs.end(), [&]( const pregen_job & job ) {
+                return job.om->pos() == om_pos;
+            } );
+            if( queued != jobs.end() ) {
+                // Not started yet, the caller can just as well generate it itself.
+                jobs.erase( queued );
+                pending.erase( om_pos );
+                return nullptr;
+            }
+            queue_changed.wait( lock, [&]() {
+                return running != om_pos || !busy;
+            } );
+            pending.erase( om_pos );
+            const auto done = std::find_if( finished.begin(),
+            finished.end(), [&]( const std::unique_ptr<overmap> &om ) {
+                return om->pos() == om_pos;
+            } );
+            if( done == finished.end() ) {
+                return nullptr;
+            }
+            std::unique_ptr<overmap> result = std::move( *done );
+            finished.erase( done );
+            return result;
+        }
+
+        void clear() {
+            std::unique_lock<std::mutex> lock( mutex );
+            jobs.clear();
+            queue_changed.wait( lock, [&]() {
+                return !busy;
+            } );
+            finished.clear();
+            pending.clear();
+        }
+
+    private:
+        void run() {
+            std::unique_lock<std::mutex> lock( mutex );
+            while( true ) {
+                queue_changed.wait( lock, [&]() {
+                    return stopping || !jobs.empty();
+                } );
+                if( stopping ) {
+                    return;
+                }
+                pregen_job job = std::move( jobs.front() );
+                jobs.pop_front();
+                running = job.om->pos();
+                busy = true;
+
+                lock.unlock();
+                rng_get_engine().seed( job.seed );
+                const bool success = job.om->generate_detached( job.specials, job.neighbours[0].get(),
+                                     job.neighbours[1].get(), job.neighbours[2].get(), job.neighbours[3].get() );
+                if( !success ) {
+                    job.om.reset();
+                }
+                lock.lock();
+
+                if( success ) {
+                    finished.push_back( std::move( job.om ) );
+                } else {
+                    pending.erase( running );
+                }
+                busy = false;
+                queue_changed.notify_all();
+            }
+        }
+
+        std::mutex mutex;
+        /** Signaled whenever a job is queued or finished. */
+        std::condition_variable queue_changed;
+        std::deque<pregen_job> jobs;
+        std::vector<std::unique_ptr<overmap>> finished;
+        /** Positions of all queued, running and finished overmaps. */
+        std::set<point> pending;
+        /** Position of the overmap being generated, if @ref busy. */
+        point running;
+        bool busy = false;
+        bool stopping = false;
+        std::thread worker;
+};
+
+pregen_thread &get_pregen()
+{
+    static pregen_thread pregen;
+    return pregen;
+}
+
+} // namespace
+
+namespace overmap_pregen
+{
+
+void queue( std::unique_ptr<overmap> om, std::array<std::unique_ptr<overmap>, 4> neighbours )
+{
+    overmap_special_batch specials = om->get_enabled_specials();
+    const unsigned int seed = rng_get_engine()();
+    get_pregen().queue( pregen_job{ std::move( om ), std::move( neighbours ), std::move( specials ), seed } );
+}
+
+bool is_pending( const point &om_pos )
+{
+    return get_pregen().is_pending( om_pos );
+}
+
+std::vector<std::unique_ptr<overmap>> take_finished()
+{
+    return get_pregen().take_finished();
+}
+
+std::unique_ptr<overmap> take( const point &om_pos )
+{
+    return get_pregen().take( om_pos );
+}
+
+void clear()
+{
+    get_pregen().clear();
+}
+
+} // namespace overmap_pregen
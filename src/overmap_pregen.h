@@ -0,0 +1,52 @@
+#pragma once
+#ifndef OVERMAP_PREGEN_H
+#define OVERMAP_PREGEN_H
+
+#include <array>
+#include <memory>
+#include <vector>
+
+class overmap;
+struct point;
+
+/**
+ * Generates new overmaps on a worker thread, so that the game does not stall
+ * when the player gets close to the edge of the known world.
+ *
+ * Each job gets the new overmap, constructed on the main thread, and copies
+ * of its existing neighbours as they were when it was queued (see
+ * @ref overmap::generate_detached). Overmaps are generated in the order they
+ * were queued, the finished ones still need to be added to the overmap buffer
+ * by the main thread. All functions must be called from the main thread.
+ *
+ * The worker's random engine is seeded from the main thread's when a job is
+ * queued, so with a fixed seed a queued overmap always comes out the same.
+ */
+namespace overmap_pregen
+{
+
+/**
+ * Queues @p om to be generated with @p neighbours (north, east, south, west,
+ * each may be null) as its neighbours.
+ */
+void queue( std::unique_ptr<overmap> om, std::array<std::unique_ptr<overmap>, 4> neighbours );
+
+/** Whether the overmap at @p om_pos is queued, being generated, or finished but not taken yet. */
+bool is_pending( const point &om_pos );
+
+/** Returns the overmaps that finished generating since the last call. */
+std::vector<std::unique_ptr<overmap>> take_finished();
+
+/**
+ * Returns the overmap at @p om_pos, waiting for it if it is being generated.
+ * Returns null (and forgets about it) if it was not pending, if it was still
+ * waiting in the queue, or if it could not be generated on the worker thread.
+ */
+std::unique_ptr<overmap> take( const point &om_pos );
+
+/** Forgets all queued and finished overmaps, waits for the one being generated. */
+void clear();
+
+} // namespace overmap_pregen
+
+#endif
@@ -1067,7 +1067,7 @@ static bool search( tripoint &curs, const tripoint &orig, const bool show_explor
                 }
 
                 if( om->seen( om_relative_x, om_relative_y, curs.z ) &&
-                    match_include_exclude( om->ter( om_relative_x, om_relative_y, curs.z )->get_name(), term ) ) {
+                    match_include_exclude( om->get_ter( om_relative_x, om_relative_y, curs.z )->get_name(), term ) ) {
                     locations.push_back( om->global_base_point() + point( om_relative_x, om_relative_y ) );
                 }
             }
@@ -1231,7 +1231,7 @@ static void place_ter_or_special( tripoint &curs, const tripoint &orig, const bo
                 curs.y += vec->y;
             } else if( action == "CONFIRM" ) { // Actually modify the overmap
                 if( terrain ) {
-                    overmap_buffer.ter( curs ) = uistate.place_terrain->id.id();
+                    overmap_buffer.ter_set( curs, uistate.place_terrain->id.id() );
                     overmap_buffer.set_seen( curs.x, curs.y, curs.z, true );
                 } else {
                     overmap_buffer.place_special( *uistate.place_special, curs, uistate.omedit_rotation, false, true );
@@ -23,9 +23,12 @@
 #include "monster.h"
 #include "npc.h"
 #include "optional.h"
+#include "options.h"
 #include "overmap.h"
 #include "overmap_connection.h"
+#include "overmap_pregen.h"
 #include "overmap_types.h"
+#include "parallel.h"
 #include "string_formatter.h"
 #include "vehicle.h"
 #include "calendar.h"
@@ -91,6 +94,12 @@ overmap &overmapbuffer::get( const int x, const int y )
         return *( last_requested_overmap = it->second.get() );
     }
 
+    finish_pregenerating( p );
+    const auto pregenerated = overmaps.find( p );
+    if( pregenerated != overmaps.end() ) {
+        return *( last_requested_overmap = pregenerated->second.get() );
+    }
+
     // That constructor loads an existing overmap or creates a new one.
     overmap *new_om = new overmap( x, y );
     overmaps[ p ] = std::unique_ptr<overmap>( new_om );
@@ -107,6 +116,7 @@ overmap &overmapbuffer::get( const int x, const int y )
 void overmapbuffer::create_custom_overmap( const int x, const int y,
         overmap_special_batch &specials )
 {
+    finish_pregenerating( point( x, y ) );
     overmap *new_om = new overmap( x, y );
     if( last_requested_overmap != nullptr ) {
         auto om_iter = overmaps.find( new_om->pos() );
@@ -118,6 +128,91 @@ void overmapbuffer::create_custom_overmap( const int x, const int y,
     new_om->populate( specials );
 }
 
+/**
+ * Distance from @p omt (global overmap terrain coordinates) to the closest tile
+ * of the overmap at @p om_pos, 0 if it is on that overmap.
+ */
+static int omt_distance_to_overmap( const point &omt, const point &om_pos )
+{
+    const auto axis_distance = []( int pos, int om, int size ) {
+        return std::max( { 0, om * size - pos, pos - ( om * size + size - 1 ) } );
+    };
+    return std::max( axis_distance( omt.x, om_pos.x, OMAPX ),
+                     axis_distance( omt.y, om_pos.y, OMAPY ) );
+}
+
+void overmapbuffer::add_pregenerated( std::unique_ptr<overmap> new_overmap )
+{
+    overmap &new_om = *new_overmap;
+    overmaps[ new_om.pos() ] = std::move( new_overmap );
+    // Same as in get, these might load other overmaps.
+    fix_mongroups( new_om );
+    fix_npcs( new_om );
+}
+
+void overmapbuffer::finish_pregenerating( const point &p )
+{
+    for( const point &pos : {
+             p, p + point( 0, -1 ), p + point( 1, 0 ), p + point( 0, 1 ), p + point( -1, 0 )
+         } ) {
+        if( std::unique_ptr<overmap> new_om = overmap_pregen::take( pos ) ) {
+            add_pregenerated( std::move( new_om ) );
+        }
+    }
+}
+
+void overmapbuffer::pregenerate_near( const tripoint &omt_pos, const point &heading )
+{
+    for( std::unique_ptr<overmap> &new_om : overmap_pregen::take_finished() ) {
+        add_pregenerated( std::move( new_om ) );
+    }
+
+    // How close (in overmap terrain tiles) the edge of an overmap has to be to
+    // start generating it. Even driving fast that leaves enough time to finish.
+    static constexpr int pregen_distance = OMAPX / 3;
+    const point om_pos = omt_to_om_copy( point( omt_pos.x, omt_pos.y ) );
+    const auto neighbour_copy = [this]( const point & pos ) -> std::unique_ptr<overmap> {
+        const overmap *existing = get_existing( pos.x, pos.y );
+        if( existing == nullptr ) {
+            return nullptr;
+        }
+        // Generation only looks at the terrain and the roads of its neighbours,
+        // the copy must not share any NPCs with the original.
+        std::unique_ptr<overmap> copy = std::make_unique<overmap>( *existing );
+        copy->npcs.clear();
+        copy->zg.clear();
+        return copy;
+    };
+    for( int dx = -1; dx <= 1; dx++ ) {
+        for( int dy = -1; dy <= 1; dy++ ) {
+            if( ( dx == 0 && dy == 0 ) || dx * heading.x + dy * heading.y < 0 ) {
+                continue;
+            }
+            const point candidate = om_pos + point( dx, dy );
+            if( omt_distance_to_overmap( point( omt_pos.x, omt_pos.y ), candidate ) > pregen_distance ||
+                overmaps.count( candidate ) > 0 || overmap_pregen::is_pending( candidate ) ||
+                file_exist( terrain_filename( candidate.x, candidate.y ) ) ) {
+                continue;
+            }
+            // Neighbours depend on each other, they have to be generated one after the other.
+            const std::array<point, 4> neighbours = {{
+                    candidate + point( 0, -1 ), candidate + point( 1, 0 ),
+                    candidate + point( 0, 1 ), candidate + point( -1, 0 )
+                }
+            };
+            if( std::any_of( neighbours.begin(), neighbours.end(), overmap_pregen::is_pending ) ) {
+                continue;
+            }
+            std::array<std::unique_ptr<overmap>, 4> neighbour_copies;
+            for( size_t i = 0; i < neighbours.size(); i++ ) {
+                neighbour_copies[i] = neighbour_copy( neighbours[i] );
+            }
+            overmap_pregen::queue( std::make_unique<overmap>( candidate.x, candidate.y ),
+                                   std::move( neighbour_copies ) );
+        }
+    }
+}
+
 void overmapbuffer::fix_mongroups( overmap &new_overmap )
 {
     for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
@@ -210,6 +305,7 @@ void overmapbuffer::save()
 
 void overmapbuffer::clear()
 {
+    overmap_pregen::clear();
     overmaps.clear();
     known_non_existing.clear();
     last_requested_overmap = nullptr;
@@ -370,7 +466,7 @@ bool overmapbuffer::is_explored( int x, int y, int z )
 void overmapbuffer::toggle_explored( int x, int y, int z )
 {
     overmap &om = get_om_global( x, y );
-    om.explored( x, y, z ) = !om.explored( x, y, z );
+    om.set_explored( x, y, z, !om.is_explored( x, y, z ) );
 }
 
 bool overmapbuffer::has_horde( const int x, const int y, const int z )
@@ -489,8 +585,38 @@ void overmapbuffer::move_hordes()
     // arbitrary radius to include nearby overmaps (aside from the current one)
     const auto radius = MAPSIZE * 2;
     const auto center = g->u.global_sm_location();
-    for( auto &om : get_overmaps_near( center, radius ) ) {
-        om->move_hordes();
+    move_hordes( get_overmaps_near( center, radius ) );
+}
+
+void overmapbuffer::move_hordes( const std::vector<overmap *> &overmaps )
+{
+    static const option_handle<bool> parallel_hordes( "PARALLEL_HORDES" );
+    if( !parallel_hordes.get() ) {
+        for( overmap *om : overmaps ) {
+            om->move_hordes();
+        }
+        return;
+    }
+    // Planning only touches the overmap itself, the rest changes shared state.
+    // The seeds make the plans independent of the thread that makes them.
+    std::vector<overmap::horde_moves> moves;
+    std::vector<unsigned int> seeds;
+    moves.reserve( overmaps.size() );
+    seeds.reserve( overmaps.size() );
+    for( overmap *om : overmaps ) {
+        moves.push_back( om->gather_hordes() );
+        seeds.push_back( rng_get_engine()() );
+    }
+    // Overmaps planned on this thread must not change its engine.
+    const cata_default_random_engine engine = rng_get_engine();
+    cata::parallel_for( overmaps.size(), [&]( const size_t i ) {
+        rng_get_engine().seed( seeds[i] );
+        overmaps[i]->plan_horde_moves( moves[i] );
+    }, 1 );
+    rng_get_engine() = engine;
+    for( size_t i = 0; i < overmaps.size(); i++ ) {
+        overmaps[i]->apply_horde_moves( moves[i] );
+        overmaps[i]->absorb_wandering_zombies();
     }
 }
 
@@ -626,19 +752,27 @@ void overmapbuffer::add_camp( const basecamp &camp )
 bool overmapbuffer::seen( int x, int y, int z )
 {
     const overmap *om = get_existing_om_global( x, y );
-    return ( om != nullptr ) && const_cast<overmap *>( om )->seen( x, y, z );
+    return ( om != nullptr ) && om->seen( x, y, z );
 }
 
 void overmapbuffer::set_seen( int x, int y, int z, bool seen )
 {
     overmap &om = get_om_global( x, y );
-    om.seen( x, y, z ) = seen;
+    om.set_seen( x, y, z, seen );
+}
+
+const oter_id overmapbuffer::ter( int x, int y, int z )
+{
+    overmap &om = get_om_global( x, y );
+    return om.get_ter( x, y, z );
 }
 
-oter_id &overmapbuffer::ter( int x, int y, int z )
+void overmapbuffer::ter_set( const tripoint &p, const oter_id &id )
 {
+    int x = p.x;
+    int y = p.y;
     overmap &om = get_om_global( x, y );
-    return om.ter( x, y, z );
+    om.ter( x, y, p.z ) = id;
 }
 
 bool overmapbuffer::reveal( const point &center, int radius, int z )
@@ -915,6 +1049,60 @@ tripoint overmapbuffer::find_closest( const tripoint &origin, const std::string
                                    existing_overmaps_only, om_special );
     return find_closest( origin, params );
 }
+/** Which terrain types (indexed by oter_id::to_i()) match the type criteria of @p params. */
+static std::vector<bool> matching_terrain_types( const omt_find_params &params )
+{
+    const std::vector<oter_t> &all = overmap_terrains::get_all();
+    std::vector<bool> result( all.size(), false );
+    for( size_t i = 0; i < all.size(); i++ ) {
+        const oter_id id( i );
+        result[i] = params.allow_subtypes ? is_ot_subtype( params.type.c_str(), id ) :
+                    is_ot_type( params.type, id );
+    }
+    return result;
+}
+
+/**
+ * Overmap coordinates of the overmaps that overlap the square of the given radius
+ * around @p origin, paired with the distance from @p origin to their closest tile.
+ */
+static std::vector<std::pair<int, point>> overmaps_in_range( const tripoint &origin, int radius )
+{
+    const point min_om = omt_to_om_copy( point( origin.x - radius, origin.y - radius ) );
+    const point max_om = omt_to_om_copy( point( origin.x + radius, origin.y + radius ) );
+    std::vector<std::pair<int, point>> result;
+    for( int x = min_om.x; x <= max_om.x; x++ ) {
+        for( int y = min_om.y; y <= max_om.y; y++ ) {
+            const int dist = omt_distance_to_overmap( point( origin.x, origin.y ), point( x, y ) );
+            result.emplace_back( dist, point( x, y ) );
+        }
+    }
+    return result;
+}
+
+void overmapbuffer::for_each_terrain_candidate( const overmap &om, const int min_z,
+        const int max_z, const std::vector<bool> &types, const omt_find_params &params,
+        const std::function<void( const tripoint & )> &callback )
+{
+    const tripoint base( om.global_base_point(), 0 );
+    if( params.om_special ) {
+        // Each special only covers a few tiles, far fewer than any terrain type.
+        for( const auto &placement : om.overmap_special_placements ) {
+            const tripoint &local = placement.first;
+            if( placement.second == *params.om_special && local.z >= min_z && local.z <= max_z &&
+                types[om.get_ter( local ).to_i()] ) {
+                callback( base + local );
+            }
+        }
+        return;
+    }
+    for( int z = min_z; z <= max_z; z++ ) {
+        om.for_each_terrain( z, types, [&]( const tripoint & local ) {
+            callback( base + local );
+        } );
+    }
+}
+
 tripoint overmapbuffer::find_closest( const tripoint &origin, const omt_find_params &params )
 {
     // Check the origin before searching adjacent tiles!
@@ -939,39 +1127,40 @@ tripoint overmapbuffer::find_closest( const tripoint &origin, const omt_find_par
     // and each additional one expends the search to the next concentric circle of overmaps.
     int max = params.search_range ? params.search_range : OMAPX * 5;
     const int min_distance = std::max( 0, params.min_distance );
-    // expanding box
-    for( int dist = min_distance; dist <= max; dist++ ) {
-        // each edge length is 2*dist-2, because corners belong to one edge
-        // south is +y, north is -y
-        for( int i = min_distance * 2; i < dist * 2; i++ ) {
-            for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
-                //start at northwest, scan north edge
-                const tripoint n_loc( origin.x - dist + i, origin.y - dist, z );
-                if( is_findable_location( n_loc, params ) ) {
-                    return n_loc;
-                }
-
-                //start at southeast, scan south
-                const tripoint s_loc( origin.x + dist - i, origin.y + dist, z );
-                if( is_findable_location( s_loc, params ) ) {
-                    return s_loc;
-                }
-
-                //start at southwest, scan west
-                const tripoint w_loc( origin.x - dist, origin.y + dist - i, z );
-                if( is_findable_location( w_loc, params ) ) {
-                    return w_loc;
-                }
-
-                //start at northeast, scan east
-                const tripoint e_loc( origin.x + dist, origin.y - dist + i, z );
-                if( is_findable_location( e_loc, params ) ) {
-                    return e_loc;
-                }
-            }
+    const std::vector<bool> types = matching_terrain_types( params );
+
+    // Instead of looking at every tile, ask each overmap for the tiles with a matching
+    // terrain type, starting with the closest overmap. Overmaps that are further away
+    // than the best match so far are not looked at (nor created).
+    std::vector<std::pair<int, point>> oms = overmaps_in_range( origin, max );
+    std::stable_sort( oms.begin(), oms.end(), []( const std::pair<int, point> &a,
+    const std::pair<int, point> &b ) {
+        return a.first < b.first;
+    } );
+    tripoint result = overmap::invalid_tripoint;
+    int result_dist = max + 1;
+    for( const std::pair<int, point> &entry : oms ) {
+        if( entry.first >= result_dist ) {
+            break;
+        }
+        overmap *om = params.existing_only ? get_existing( entry.second.x, entry.second.y ) :
+                      &get( entry.second.x, entry.second.y );
+        if( om == nullptr ) {
+            continue;
         }
+        for_each_terrain_candidate( *om, -OVERMAP_DEPTH, OVERMAP_HEIGHT, types, params,
+        [&]( const tripoint & loc ) {
+            const int dist = square_dist( origin.x, origin.y, loc.x, loc.y );
+            if( dist < min_distance || dist >= result_dist ) {
+                return;
+            }
+            if( is_findable_location( loc, params ) ) {
+                result = loc;
+                result_dist = dist;
+            }
+        } );
     }
-    return overmap::invalid_tripoint;
+    return result;
 }
 
 std::vector<tripoint> overmapbuffer::find_all( const tripoint &origin,
@@ -981,17 +1170,23 @@ std::vector<tripoint> overmapbuffer::find_all( const tripoint &origin,
     // dist == 0 means search a whole overmap diameter.
     const int dist = params.search_range ? params.search_range : OMAPX;
     const int min_distance = std::max( 0, params.min_distance );
-    for( int x = -dist; x <= dist; x++ ) {
-        for( int y = -dist; y <= dist; y++ ) {
-            if( abs( x ) < min_distance && abs( y ) < min_distance ) {
-                continue;
-            }
-            const tripoint search_loc( origin.x + x, origin.y + y, origin.z );
-            if( is_findable_location( search_loc, params ) ) {
-                result.push_back( search_loc );
-            }
+    const std::vector<bool> types = matching_terrain_types( params );
+    for( const std::pair<int, point> &entry : overmaps_in_range( origin, dist ) ) {
+        overmap *om = params.existing_only ? get_existing( entry.second.x, entry.second.y ) :
+                      &get( entry.second.x, entry.second.y );
+        if( om == nullptr ) {
+            continue;
         }
+        for_each_terrain_candidate( *om, origin.z, origin.z, types, params,
+        [&]( const tripoint & loc ) {
+            const int loc_dist = square_dist( origin.x, origin.y, loc.x, loc.y );
+            if( loc_dist >= min_distance && loc_dist <= dist && is_findable_location( loc, params ) ) {
+                result.push_back( loc );
+            }
+        } );
     }
+    // Same order as scanning the area column by column.
+    std::sort( result.begin(), result.end() );
     return result;
 }
 std::vector<tripoint> overmapbuffer::find_all( const tripoint &origin, const std::string &type,
@@ -119,15 +119,28 @@ class overmapbuffer
         void save();
         void clear();
         void create_custom_overmap( const int x, const int y, overmap_special_batch &specials );
+        /**
+         * Queues the overmaps next to the one containing @p omt_pos (global overmap
+         * terrain coordinates) that do not exist yet to be generated in the background
+         * (see @ref overmap_pregen), if @p omt_pos is close to them and @p heading
+         * (e.g. the direction of the last map shift) does not point away from them.
+         * Also adds the overmaps that finished generating to the buffer.
+         */
+        void pregenerate_near( const tripoint &omt_pos, const point &heading );
 
         /**
          * Uses global overmap terrain coordinates, creates the
          * overmap if needed.
          */
-        oter_id &ter( int x, int y, int z );
-        oter_id &ter( const tripoint &p ) {
+        const oter_id ter( int x, int y, int z );
+        const oter_id ter( const tripoint &p ) {
             return ter( p.x, p.y, p.z );
         }
+        /**
+         * Changes the terrain at @p p (global overmap terrain coordinates),
+         * creates the overmap if needed.
+         */
+        void ter_set( const tripoint &p, const oter_id &id );
         /**
          * Uses global overmap terrain coordinates.
          */
@@ -389,6 +402,12 @@ class overmapbuffer
          * therefor you should probably call @ref map::spawn_monsters to spawn them.
          */
         void move_hordes();
+        /**
+         * Lets the hordes of the given overmaps move a step. With the "PARALLEL_HORDES"
+         * option they are planned on several threads, each overmap with its own seed
+         * drawn from the calling thread's random engine.
+         */
+        void move_hordes( const std::vector<overmap *> &overmaps );
         // hordes -- this uses overmap terrain coordinates!
         std::vector<mongroup *> monsters_at( int x, int y, int z );
         /**
@@ -474,6 +493,17 @@ class overmapbuffer
          * see omt_find_params for definitions of the terms
          */
         bool is_findable_location( const tripoint &location, const omt_find_params &params );
+        /**
+         * Calls @p callback with the global coordinates of every location on the
+         * z-levels @p min_z to @p max_z of @p om whose terrain is one of @p types
+         * (see @ref overmap::for_each_terrain). When the search is for a specific
+         * overmap special, only the locations of that special are visited.
+         * The callback still needs to check the remaining criteria with
+         * @ref is_findable_location.
+         */
+        void for_each_terrain_candidate( const overmap &om, int min_z, int max_z,
+                                         const std::vector<bool> &types, const omt_find_params &params,
+                                         const std::function<void( const tripoint & )> &callback );
 
         std::unordered_map< point, std::unique_ptr< overmap > > overmaps;
         /**
@@ -520,6 +550,14 @@ class overmapbuffer
          * Moves out-of-bounds NPCs to the overmaps they should be in.
          */
         void fix_npcs( overmap &new_overmap );
+        /** Adds an overmap that was generated in the background to the buffer. */
+        void add_pregenerated( std::unique_ptr<overmap> new_overmap );
+        /**
+         * Makes sure that neither the overmap at @p p nor its neighbours are still
+         * being generated in the background, so a new overmap there sees its
+         * neighbours (or is the one generated in the background).
+         */
+        void finish_pregenerating( const point &p );
         /**
          * Retrieve overmaps that overlap the bounding box defined by the location and radius.
          * The location is in absolute submap coordinates, the radius is in the same system.
@@ -0,0 +1,183 @@
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+namespace cata
+{
+
+/** Set by @ref scoped_worker_count, 0 if not overridden. */
+static thread_local unsigned int worker_count_override = 0;
+
+unsigned int parallel_worker_count()
+{
+    if( worker_count_override != 0 ) {
+        return worker_count_override;
+    }
+    // Beyond this the loops we run mostly compete for memory bandwidth.
+    static constexpr unsigned int max_workers = 8;
+    static const unsigned int workers = std::max( 1u, std::min( max_workers,
+                                        std::thread::hardware_concurrency() ) );
+    return workers;
+}
+
+scoped_worker_count::scoped_worker_count( const unsigned int count ) :
+    previous( worker_count_override )
+{
+    worker_count_override = std::max( 1u, count );
+}
+
+scoped_worker_count::~scoped_worker_count()
+{
+    worker_count_override = previous;
+}
+
+namespace
+{
+
+/** Set on threads that are running a loop body, so nested loops run serially. */
+thread_local bool in_parallel_loop = false;
+
+/** One parallel_for call, shared by the calling thread and the helping workers. */
+struct loop_job {
+    const std::function<void( size_t )> *fn = nullptr;
+    size_t count = 0;
+    std::atomic<size_t> next{ 0 };
+    std::atomic<bool> failed{ false };
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    void work() {
+        in_parallel_loop = true;
+        while( !failed ) {
+            const size_t i = next++;
+            if( i >= count ) {
+                break;
+            }
+            try {
+                ( *fn )( i );
+            } catch( ... ) {
+                std::lock_guard<std::mutex> lock( error_mutex );
+                if( !error ) {
+                    error = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+        in_parallel_loop = false;
+    }
+};
+
+/**
+ * Threads that are started once and then help with every parallel_for call,
+ * instead of starting new threads for each loop.
+ */
+class worker_pool
+{
+    public:
+        /**
+         * Runs @p job on the calling thread and @p helpers workers.
+         * Returns false without running anything if another thread is using the pool.
+         */
+        bool run( loop_job &job, const size_t helpers ) {
+            std::unique_lock<std::mutex> run_lock( run_mutex, std::try_to_lock );
+            if( !run_lock.owns_lock() ) {
+                return false;
+            }
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                while( workers.size() < helpers ) {
+                    workers.emplace_back( &worker_pool::run_worker, this, workers.size() );
+                }
+                current = &job;
+                current_helpers = helpers;
+                busy_helpers = helpers;
+                generation++;
+            }
+            job_changed.notify_all();
+            // The calling thread takes part as well.
+            job.work();
+            std::unique_lock<std::mutex> lock( mutex );
+            job_done.wait( lock, [this]() {
+                return busy_helpers == 0;
+            } );
+            current = nullptr;
+            return true;
+        }
+
+    private:
+        void run_worker( const size_t index ) {
+            unsigned long long seen_generation = 0;
+            std::unique_lock<std::mutex> lock( mutex );
+            while( true ) {
+                job_changed.wait( lock, [&]() {
+                    return generation != seen_generation;
+                } );
+                seen_generation = generation;
+                if( index >= current_helpers ) {
+                    continue;
+                }
+                loop_job &job = *current;
+                lock.unlock();
+                job.work();
+                lock.lock();
+                if( --busy_helpers == 0 ) {
+                    job_done.notify_all();
+                }
+            }
+        }
+
+        /** Held for a whole parallel_for call, there's only one job at a time. */
+        std::mutex run_mutex;
+        std::mutex mutex;
+        /** Signaled when a new job is available. */
+        std::condition_variable job_changed;
+        /** Signaled when the last helper finished its part of the job. */
+        std::condition_variable job_done;
+        loop_job *current = nullptr;
+        size_t current_helpers = 0;
+        size_t busy_helpers = 0;
+        unsigned long long generation = 0;
+        std::vector<std::thread> workers;
+};
+
+worker_pool &get_pool()
+{
+    // Never destroyed, the workers wait for jobs until the process exits.
+    static worker_pool &pool = *new worker_pool();
+    return pool;
+}
+
+} // namespace
+
+void parallel_for( const size_t count, const std::function<void( size_t )> &fn,
+                   const size_t min_per_thread )
+{
+    const size_t threads = std::min<size_t>( parallel_worker_count(),
+                           count / std::max<size_t>( min_per_thread, 1 ) );
+    loop_job job;
+    job.fn = &fn;
+    job.count = count;
+    // Loops inside a loop body, or started by another thread while the pool is
+    // busy, run on their own thread.
+    if( threads < 2 || in_parallel_loop || !get_pool().run( job, threads - 1 ) ) {
+        for( size_t i = 0; i < count; i++ ) {
+            fn( i );
+        }
+        return;
+    }
+    if( job.error ) {
+        std::rethrow_exception( job.error );
+    }
+}
+
+} // namespace cata
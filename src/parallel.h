@@ -0,0 +1,48 @@
+#pragma once
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace cata
+{
+
+/**
+ * Number of threads (including the calling one) that @ref parallel_for uses at most.
+ * Derived from the hardware concurrency, always at least 1.
+ */
+unsigned int parallel_worker_count();
+
+/**
+ * Overrides @ref parallel_worker_count on the calling thread while it exists,
+ * so tests can compare serial and parallel results on any machine.
+ */
+class scoped_worker_count
+{
+    public:
+        explicit scoped_worker_count( unsigned int count );
+        ~scoped_worker_count();
+        scoped_worker_count( const scoped_worker_count & ) = delete;
+        scoped_worker_count &operator=( const scoped_worker_count & ) = delete;
+
+    private:
+        unsigned int previous;
+};
+
+/**
+ * Calls `fn( i )` for every `i` in `[0, count)`, distributed over up to
+ * @ref parallel_worker_count threads, and returns when all calls have finished.
+ * The order of the calls is unspecified, so `fn` must only read shared state and
+ * write to data owned by its index.
+ * Loops of fewer than `min_per_thread * 2` elements run on the calling thread only.
+ * If any call throws, the first exception is rethrown on the calling thread.
+ * The worker threads are started once and reused. Loops started from a loop body,
+ * or from another thread while a loop is running, run on the calling thread only.
+ */
+void parallel_for( size_t count, const std::function<void( size_t )> &fn,
+                   size_t min_per_thread = 16 );
+
+} // namespace cata
+
+#endif
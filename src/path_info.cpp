@@ -107,6 +107,8 @@ void PATH_INFO::update_config_dir()
     update_pathname( "panel_options", FILENAMES["config_dir"] + "panel_options.json" );
     update_pathname( "keymap", FILENAMES["config_dir"] + "keymap.txt" );
     update_pathname( "debug", FILENAMES["config_dir"] + "debug.log" );
+    update_pathname( "turn_profile_csv", FILENAMES["config_dir"] + "turn_profile.csv" );
+    update_pathname( "turn_profile_json", FILENAMES["config_dir"] + "turn_profile.json" );
     update_pathname( "crash", FILENAMES["config_dir"] + "crash.log" );
     update_pathname( "fontlist", FILENAMES["config_dir"] + "fontlist.txt" );
     update_pathname( "fontdata", FILENAMES["config_dir"] + "fonts.json" );
@@ -188,6 +190,8 @@ void PATH_INFO::set_standard_filenames()
     update_pathname( "keymap", FILENAMES["config_dir"] + "keymap.txt" );
     update_pathname( "user_keybindings", FILENAMES["config_dir"] + "keybindings.json" );
     update_pathname( "debug", FILENAMES["config_dir"] + "debug.log" );
+    update_pathname( "turn_profile_csv", FILENAMES["config_dir"] + "turn_profile.csv" );
+    update_pathname( "turn_profile_json", FILENAMES["config_dir"] + "turn_profile.json" );
     update_pathname( "crash", FILENAMES["config_dir"] + "crash.log" );
     update_pathname( "fontlist", FILENAMES["config_dir"] + "fontlist.txt" );
     update_pathname( "fontdata", FILENAMES["config_dir"] + "fonts.json" );
@@ -2,8 +2,9 @@
 
 #include <cstdlib>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <algorithm>
-#include <queue>
 #include <set>
 #include <array>
 #include <memory>
@@ -39,85 +40,128 @@ constexpr int flat_index( const int x, const int y )
 }
 
 // Flattened 2D array representing a single z-level worth of pathfinding data
+// Layers are reused by all searches of a thread. Instead of clearing the states before
+// every search, each search gets a new number and states written by earlier searches
+// read as ASL_NONE.
 struct path_data_layer {
     // State is accessed way more often than all other values here
-    std::array< astar_state, MAPSIZE_X *MAPSIZE_Y > state;
+    // The upper bits hold the number of the search that set the state.
+    std::array< uint32_t, MAPSIZE_X *MAPSIZE_Y > state;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > score;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > gscore;
     std::array< tripoint, MAPSIZE_X *MAPSIZE_Y > parent;
+    uint32_t search = 0;
 
-    void init( const int minx, const int miny, const int maxx, const int maxy ) {
-        for( int x = minx; x <= maxx; x++ ) {
-            for( int y = miny; y <= maxy; y++ ) {
-                const int ind = flat_index( x, y );
-                state[ind] = ASL_NONE; // Mark as unvisited
-            }
+    void new_search() {
+        search++;
+        if( search >= ( 1u << 30 ) ) {
+            state.fill( 0 );
+            search = 1;
         }
     }
-};
 
-struct pathfinder {
-    int minx;
-    int miny;
-    int maxx;
-    int maxy;
-    pathfinder( int _minx, int _miny, int _maxx, int _maxy ) :
-        minx( _minx ), miny( _miny ), maxx( _maxx ), maxy( _maxy ) {
+    astar_state get_state( const int index ) const {
+        const uint32_t value = state[index];
+        return ( value >> 2 ) == search ? static_cast<astar_state>( value & 3 ) : ASL_NONE;
     }
 
-    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >
-    open;
+    void set_state( const int index, const astar_state new_state ) {
+        state[index] = ( search << 2 ) | new_state;
+    }
+};
+
+struct pathfinder {
+    int minx = 0;
+    int miny = 0;
+    int minz = 0;
+    int maxx = 0;
+    int maxy = 0;
+    int maxz = 0;
+    // If set, only the clusters (submaps) marked in `allowed` may be entered
+    bool restricted = false;
+    bool allowed[OVERMAP_LAYERS][MAPSIZE][MAPSIZE];
+
+    // Binary heap, a vector keeps its capacity between searches
+    std::vector< std::pair<int, tripoint> > open;
     std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
+    // Layers already part of the current search
+    std::array< bool, OVERMAP_LAYERS > in_use;
+
+    void reset( const int _minx, const int _miny, const int _minz,
+                const int _maxx, const int _maxy, const int _maxz ) {
+        minx = _minx;
+        miny = _miny;
+        minz = _minz;
+        maxx = _maxx;
+        maxy = _maxy;
+        maxz = _maxz;
+        restricted = false;
+        open.clear();
+        in_use.fill( false );
+    }
 
     path_data_layer &get_layer( const int z ) {
         auto &ptr = path_data[z + OVERMAP_DEPTH];
-        if( ptr != nullptr ) {
-            return *ptr;
+        if( ptr == nullptr ) {
+            ptr = std::make_unique<path_data_layer>();
+        }
+        if( !in_use[z + OVERMAP_DEPTH] ) {
+            in_use[z + OVERMAP_DEPTH] = true;
+            ptr->new_search();
         }
-
-        ptr = std::make_unique<path_data_layer>();
-        ptr->init( minx, miny, maxx, maxy );
         return *ptr;
     }
 
+    bool in_bounds( const tripoint &p ) const {
+        if( p.x < minx || p.x >= maxx || p.y < miny || p.y >= maxy ) {
+            return false;
+        }
+        return !restricted || allowed[p.z + OVERMAP_DEPTH][p.x / SEEX][p.y / SEEY];
+    }
+
     bool empty() const {
         return open.empty();
     }
 
     tripoint get_next() {
-        const auto pt = open.top();
-        open.pop();
-        return pt.second;
+        std::pop_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+        const tripoint next = open.back().second;
+        open.pop_back();
+        return next;
     }
 
     void add_point( const int gscore, const int score, const tripoint &from, const tripoint &to ) {
         auto &layer = get_layer( to.z );
         const int index = flat_index( to.x, to.y );
-        if( ( layer.state[index] == ASL_OPEN && gscore >= layer.gscore[index] ) ||
-            layer.state[index] == ASL_CLOSED ) {
+        const astar_state state = layer.get_state( index );
+        if( ( state == ASL_OPEN && gscore >= layer.gscore[index] ) || state == ASL_CLOSED ) {
             return;
         }
 
-        layer.state [index] = ASL_OPEN;
+        layer.set_state( index, ASL_OPEN );
         layer.gscore[index] = gscore;
         layer.parent[index] = from;
         layer.score [index] = score;
-        open.push( std::make_pair( score, to ) );
+        open.emplace_back( score, to );
+        std::push_heap( open.begin(), open.end(), pair_greater_cmp_first() );
     }
 
     void close_point( const tripoint &p ) {
-        auto &layer = get_layer( p.z );
-        const int index = flat_index( p.x, p.y );
-        layer.state[index] = ASL_CLOSED;
+        get_layer( p.z ).set_state( flat_index( p.x, p.y ), ASL_CLOSED );
     }
 
     void unclose_point( const tripoint &p ) {
-        auto &layer = get_layer( p.z );
-        const int index = flat_index( p.x, p.y );
-        layer.state[index] = ASL_NONE;
+        get_layer( p.z ).set_state( flat_index( p.x, p.y ), ASL_NONE );
     }
 };
 
+// Every thread keeps its own workspace, so the layers are only allocated once
+static pathfinder &get_pathfinder()
+{
+    static thread_local pathfinder pf;
+    return pf;
+}
+
 // Modifies `t` to be a tile with `flag` in the overmap tile that `t` was originally on
 // return false if it could not find a suitable point
 template<ter_bitflags flag>
@@ -181,6 +225,276 @@ bool is_disjoint( const Set1 &set1, const Set2 &set2 )
     return true;
 }
 
+constexpr short pathfinding_regions::no_region;
+constexpr int flow_field::unreachable;
+
+void pathfinding_regions::build( const pathfinding_cache &cache, const int mapsize )
+{
+    regions.clear();
+    std::fill_n( &tile_region[0][0], MAPSIZE_X * MAPSIZE_Y, no_region );
+
+    constexpr std::array<int, 8> x_offset{{ -1,  1,  0,  0,  1, -1, -1, 1 }};
+    constexpr std::array<int, 8> y_offset{{  0,  0, -1,  1, -1,  1, -1, 1 }};
+    const auto is_wall = [&cache]( const int x, const int y ) {
+        return ( cache.special[x][y] & PF_WALL ) != PF_NORMAL;
+    };
+
+    // Flood fill every submap on its own
+    std::vector<point> todo;
+    for( int smx = 0; smx < mapsize; smx++ ) {
+        for( int smy = 0; smy < mapsize; smy++ ) {
+            const int minx = smx * SEEX;
+            const int miny = smy * SEEY;
+            for( int x = minx; x < minx + SEEX; x++ ) {
+                for( int y = miny; y < miny + SEEY; y++ ) {
+                    if( tile_region[x][y] != no_region || is_wall( x, y ) ) {
+                        continue;
+                    }
+                    const short id = static_cast<short>( regions.size() );
+                    regions.emplace_back();
+                    region &reg = regions.back();
+                    reg.cluster = point( smx, smy );
+                    tile_region[x][y] = id;
+                    todo.emplace_back( x, y );
+                    while( !todo.empty() ) {
+                        const point cur = todo.back();
+                        todo.pop_back();
+                        reg.updown = reg.updown || ( cache.special[cur.x][cur.y] & PF_UPDOWN );
+                        for( size_t i = 0; i < 8; i++ ) {
+                            const point p( cur.x + x_offset[i], cur.y + y_offset[i] );
+                            if( p.x >= minx && p.x < minx + SEEX && p.y >= miny && p.y < miny + SEEY &&
+                                tile_region[p.x][p.y] == no_region && !is_wall( p.x, p.y ) ) {
+                                tile_region[p.x][p.y] = id;
+                                todo.push_back( p );
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Link regions that are a single step apart, each pair of tiles is checked once
+    constexpr std::array<int, 4> x_forward{{ 1, 1, 1, 0 }};
+    constexpr std::array<int, 4> y_forward{{ -1, 0, 1, 1 }};
+    const int size_x = mapsize * SEEX;
+    const int size_y = mapsize * SEEY;
+    for( int x = 0; x < size_x; x++ ) {
+        for( int y = 0; y < size_y; y++ ) {
+            const short from = tile_region[x][y];
+            if( from == no_region ) {
+                continue;
+            }
+            for( size_t i = 0; i < 4; i++ ) {
+                const int px = x + x_forward[i];
+                const int py = y + y_forward[i];
+                if( px < 0 || px >= size_x || py < 0 || py >= size_y ) {
+                    continue;
+                }
+                const short to = tile_region[px][py];
+                if( to != no_region && to != from ) {
+                    regions[from].neighbors.push_back( to );
+                    regions[to].neighbors.push_back( from );
+                }
+            }
+        }
+    }
+    for( region &reg : regions ) {
+        std::sort( reg.neighbors.begin(), reg.neighbors.end() );
+        reg.neighbors.erase( std::unique( reg.neighbors.begin(), reg.neighbors.end() ),
+                             reg.neighbors.end() );
+    }
+}
+
+const pathfinding_regions &map::get_pathfinding_regions( const int zlev ) const
+{
+    // Makes sure the special flags are up to date
+    get_pathfinding_cache_ref( zlev );
+    auto &cache = get_pathfinding_cache( zlev );
+    if( cache.regions_dirty ) {
+        cache.regions.build( cache, my_MAPSIZE );
+        cache.regions_dirty = false;
+    }
+    return cache.regions;
+}
+
+// Routes at least this long are first planned on the pathfinding regions
+static constexpr int hierarchical_route_distance = SEEX * 2;
+
+// Searches a chain of pathfinding regions from f to t, within the z-levels [pf.minz, pf.maxz],
+// and restricts pf to the submaps of that chain and the submaps around them.
+// Returns false (and leaves pf unrestricted) if the regions don't connect f and t.
+static bool plan_corridor( const map &m, const tripoint &f, const tripoint &t,
+                           const pathfinding_settings &settings, pathfinder &pf )
+{
+    // All regions of all z-levels get consecutive node numbers
+    std::array<const pathfinding_regions *, OVERMAP_LAYERS> levels{{}};
+    std::array<int, OVERMAP_LAYERS> first_node{{}};
+    int num_nodes = 0;
+    for( int z = pf.minz; z <= pf.maxz; z++ ) {
+        levels[z + OVERMAP_DEPTH] = &m.get_pathfinding_regions( z );
+        first_node[z + OVERMAP_DEPTH] = num_nodes;
+        num_nodes += levels[z + OVERMAP_DEPTH]->regions.size();
+    }
+    const auto node_at = [&]( const tripoint & p ) {
+        const short reg = levels[p.z + OVERMAP_DEPTH]->tile_region[p.x][p.y];
+        return reg == pathfinding_regions::no_region ? -1 : first_node[p.z + OVERMAP_DEPTH] + reg;
+    };
+    const int start = node_at( f );
+    const int goal = node_at( t );
+    if( start < 0 || goal < 0 ) {
+        return false;
+    }
+    const auto node_z = [&]( const int node ) {
+        int z = pf.maxz;
+        while( first_node[z + OVERMAP_DEPTH] > node ) {
+            z--;
+        }
+        return z;
+    };
+    const auto node_region = [&]( const int node, const int z ) -> const pathfinding_regions::region & {
+        return levels[z + OVERMAP_DEPTH]->regions[node - first_node[z + OVERMAP_DEPTH]];
+    };
+
+    // A* over the regions, a step to a neighboring submap costs as much as crossing it on flat ground
+    constexpr int step_cost = 2 * SEEX;
+    const point goal_cluster = node_region( goal, t.z ).cluster;
+    const bool vertical = m.has_zlevels() && settings.allow_climb_stairs && pf.minz != pf.maxz;
+    std::vector<int> gscore( num_nodes, std::numeric_limits<int>::max() );
+    std::vector<int> parent( num_nodes, -1 );
+    std::vector< std::pair<int, int> > open;
+    gscore[start] = 0;
+    open.emplace_back( 0, start );
+    bool found = false;
+    while( !open.empty() ) {
+        std::pop_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+        const int cur = open.back().second;
+        const int cur_score = open.back().first;
+        open.pop_back();
+        if( cur == goal ) {
+            found = true;
+            break;
+        }
+        const int z = node_z( cur );
+        const auto &reg = node_region( cur, z );
+        if( cur_score > gscore[cur] + step_cost * rl_dist( reg.cluster, goal_cluster ) ) {
+            // Stale entry
+            continue;
+        }
+        const auto try_node = [&]( const int next, const point & cluster, const int cost ) {
+            const int g = gscore[cur] + cost;
+            if( g < gscore[next] ) {
+                gscore[next] = g;
+                parent[next] = cur;
+                open.emplace_back( g + step_cost * rl_dist( cluster, goal_cluster ), next );
+                std::push_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+            }
+        };
+        for( const int neighbor : reg.neighbors ) {
+            const int next = first_node[z + OVERMAP_DEPTH] + neighbor;
+            const point &cluster = node_region( next, z ).cluster;
+            try_node( next, cluster, step_cost * rl_dist( reg.cluster, cluster ) );
+        }
+        if( !vertical || !reg.updown ) {
+            continue;
+        }
+        // Stairs lead somewhere into the same overmap tile, which is at most one submap away
+        for( const int other_z : { z - 1, z + 1 } ) {
+            if( other_z < pf.minz || other_z > pf.maxz ) {
+                continue;
+            }
+            const auto &other_regions = levels[other_z + OVERMAP_DEPTH]->regions;
+            for( size_t i = 0; i < other_regions.size(); i++ ) {
+                if( other_regions[i].updown && rl_dist( reg.cluster, other_regions[i].cluster ) <= 1 ) {
+                    try_node( first_node[other_z + OVERMAP_DEPTH] + i, other_regions[i].cluster, 2 );
+                }
+            }
+        }
+    }
+    if( !found ) {
+        return false;
+    }
+
+    std::fill_n( &pf.allowed[0][0][0], OVERMAP_LAYERS * MAPSIZE * MAPSIZE, false );
+    const int mapsize = m.getmapsize();
+    for( int node = goal; node >= 0; node = parent[node] ) {
+        const int z = node_z( node );
+        const point &cluster = node_region( node, z ).cluster;
+        for( int x = std::max( cluster.x - 1, 0 ); x <= std::min( cluster.x + 1, mapsize - 1 ); x++ ) {
+            for( int y = std::max( cluster.y - 1, 0 ); y <= std::min( cluster.y + 1, mapsize - 1 ); y++ ) {
+                pf.allowed[z + OVERMAP_DEPTH][x][y] = true;
+            }
+        }
+    }
+    pf.restricted = true;
+    return true;
+}
+
+// Whether a route found for `cached` is also valid for `q`, apart from the start point
+static bool same_route_conditions( const route_cache::query &cached, const route_cache::query &q )
+{
+    if( cached.to != q.to || cached.abs_sub != q.abs_sub || cached.settings != q.settings ||
+        cached.pre_closed != q.pre_closed ) {
+        return false;
+    }
+    // Only the z-levels the search could have used matter
+    const int minz = std::min( cached.from.z, cached.to.z );
+    const int maxz = std::max( cached.from.z, cached.to.z );
+    for( int z = minz; z <= maxz; z++ ) {
+        if( cached.generations[z + OVERMAP_DEPTH] != q.generations[z + OVERMAP_DEPTH] ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool route_cache::find( const query &q, std::vector<tripoint> &route )
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    for( entry &e : entries ) {
+        if( !same_route_conditions( e.key, q ) ) {
+            continue;
+        }
+        if( e.key.from == q.from ) {
+            route = e.route;
+        } else {
+            // Every part of a shortest route is a shortest route as well
+            const auto start = std::find( e.route.begin(), e.route.end(), q.from );
+            if( start == e.route.end() ) {
+                continue;
+            }
+            route.assign( start + 1, e.route.end() );
+        }
+        e.last_used = ++clock;
+        return true;
+    }
+    return false;
+}
+
+void route_cache::add( const query &q, const std::vector<tripoint> &route )
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    entry *target = nullptr;
+    if( entries.size() < capacity ) {
+        entries.emplace_back();
+        target = &entries.back();
+    } else {
+        target = &*std::min_element( entries.begin(), entries.end(),
+        []( const entry & lhs, const entry & rhs ) {
+            return lhs.last_used < rhs.last_used;
+        } );
+    }
+    target->key = q;
+    target->route = route;
+    target->last_used = ++clock;
+}
+
+void route_cache::clear()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    entries.clear();
+}
+
 std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                   const pathfinding_settings &settings,
                                   const std::set<tripoint> &pre_closed ) const
@@ -222,28 +536,168 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return ret;
     }
 
-    int max_length = settings.max_length;
-    int bash = settings.bash_strength;
-    int climb_cost = settings.climb_cost;
-    bool doors = settings.allow_open_doors;
-    bool trapavoid = settings.avoid_traps;
-    bool roughavoid = settings.avoid_rough_terrain;
+    route_cache::query query;
+    query.abs_sub = abs_sub;
+    query.from = f;
+    query.to = t;
+    query.settings = settings;
+    query.pre_closed = pre_closed;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        query.generations[z + OVERMAP_DEPTH] = get_pathfinding_cache( z ).generation;
+    }
+    if( routes->find( query, ret ) ) {
+        return ret;
+    }
+
+    pathfinder &pf = get_pathfinder();
+    const int minz = std::min( f.z, t.z ); // TODO: Make this way bigger
+    const int maxz = std::max( f.z, t.z ); // Same TODO: as above
+
+    // Long routes are searched only along the submaps the pathfinding regions lead through,
+    // which is a small part of the whole map. If that doesn't work out, fall back to the
+    // plain search around the start and the destination.
+    // The regions don't go through PF_WALL tiles, so they only fit creatures that can't
+    // bash, open doors or climb through them either.
+    const bool walls_block = settings.bash_strength <= 0 && !settings.allow_open_doors &&
+                             settings.climb_cost <= 0;
+    if( walls_block && rl_dist( f, t ) >= hierarchical_route_distance ) {
+        pf.reset( 0, 0, minz, SEEX * my_MAPSIZE, SEEY * my_MAPSIZE, maxz );
+        if( plan_corridor( *this, f, t, settings, pf ) &&
+            route_search( f, t, settings, pre_closed, pf, ret ) ) {
+            routes->add( query, ret );
+            return ret;
+        }
+        ret.clear();
+    }
 
     const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
     int minx = std::min( f.x, t.x ) - pad;
     int miny = std::min( f.y, t.y ) - pad;
-    int minz = std::min( f.z, t.z ); // TODO: Make this way bigger
     int maxx = std::max( f.x, t.x ) + pad;
     int maxy = std::max( f.y, t.y ) + pad;
-    int maxz = std::max( f.z, t.z ); // Same TODO: as above
-    clip_to_bounds( minx, miny, minz );
-    clip_to_bounds( maxx, maxy, maxz );
+    clip_to_bounds( minx, miny );
+    clip_to_bounds( maxx, maxy );
+
+    pf.reset( minx, miny, minz, maxx, maxy, maxz );
+    route_search( f, t, settings, pre_closed, pf, ret );
+    routes->add( query, ret );
+    return ret;
+}
+
+int map::step_cost( const tripoint *from, const tripoint &p, const pf_special p_special,
+                    const pathfinding_settings &settings ) const
+{
+    static const auto non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP;
+    const int bash = settings.bash_strength;
+    const int climb_cost = settings.climb_cost;
+    const bool doors = settings.allow_open_doors;
+
+    // TODO: De-uglify, de-huge-n
+    if( !( p_special & non_normal ) ) {
+        // Boring flat dirt - the most common case above the ground
+        return 2;
+    }
+    if( settings.avoid_rough_terrain ) {
+        return PF_STEP_BLOCKED;
+    }
+
+    int part = -1;
+    const maptile &tile = maptile_at_internal( p );
+    const auto &terrain = tile.get_ter_t();
+    const auto &furniture = tile.get_furn_t();
+    const vehicle *veh = veh_at_internal( p, part );
+
+    const int cost = move_cost_internal( furniture, terrain, veh, part );
+    // Don't calculate bash rating unless we intend to actually use it
+    const int rating = ( bash == 0 || cost != 0 ) ? -1 :
+                       bash_rating_internal( bash, furniture, terrain, false, veh, part );
+
+    if( cost == 0 && rating <= 0 && ( !doors || !terrain.open ) && veh == nullptr && climb_cost <= 0 ) {
+        return PF_STEP_BLOCKED;
+    }
+
+    int result = cost;
+    if( cost == 0 ) {
+        if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
+            // Climbing fences
+            result += climb_cost;
+        } else if( doors && terrain.open && ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) ||
+                                              ( from != nullptr && !is_outside( *from ) ) ) ) {
+            // Only try to open INSIDE doors from the inside
+            // To open and then move onto the tile
+            result += 4;
+        } else if( veh != nullptr ) {
+            const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
+            part = vpobst ? vpobst->part_index() : -1;
+            int dummy = -1;
+            if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
+                ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
+                  ( from != nullptr && veh_at_internal( *from, dummy ) == veh ) ) ) {
+                // Handle car doors, but don't try to path through curtains
+                result += 10; // One turn to open, 4 to move there
+            } else if( part >= 0 && bash > 0 ) {
+                // Car obstacle that isn't a door
+                // TODO: Account for armor
+                int hp = veh->parts[part].hp();
+                if( hp / 20 > bash ) {
+                    // Threshold damage thing means we just can't bash this down
+                    return PF_STEP_BLOCKED;
+                } else if( hp / 10 > bash ) {
+                    // Threshold damage thing means we will fail to deal damage pretty often
+                    hp *= 2;
+                }
+
+                result += 2 * hp / bash + 8 + 4;
+            } else if( part >= 0 ) {
+                // Won't be openable, don't try from other sides
+                return !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ?
+                       PF_STEP_BLOCKED : PF_STEP_BLOCKED_HERE;
+            }
+        } else if( rating > 1 ) {
+            // Expected number of turns to bash it down, 1 turn to move there
+            // and 5 turns of penalty not to trash everything just because we can
+            result += ( 20 / rating ) + 2 + 10;
+        } else if( rating == 1 ) {
+            // Desperate measures, avoid whenever possible
+            result += 500;
+        } else {
+            // Unbashable and unopenable from here, or anywhere else for that matter
+            return !doors || !terrain.open ? PF_STEP_BLOCKED : PF_STEP_BLOCKED_HERE;
+        }
+    }
+
+    if( settings.avoid_traps && p_special & PF_TRAP ) {
+        const auto &ter_trp = terrain.trap.obj();
+        const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
+        if( !trp.is_benign() ) {
+            // For now make them detect all traps
+            if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
+                // Special case - ledge in z-levels
+                // Warning: really expensive, needs a cache
+                const tripoint below( p.x, p.y, p.z - 1 );
+                if( valid_move( p, below, false, true ) ) {
+                    // Otherwise this would have been a huge fall
+                    return !has_flag( TFLAG_NO_FLOOR, below ) ? PF_STEP_LEDGE : PF_STEP_BLOCKED;
+                }
+            } else {
+                // Otherwise it's walkable
+                result += 500;
+            }
+        }
+    }
+    return result;
+}
+
+bool map::route_search( const tripoint &f, const tripoint &t, const pathfinding_settings &settings,
+                        const std::set<tripoint> &pre_closed, pathfinder &pf,
+                        std::vector<tripoint> &ret ) const
+{
+    int max_length = settings.max_length;
 
-    pathfinder pf( minx, miny, maxx, maxy );
     // Make NPCs not want to path through player
     // But don't make player pathing stop working
     for( const auto &p : pre_closed ) {
-        if( p.x >= minx && p.x < maxx && p.y >= miny && p.y < maxy ) {
+        if( inbounds_z( p.z ) && pf.in_bounds( p ) ) {
             pf.close_point( p );
         }
     }
@@ -260,14 +714,14 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         const int parent_index = flat_index( cur.x, cur.y );
         auto &layer = pf.get_layer( cur.z );
-        auto &cur_state = layer.state[parent_index];
-        if( cur_state == ASL_CLOSED ) {
+        if( layer.get_state( parent_index ) == ASL_CLOSED ) {
             continue;
         }
 
-        if( layer.gscore[parent_index] > max_length ) {
+        const int cur_g = layer.gscore[parent_index];
+        if( cur_g > max_length ) {
             // Shortest path would be too long, return empty vector
-            return std::vector<tripoint>();
+            return true;
         }
 
         if( cur == t ) {
@@ -275,7 +729,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             break;
         }
 
-        cur_state = ASL_CLOSED;
+        layer.set_state( parent_index, ASL_CLOSED );
 
         const auto &pf_cache = get_pathfinding_cache_ref( cur.z );
         const auto cur_special = pf_cache.special[cur.x][cur.y];
@@ -290,137 +744,38 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             const int index = flat_index( p.x, p.y );
 
             // TODO: Remove this and instead have sentinels at the edges
-            if( p.x < minx || p.x >= maxx || p.y < miny || p.y >= maxy ) {
+            if( !pf.in_bounds( p ) ) {
                 continue;
             }
 
-            if( layer.state[index] == ASL_CLOSED ) {
+            const astar_state p_state = layer.get_state( index );
+            if( p_state == ASL_CLOSED ) {
                 continue;
             }
 
             // Penalize for diagonals or the path will look "unnatural"
-            int newg = layer.gscore[parent_index] + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
-
-            const auto p_special = pf_cache.special[p.x][p.y];
-            // TODO: De-uglify, de-huge-n
-            if( !( p_special & non_normal ) ) {
-                // Boring flat dirt - the most common case above the ground
-                newg += 2;
-            } else {
-                if( roughavoid ) {
-                    layer.state[index] = ASL_CLOSED; // Close all rough terrain tiles
-                    continue;
-                }
-
-                int part = -1;
-                const maptile &tile = maptile_at_internal( p );
-                const auto &terrain = tile.get_ter_t();
-                const auto &furniture = tile.get_furn_t();
-                const vehicle *veh = veh_at_internal( p, part );
-
-                const int cost = move_cost_internal( furniture, terrain, veh, part );
-                // Don't calculate bash rating unless we intend to actually use it
-                const int rating = ( bash == 0 || cost != 0 ) ? -1 :
-                                   bash_rating_internal( bash, furniture, terrain, false, veh, part );
-
-                if( cost == 0 && rating <= 0 && ( !doors || !terrain.open ) && veh == nullptr && climb_cost <= 0 ) {
-                    layer.state[index] = ASL_CLOSED; // Close it so that next time we won't try to calculate costs
-                    continue;
-                }
-
-                newg += cost;
-                if( cost == 0 ) {
-                    if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
-                        // Climbing fences
-                        newg += climb_cost;
-                    } else if( doors && terrain.open &&
-                               ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !is_outside( cur ) ) ) {
-                        // Only try to open INSIDE doors from the inside
-                        // To open and then move onto the tile
-                        newg += 4;
-                    } else if( veh != nullptr ) {
-                        const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
-                        part = vpobst ? vpobst->part_index() : -1;
-                        int dummy = -1;
-                        if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
-                            ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
-                              veh_at_internal( cur, dummy ) == veh ) ) {
-                            // Handle car doors, but don't try to path through curtains
-                            newg += 10; // One turn to open, 4 to move there
-                        } else if( part >= 0 && bash > 0 ) {
-                            // Car obstacle that isn't a door
-                            // TODO: Account for armor
-                            int hp = veh->parts[part].hp();
-                            if( hp / 20 > bash ) {
-                                // Threshold damage thing means we just can't bash this down
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            } else if( hp / 10 > bash ) {
-                                // Threshold damage thing means we will fail to deal damage pretty often
-                                hp *= 2;
-                            }
+            int newg = cur_g + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
 
-                            newg += 2 * hp / bash + 8 + 4;
-                        } else if( part >= 0 ) {
-                            if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
-                                // Won't be openable, don't try from other sides
-                                layer.state[index] = ASL_CLOSED;
-                            }
-
-                            continue;
-                        }
-                    } else if( rating > 1 ) {
-                        // Expected number of turns to bash it down, 1 turn to move there
-                        // and 5 turns of penalty not to trash everything just because we can
-                        newg += ( 20 / rating ) + 2 + 10;
-                    } else if( rating == 1 ) {
-                        // Desperate measures, avoid whenever possible
-                        newg += 500;
-                    } else {
-                        // Unbashable and unopenable from here
-                        if( !doors || !terrain.open ) {
-                            // Or anywhere else for that matter
-                            layer.state[index] = ASL_CLOSED;
-                        }
-
-                        continue;
-                    }
-                }
-
-                if( trapavoid && p_special & PF_TRAP ) {
-                    const auto &ter_trp = terrain.trap.obj();
-                    const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
-                    if( !trp.is_benign() ) {
-                        // For now make them detect all traps
-                        if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
-                            // Special case - ledge in z-levels
-                            // Warning: really expensive, needs a cache
-                            if( valid_move( p, tripoint( p.x, p.y, p.z - 1 ), false, true ) ) {
-                                tripoint below( p.x, p.y, p.z - 1 );
-                                if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
-                                    // Otherwise this would have been a huge fall
-                                    auto &layer = pf.get_layer( p.z - 1 );
-                                    // From cur, not p, because we won't be walking on air
-                                    pf.add_point( layer.gscore[parent_index] + 10,
-                                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
-                                                  cur, below );
-                                }
-
-                                // Close p, because we won't be walking on it
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            }
-                        } else if( trapavoid ) {
-                            // Otherwise it's walkable
-                            newg += 500;
-                        }
-                    }
-                }
+            const int cost = step_cost( &cur, p, pf_cache.special[p.x][p.y], settings );
+            if( cost == PF_STEP_BLOCKED ) {
+                // Close it so that next time we won't try to calculate costs
+                layer.set_state( index, ASL_CLOSED );
+                continue;
+            } else if( cost == PF_STEP_BLOCKED_HERE ) {
+                continue;
+            } else if( cost == PF_STEP_LEDGE ) {
+                // From cur, not p, because we won't be walking on air
+                const tripoint below( p.x, p.y, p.z - 1 );
+                pf.add_point( cur_g + 10, cur_g + 10 + 2 * rl_dist( below, t ), cur, below );
+                // Close p, because we won't be walking on it
+                layer.set_state( index, ASL_CLOSED );
+                continue;
             }
+            newg += cost;
 
             // If not visited, add as open
             // If visited, add it only if we can do so with better score
-            if( layer.state[index] == ASL_NONE || newg < layer.gscore[index] ) {
+            if( p_state == ASL_NONE || newg < layer.gscore[index] ) {
                 pf.add_point( newg, newg + 2 * rl_dist( p, t ), cur, p );
             }
         }
@@ -432,32 +787,27 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         const maptile &parent_tile = maptile_at_internal( cur );
         const auto &parent_terrain = parent_tile.get_ter_t();
-        if( settings.allow_climb_stairs && cur.z > minz && parent_terrain.has_flag( TFLAG_GOES_DOWN ) ) {
+        if( settings.allow_climb_stairs && cur.z > pf.minz &&
+            parent_terrain.has_flag( TFLAG_GOES_DOWN ) ) {
             tripoint dest( cur.x, cur.y, cur.z - 1 );
             if( vertical_move_destination<TFLAG_GOES_UP>( *this, dest ) ) {
-                auto &layer = pf.get_layer( dest.z );
-                pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
-                              cur, dest );
+                pf.add_point( cur_g + 2, cur_g + 2 + 2 * rl_dist( dest, t ), cur, dest );
             }
         }
-        if( settings.allow_climb_stairs && cur.z < maxz && parent_terrain.has_flag( TFLAG_GOES_UP ) ) {
+        if( settings.allow_climb_stairs && cur.z < pf.maxz &&
+            parent_terrain.has_flag( TFLAG_GOES_UP ) ) {
             tripoint dest( cur.x, cur.y, cur.z + 1 );
             if( vertical_move_destination<TFLAG_GOES_DOWN>( *this, dest ) ) {
-                auto &layer = pf.get_layer( dest.z );
-                pf.add_point( layer.gscore[parent_index] + 2,
-                              layer.score[parent_index] + 2 * rl_dist( dest, t ),
-                              cur, dest );
+                pf.add_point( cur_g + 2, cur_g + 2 + 2 * rl_dist( dest, t ), cur, dest );
             }
         }
-        if( cur.z < maxz && parent_terrain.has_flag( TFLAG_RAMP ) &&
+        if( cur.z < pf.maxz && parent_terrain.has_flag( TFLAG_RAMP ) &&
             valid_move( cur, tripoint( cur.x, cur.y, cur.z + 1 ), false, true ) ) {
-            auto &layer = pf.get_layer( cur.z + 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint above( cur.x + x_offset[it], cur.y + y_offset[it], cur.z + 1 );
-                pf.add_point( layer.gscore[parent_index] + 4,
-                              layer.score[parent_index] + 4 + 2 * rl_dist( above, t ),
-                              cur, above );
+                if( pf.in_bounds( above ) ) {
+                    pf.add_point( cur_g + 4, cur_g + 4 + 2 * rl_dist( above, t ), cur, above );
+                }
             }
         }
     } while( !done && !pf.empty() );
@@ -480,7 +830,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             if( rl_dist( cur, par ) > 1 && abs( cur.z - par.z ) != 1 ) {
                 debugmsg( "Jump in our route! %d:%d:%d->%d:%d:%d",
                           cur.x, cur.y, cur.z, par.x, par.y, par.z );
-                return ret;
+                return true;
             }
 
             cur = par;
@@ -489,5 +839,155 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         std::reverse( ret.begin(), ret.end() );
     }
 
+    return done;
+}
+
+bool flow_field::compatible( const pathfinding_settings &other ) const
+{
+    return settings.bash_strength == other.bash_strength && settings.climb_cost == other.climb_cost &&
+           settings.allow_open_doors == other.allow_open_doors &&
+           settings.avoid_traps == other.avoid_traps &&
+           settings.avoid_rough_terrain == other.avoid_rough_terrain;
+}
+
+std::vector<tripoint> flow_field::route_from( const tripoint &from, const int max_length,
+        const int mapsize ) const
+{
+    std::vector<tripoint> ret;
+    if( distance[from.x][from.y] == unreachable || distance[from.x][from.y] > max_length ) {
+        return ret;
+    }
+
+    constexpr std::array<int, 8> x_offset{{ -1,  1,  0,  0,  1, -1, -1, 1 }};
+    constexpr std::array<int, 8> y_offset{{  0,  0, -1,  1, -1,  1, -1, 1 }};
+    const int size_x = mapsize * SEEX;
+    const int size_y = mapsize * SEEY;
+    tripoint cur = from;
+    while( cur != goal ) {
+        tripoint best = cur;
+        int best_cost = std::numeric_limits<int>::max();
+        for( size_t i = 0; i < 8; i++ ) {
+            const tripoint p( cur.x + x_offset[i], cur.y + y_offset[i], cur.z );
+            if( p.x < 0 || p.x >= size_x || p.y < 0 || p.y >= size_y ||
+                distance[p.x][p.y] == unreachable || enter_cost[p.x][p.y] == unreachable ) {
+                continue;
+            }
+            const int cost = distance[p.x][p.y] + enter_cost[p.x][p.y] + ( i >= 4 ? 1 : 0 );
+            if( cost < best_cost ) {
+                best = p;
+                best_cost = cost;
+            }
+        }
+        // Distances strictly decrease towards the goal, so this can't loop
+        if( best == cur || distance[best.x][best.y] >= distance[cur.x][cur.y] ) {
+            ret.clear();
+            return ret;
+        }
+        ret.push_back( best );
+        cur = best;
+    }
     return ret;
 }
+
+void map::compute_flow_field( flow_field &field ) const
+{
+    const int z = field.goal.z;
+    const int size_x = SEEX * my_MAPSIZE;
+    const int size_y = SEEY * my_MAPSIZE;
+    const auto &pf_cache = get_pathfinding_cache_ref( z );
+
+    std::fill_n( &field.distance[0][0], MAPSIZE_X * MAPSIZE_Y, flow_field::unreachable );
+    for( int x = 0; x < size_x; x++ ) {
+        for( int y = 0; y < size_y; y++ ) {
+            // Same costs as in route_search, except that doors which only open from the inside
+            // are avoided. Ledges lead to another z-level, which the field doesn't cover.
+            const int cost = step_cost( nullptr, tripoint( x, y, z ), pf_cache.special[x][y],
+                                        field.settings );
+            field.enter_cost[x][y] = cost < 0 ? flow_field::unreachable : cost;
+        }
+    }
+    // The goal is usually occupied by the target, not by an obstacle
+    int &goal_cost = field.enter_cost[field.goal.x][field.goal.y];
+    if( goal_cost == flow_field::unreachable ) {
+        goal_cost = 2;
+    }
+
+    // Dijkstra from the goal outwards. Every tile gets a distance, even one that can't be
+    // entered: a creature may already stand on it.
+    constexpr std::array<int, 8> x_offset{{ -1,  1,  0,  0,  1, -1, -1, 1 }};
+    constexpr std::array<int, 8> y_offset{{  0,  0, -1,  1, -1,  1, -1, 1 }};
+    std::vector< std::pair<int, point> > open;
+    field.distance[field.goal.x][field.goal.y] = 0;
+    open.emplace_back( 0, point( field.goal.x, field.goal.y ) );
+    while( !open.empty() ) {
+        std::pop_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+        const int dist = open.back().first;
+        const point cur = open.back().second;
+        open.pop_back();
+        const int cost = field.enter_cost[cur.x][cur.y];
+        if( dist > field.distance[cur.x][cur.y] || cost == flow_field::unreachable ) {
+            continue;
+        }
+        for( size_t i = 0; i < 8; i++ ) {
+            const point p( cur.x + x_offset[i], cur.y + y_offset[i] );
+            if( p.x < 0 || p.x >= size_x || p.y < 0 || p.y >= size_y ) {
+                continue;
+            }
+            // Penalize for diagonals like route_search does
+            const int new_dist = dist + cost + ( i >= 4 ? 1 : 0 );
+            int &old_dist = field.distance[p.x][p.y];
+            if( new_dist <= field.limit && ( old_dist == flow_field::unreachable || new_dist < old_dist ) ) {
+                old_dist = new_dist;
+                open.emplace_back( new_dist, p );
+                std::push_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+            }
+        }
+    }
+}
+
+std::vector<tripoint> map::flow_route( const tripoint &f, const tripoint &t,
+                                       const pathfinding_settings &settings ) const
+{
+    if( f == t || !inbounds( f ) || rl_dist( f, t ) > settings.max_dist ) {
+        return std::vector<tripoint>();
+    }
+    if( f.z != t.z || !inbounds( t ) ) {
+        return route( f, t, settings );
+    }
+
+    // Makes sure the terrain flags are up to date
+    get_pathfinding_cache_ref( t.z );
+    const uint32_t generation = get_pathfinding_cache( t.z ).generation;
+
+    std::lock_guard<std::mutex> lock( flow_fields->mutex );
+    flow_field *field = nullptr;
+    for( const auto &candidate : flow_fields->fields ) {
+        if( candidate->goal == t && candidate->abs_sub == abs_sub &&
+            candidate->generation == generation && candidate->limit >= settings.max_length &&
+            candidate->compatible( settings ) ) {
+            field = candidate.get();
+            break;
+        }
+    }
+    if( field == nullptr ) {
+        auto &fields = flow_fields->fields;
+        if( fields.size() < flow_field_cache::capacity ) {
+            fields.emplace_back( std::make_unique<flow_field>() );
+            field = fields.back().get();
+        } else {
+            field = std::min_element( fields.begin(), fields.end(),
+                                      []( const std::unique_ptr<flow_field> &lhs,
+            const std::unique_ptr<flow_field> &rhs ) {
+                return lhs->last_used < rhs->last_used;
+            } )->get();
+        }
+        field->goal = t;
+        field->abs_sub = abs_sub;
+        field->settings = settings;
+        field->generation = generation;
+        field->limit = settings.max_length;
+        compute_flow_field( *field );
+    }
+    field->last_used = ++flow_fields->clock;
+    return field->route_from( f, settings.max_length, my_MAPSIZE );
+}
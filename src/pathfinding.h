@@ -2,6 +2,14 @@
 #ifndef PATHFINDING_H
 #define PATHFINDING_H
 
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "enums.h"
 #include "game_constants.h"
 
 enum pf_special : char {
@@ -31,19 +39,59 @@ inline pf_special &operator |= ( pf_special &lhs, pf_special rhs )
     return lhs;
 }
 
+/** Results of map::step_cost that aren't a cost. */
+enum pf_step : int {
+    PF_STEP_BLOCKED_HERE = -1, // Can't be entered from this side, maybe from another one
+    PF_STEP_BLOCKED = -2,      // Can't be entered from any side
+    PF_STEP_LEDGE = -3,        // Ledge over a dangerous trap, leads down a z-level instead
+};
+
 inline pf_special &operator &= ( pf_special &lhs, pf_special rhs )
 {
     lhs = static_cast<pf_special>( static_cast< int >( lhs ) & static_cast< int >( rhs ) );
     return lhs;
 }
 
+struct pathfinding_cache;
+
+/**
+ * Coarse connectivity of one z-level, the abstract layer of the hierarchical search
+ * @ref map::route does for long routes.
+ * Every submap is a cluster, which is split into regions: sets of tiles connected
+ * without stepping on a PF_WALL tile. Regions of neighboring clusters are linked
+ * if a single step leads from one to the other.
+ */
+struct pathfinding_regions {
+    struct region {
+        /** Submap of the region, in map grid coordinates. */
+        point cluster;
+        /** Whether the region contains stairs or ramps (PF_UPDOWN tiles). */
+        bool updown = false;
+        /** Indices of the linked regions on the same z-level, sorted. */
+        std::vector<int> neighbors;
+    };
+
+    static constexpr short no_region = -1;
+    /** Region index of each tile, @ref no_region for walls. */
+    short tile_region[MAPSIZE_X][MAPSIZE_Y];
+    std::vector<region> regions;
+
+    /** Rebuilds everything from the cache of a map that is `mapsize` submaps wide. */
+    void build( const pathfinding_cache &cache, int mapsize );
+};
+
 struct pathfinding_cache {
     pathfinding_cache();
     ~pathfinding_cache();
 
     bool dirty;
+    /** Set whenever @ref special is rebuilt, @ref regions is then rebuilt on demand. */
+    bool regions_dirty;
+    /** Incremented every time the cache is marked dirty, see @ref route_cache. */
+    uint32_t generation;
 
     pf_special special[MAPSIZE_X][MAPSIZE_Y];
+    pathfinding_regions regions;
 };
 
 struct pathfinding_settings {
@@ -66,6 +114,98 @@ struct pathfinding_settings {
     pathfinding_settings( int bs, int md, int ml, int cc, bool aod, bool at, bool acs, bool art )
         : bash_strength( bs ), max_dist( md ), max_length( ml ), climb_cost( cc ),
           allow_open_doors( aod ), avoid_traps( at ), allow_climb_stairs( acs ), avoid_rough_terrain( art ) {}
+
+    bool operator==( const pathfinding_settings &rhs ) const {
+        return bash_strength == rhs.bash_strength && max_dist == rhs.max_dist &&
+               max_length == rhs.max_length && climb_cost == rhs.climb_cost &&
+               allow_open_doors == rhs.allow_open_doors && avoid_traps == rhs.avoid_traps &&
+               allow_climb_stairs == rhs.allow_climb_stairs && avoid_rough_terrain == rhs.avoid_rough_terrain;
+    }
+    bool operator!=( const pathfinding_settings &rhs ) const {
+        return !( *this == rhs );
+    }
+};
+
+/**
+ * Recent results of @ref map::route, owned by the map.
+ * An entry stays valid while the pathfinding caches of the z-levels it spans are not
+ * marked dirty (their @ref pathfinding_cache::generation is unchanged) and the map is
+ * not shifted. Besides exact matches, a query reuses the rest of a cached route to the
+ * same destination if it starts on that route, so creatures following each other
+ * towards a common target only search once.
+ */
+class route_cache
+{
+    public:
+        struct query {
+            /** Absolute submap position of the map, local coordinates depend on it. */
+            tripoint abs_sub;
+            tripoint from;
+            tripoint to;
+            pathfinding_settings settings;
+            std::set<tripoint> pre_closed;
+            /** Generations of the pathfinding caches of all z-levels. */
+            std::array<uint32_t, OVERMAP_LAYERS> generations;
+        };
+
+        /** Number of routes kept, the least recently used one is replaced. */
+        static constexpr size_t capacity = 128;
+
+        /** Returns true and sets `route` if a cached result answers the query. */
+        bool find( const query &q, std::vector<tripoint> &route );
+        void add( const query &q, const std::vector<tripoint> &route );
+        void clear();
+
+    private:
+        struct entry {
+            query key;
+            std::vector<tripoint> route;
+            uint64_t last_used = 0;
+        };
+
+        std::vector<entry> entries;
+        uint64_t clock = 0;
+        std::mutex mutex;
+};
+
+/**
+ * Distances from every tile of one z-level to a goal ("Dijkstra map"), for
+ * @ref map::flow_route. Creatures heading for the same goal descend the gradient
+ * instead of each searching its own route.
+ */
+struct flow_field {
+    static constexpr int unreachable = -1;
+
+    tripoint goal;
+    tripoint abs_sub;
+    /** Settings the field was computed for, only the ones affecting costs matter. */
+    pathfinding_settings settings;
+    uint32_t generation = 0;
+    /** Distances above this were not computed, they read as @ref unreachable. */
+    int limit = 0;
+    uint64_t last_used = 0;
+
+    /** Cost of the cheapest route from the tile to the goal, or @ref unreachable. */
+    int distance[MAPSIZE_X][MAPSIZE_Y];
+    /** Cost of stepping onto the tile, or @ref unreachable. */
+    int enter_cost[MAPSIZE_X][MAPSIZE_Y];
+
+    /** Whether the field can answer queries with these settings. */
+    bool compatible( const pathfinding_settings &other ) const;
+    /**
+     * Route from `from` to the goal (excluding `from`, like @ref map::route),
+     * empty if the goal can't be reached within `max_length`.
+     */
+    std::vector<tripoint> route_from( const tripoint &from, int max_length, int mapsize ) const;
+};
+
+/** The flow fields of a map, the least recently used one is replaced. */
+struct flow_field_cache {
+    static constexpr size_t capacity = 8;
+
+    std::vector< std::unique_ptr<flow_field> > fields;
+    uint64_t clock = 0;
+    std::mutex mutex;
 };
 
 #endif
@@ -4367,13 +4367,15 @@ needs_rates player::calc_needs_rates()
 
     add_msg_if_player( m_debug, "Metabolic rate: %.2f", rates.hunger );
 
-    rates.thirst = get_option< float >( "PLAYER_THIRST_RATE" );
+    static const option_handle<float> thirst_rate( "PLAYER_THIRST_RATE" );
+    static const option_handle<float> fatigue_rate( "PLAYER_FATIGUE_RATE" );
+    rates.thirst = thirst_rate.get();
     rates.thirst *= 1.0f +  mutation_value( "thirst_modifier" );
     if( worn_with_flag( "SLOWS_THIRST" ) ) {
         rates.thirst *= 0.7f;
     }
 
-    rates.fatigue = get_option< float >( "PLAYER_FATIGUE_RATE" );
+    rates.fatigue = fatigue_rate.get();
     rates.fatigue *= 1.0f + mutation_value( "fatigue_modifier" );
 
     // Note: intentionally not in metabolic rate
@@ -13,9 +13,9 @@
 #include "optional.h"
 
 // All PRNG functions use an engine, see the C++11 <random> header
-// By default, that engine is seeded by time on first call to such a function.
-// If this function is called with a non-zero seed then the engine will be
-// seeded (or re-seeded) with the given seed.
+// Each thread has its own engine, seeded by time on first call to such a function.
+// If this function is called with a non-zero seed then the engine of the calling
+// thread will be seeded (or re-seeded) with the given seed.
 void rng_set_engine_seed( unsigned int seed );
 
 using cata_default_random_engine = std::minstd_rand0;
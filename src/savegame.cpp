@@ -257,7 +257,7 @@ void scent_map::deserialize( const std::string &data )
                 buffer >> stmp >> count;
             }
             count--;
-            val = stmp;
+            val = std::min( std::max( stmp, 0 ), scent_diffusion::max_value );
         }
     }
 }
@@ -860,7 +860,10 @@ void overmap::unserialize( std::istream &fin )
                             }
                         }
                         count--;
-                        layer[z].terrain[i][j] = tmp_otid;
+                        // Leaves layers that are all the default terrain uniform.
+                        if( layer[z].get_ter( i, j ) != tmp_otid ) {
+                            layer[z].ter( i, j ) = tmp_otid;
+                        }
                     }
                 }
                 jsin.end_array();
@@ -1047,7 +1050,8 @@ void overmap::unserialize( std::istream &fin )
     }
 }
 
-static void unserialize_array_from_compacted_sequence( JsonIn &jsin, bool ( &array )[OMAPX][OMAPY] )
+template<typename Setter>
+static void unserialize_array_from_compacted_sequence( JsonIn &jsin, const Setter &set )
 {
     int count = 0;
     bool value = false;
@@ -1060,7 +1064,7 @@ static void unserialize_array_from_compacted_sequence( JsonIn &jsin, bool ( &arr
                 jsin.end_array();
             }
             count--;
-            array[i][j] = value;
+            set( i, j, value );
         }
     }
 }
@@ -1093,7 +1097,10 @@ void overmap::unserialize_view( std::istream &fin )
             jsin.start_array();
             for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
                 jsin.start_array();
-                unserialize_array_from_compacted_sequence( jsin, layer[z].visible );
+                map_layer &l = layer[z];
+                unserialize_array_from_compacted_sequence( jsin, [&l]( int x, int y, bool value ) {
+                    l.set_visible( x, y, value );
+                } );
                 jsin.end_array();
             }
             jsin.end_array();
@@ -1101,7 +1108,10 @@ void overmap::unserialize_view( std::istream &fin )
             jsin.start_array();
             for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
                 jsin.start_array();
-                unserialize_array_from_compacted_sequence( jsin, layer[z].explored );
+                map_layer &l = layer[z];
+                unserialize_array_from_compacted_sequence( jsin, [&l]( int x, int y, bool value ) {
+                    l.set_explored( x, y, value );
+                } );
                 jsin.end_array();
             }
             jsin.end_array();
@@ -1125,14 +1135,14 @@ void overmap::unserialize_view( std::istream &fin )
     }
 }
 
-static void serialize_array_to_compacted_sequence( JsonOut &json,
-        const bool ( &array )[OMAPX][OMAPY] )
+template<typename Getter>
+static void serialize_array_to_compacted_sequence( JsonOut &json, const Getter &get )
 {
     int count = 0;
     int lastval = -1;
     for( int j = 0; j < OMAPY; j++ ) {
         for( int i = 0; i < OMAPX; i++ ) {
-            const int value = array[i][j];
+            const int value = get( i, j );
             if( value != lastval ) {
                 if( count ) {
                     json.write( count );
@@ -1163,7 +1173,10 @@ void overmap::serialize_view( std::ostream &fout ) const
     json.start_array();
     for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
         json.start_array();
-        serialize_array_to_compacted_sequence( json, layer[z].visible );
+        const map_layer &l = layer[z];
+        serialize_array_to_compacted_sequence( json, [&l]( int x, int y ) {
+            return l.is_visible( x, y );
+        } );
         json.end_array();
         fout << std::endl;
     }
@@ -1173,7 +1186,10 @@ void overmap::serialize_view( std::ostream &fout ) const
     json.start_array();
     for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
         json.start_array();
-        serialize_array_to_compacted_sequence( json, layer[z].explored );
+        const map_layer &l = layer[z];
+        serialize_array_to_compacted_sequence( json, [&l]( int x, int y ) {
+            return l.is_explored( x, y );
+        } );
         json.end_array();
         fout << std::endl;
     }
@@ -1226,7 +1242,7 @@ struct mongroup_hash {
         std::hash_combine( ret, mg.interest );
         std::hash_combine( ret, mg.dying );
         std::hash_combine( ret, mg.horde );
-        std::hash_combine( ret, mg.horde_behaviour );
+        std::hash_combine( ret, static_cast<int>( mg.horde_behaviour ) );
         std::hash_combine( ret, mg.diffuse );
         return ret;
     }
@@ -1276,7 +1292,7 @@ void overmap::serialize( std::ostream &fout ) const
         json.start_array();
         for( int j = 0; j < OMAPY; j++ ) {
             for( int i = 0; i < OMAPX; i++ ) {
-                oter_id t = layer[z].terrain[i][j];
+                oter_id t = layer[z].get_ter( i, j );
                 if( t != last_tertype ) {
                     if( count ) {
                         json.write( count );
@@ -1435,6 +1451,31 @@ void overmap::serialize( std::ostream &fout ) const
 
 ////////////////////////////////////////////////////////////////////////////////////////
 ///// mongroup
+/** The horde behaviour as it is saved, empty for @ref mongroup::behaviour::none. */
+static std::string horde_behaviour_to_string( const mongroup::behaviour behaviour )
+{
+    switch( behaviour ) {
+        case mongroup::behaviour::city:
+            return "city";
+        case mongroup::behaviour::roam:
+            return "roam";
+        case mongroup::behaviour::none:
+            break;
+    }
+    return std::string();
+}
+
+/** Unknown behaviours become none, the horde picks a new one then. */
+static mongroup::behaviour horde_behaviour_from_string( const std::string &str )
+{
+    if( str == "city" ) {
+        return mongroup::behaviour::city;
+    } else if( str == "roam" ) {
+        return mongroup::behaviour::roam;
+    }
+    return mongroup::behaviour::none;
+}
+
 template<typename Archive>
 void mongroup::io( Archive &archive )
 {
@@ -1447,7 +1488,9 @@ void mongroup::io( Archive &archive )
     archive.io( "horde", horde, false );
     archive.io( "target", target, tripoint_zero );
     archive.io( "interest", interest, 0 );
-    archive.io( "horde_behaviour", horde_behaviour, io::empty_default_tag() );
+    std::string behaviour_str = horde_behaviour_to_string( horde_behaviour );
+    archive.io( "horde_behaviour", behaviour_str, io::empty_default_tag() );
+    horde_behaviour = horde_behaviour_from_string( behaviour_str );
     archive.io( "monsters", monsters, io::empty_default_tag() );
 }
 
@@ -1487,7 +1530,7 @@ void mongroup::deserialize_legacy( JsonIn &json )
         } else if( name == "interest" ) {
             interest = json.get_int();
         } else if( name == "horde_behaviour" ) {
-            horde_behaviour = json.get_string();
+            horde_behaviour = horde_behaviour_from_string( json.get_string() );
         } else if( name == "monsters" ) {
             json.start_array();
             while( !json.end_array() ) {
@@ -369,8 +369,8 @@ void overmap::unserialize_legacy( std::istream &fin )
                             }
                         }
                         count--;
-                        layer[z].terrain[i][j] = tmp_otid; //otermap[tmp_ter].loadid;
-                        layer[z].visible[i][j] = false;
+                        layer[z].ter( i, j ) = tmp_otid; //otermap[tmp_ter].loadid;
+                        layer[z].set_visible( i, j, false );
                     }
                 }
                 convert_terrain( needs_conversion );
@@ -552,7 +552,7 @@ void overmap::unserialize_view_legacy( std::istream &fin )
                             fin >> vis >> count;
                         }
                         count--;
-                        layer[z].visible[i][j] = ( vis == 1 );
+                        layer[z].set_visible( i, j, vis == 1 );
                     }
                 }
             }
@@ -571,7 +571,7 @@ void overmap::unserialize_view_legacy( std::istream &fin )
                             fin >> explored >> count;
                         }
                         count--;
-                        layer[z].explored[i][j] = ( explored == 1 );
+                        layer[z].set_explored( i, j, explored == 1 );
                     }
                 }
             }
@@ -2,8 +2,20 @@
 
 #include <cstdlib>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <algorithm>
 
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#   define SCENT_DIFFUSION_SSE2
+#   include <emmintrin.h>
+#endif
+// The AVX2 kernel is compiled with a function attribute and only used if the CPU supports it
+#if defined(SCENT_DIFFUSION_SSE2) && defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#   define SCENT_DIFFUSION_AVX2
+#   include <immintrin.h>
+#endif
+
 #include "calendar.h"
 #include "color.h"
 #include "game.h"
@@ -43,6 +55,420 @@ static nc_color sev( const size_t level )
     return level < colors.size() ? colors[level] : c_dark_gray;
 }
 
+namespace scent_diffusion
+{
+
+// decrease this to reduce gas spread. Keep it under 125 for
+// stability. This is essentially a decimal number * 1000.
+static constexpr int diffusivity = 100;
+
+// The straightforward implementation, the others must give the same results.
+static void diffuse_scalar( grid<value> &grscent, const grid<bool> &blocks_scent,
+                            const grid<bool> &reduces_scent,
+                            const int scentmap_minx, const int scentmap_miny,
+                            const int scentmap_maxx, const int scentmap_maxy )
+{
+    // note: the next four intermediate matrices need to be at least
+    // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+1] in size to hold enough data
+    // The code I'm modifying used [MAPSIZE_X]. I'm staying with that to avoid new bugs.
+
+    // These two matrices are transposed so that x addresses are contiguous in memory
+    grid<int> sum_3_scent_y;
+    grid<int> squares_used_y;
+
+    // Sum neighbors in the y direction.  This way, each square gets called 3 times instead of 9
+    // times. This cost us an extra loop here, but it also eliminated a loop at the end, so there
+    // is a net performance improvement over the old code. Could probably still be better.
+    // note: this method needs an array that is one square larger on each side in the x direction
+    // than the final scent matrix. I think this is fine since SCENT_RADIUS is less than
+    // MAPSIZE_X, but if that changes, this may need tweaking.
+    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
+        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = y - 1; i <= y + 1; ++i ) {
+                if( !blocks_scent[x][i] ) {
+                    if( reduces_scent[x][i] ) {
+                        // only 20% of scent can diffuse on REDUCE_SCENT squares
+                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
+                        squares_used_y[y][x] += 2;
+                    } else {
+                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
+                        squares_used_y[y][x] += 10;
+                    }
+                }
+            }
+        }
+    }
+
+    // Rest of the scent map
+    for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
+        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+            auto &scent_here = grscent[x][y];
+            if( !blocks_scent[x][y] ) {
+                // to how many neighboring squares do we diffuse out? (include our own square
+                // since we also include our own square when diffusing in)
+                const int squares_used = squares_used_y[y][x - 1]
+                                         + squares_used_y[y][x]
+                                         + squares_used_y[y][x + 1];
+
+                int this_diffusivity;
+                if( !reduces_scent[x][y] ) {
+                    this_diffusivity = diffusivity;
+                } else {
+                    this_diffusivity = diffusivity / 5; //less air movement for REDUCE_SCENT square
+                }
+                // take the old scent and subtract what diffuses out
+                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+                // neighboring walls and reduce_scent squares absorb some scent
+                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+                // we've already summed neighboring scent values in the y direction in the previous
+                // loop. Now we do it for the x direction, multiply by diffusion, and this is what
+                // diffuses into our current square.
+                scent_here =
+                    ( temp_scent
+                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
+                                             + sum_3_scent_y[y][x]
+                                             + sum_3_scent_y[y][x + 1] )
+                    ) / ( 1000 * 10 );
+            } else {
+                // this cell blocks scent
+                scent_here = 0;
+            }
+        }
+    }
+}
+
+// The vectorized kernels work on columns of tiles (contiguous y) and avoid branches:
+//   weight      = blocks ? 0 : reduces ? 2 : 10
+//   diffusivity = reduces ? 20 : 100
+// Both diffusivities are multiples of 5, so "x * diffusivity / 5" is "x * ( diffusivity / 5 )"
+// without any rounding. The division by 10000 is done in double precision, which is exact
+// for all int numerators, and truncated like the integer division.
+// Tiles that don't fill a whole vector at the end of a column use these scalar versions.
+static inline int weight_at( const grid<bool> &blocks, const grid<bool> &reduces,
+                             const int x, const int y )
+{
+    return blocks[x][y] ? 0 : reduces[x][y] ? 2 : 10;
+}
+
+static inline void sum_column_tile( const grid<value> &scent, const grid<bool> &blocks,
+                                    const grid<bool> &reduces, grid<int> &sum_3, grid<int> &used_3,
+                                    const int x, const int y )
+{
+    int sum = 0;
+    int used = 0;
+    for( int i = y - 1; i <= y + 1; ++i ) {
+        const int weight = weight_at( blocks, reduces, x, i );
+        sum += weight * scent[x][i];
+        used += weight;
+    }
+    sum_3[x][y] = sum;
+    used_3[x][y] = used;
+}
+
+static inline void diffuse_tile( grid<value> &scent, const grid<bool> &blocks,
+                                 const grid<bool> &reduces, const grid<int> &sum_3,
+                                 const grid<int> &used_3, const int x, const int y )
+{
+    if( blocks[x][y] ) {
+        scent[x][y] = 0;
+        return;
+    }
+    const int squares_used = used_3[x - 1][y] + used_3[x][y] + used_3[x + 1][y];
+    const int this_diffusivity = reduces[x][y] ? diffusivity / 5 : diffusivity;
+    const int here = scent[x][y];
+    const int temp_scent = here * ( 10 * 1000 - squares_used * this_diffusivity ) -
+                           here * ( this_diffusivity / 5 ) * ( 90 - squares_used );
+    scent[x][y] = ( temp_scent + this_diffusivity * ( sum_3[x - 1][y] + sum_3[x][y] + sum_3[x + 1][y] ) ) /
+                  ( 1000 * 10 );
+}
+
+static_assert( sizeof( bool ) == 1, "the vectorized scent kernels load bools as bytes" );
+static_assert( diffusivity % 25 == 0, "the vectorized scent kernels need diffusivity / 5 to be exact" );
+
+#if defined(SCENT_DIFFUSION_SSE2)
+
+// _mm_mullo_epi32 is SSE4.1, the low halves of unsigned products are the same
+static inline __m128i mullo_sse2( const __m128i a, const __m128i b )
+{
+    const __m128i even = _mm_mul_epu32( a, b );
+    const __m128i odd = _mm_mul_epu32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) );
+    return _mm_unpacklo_epi32( _mm_shuffle_epi32( even, _MM_SHUFFLE( 0, 0, 2, 0 ) ),
+                               _mm_shuffle_epi32( odd, _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+}
+
+// Four scent values sign extended to 32 bits
+static inline __m128i load_scent_sse2( const value *scent )
+{
+    const __m128i packed = _mm_loadl_epi64( reinterpret_cast<const __m128i *>( scent ) );
+    return _mm_srai_epi32( _mm_unpacklo_epi16( packed, packed ), 16 );
+}
+
+// Results of the diffusion never exceed the input, so packing doesn't saturate
+static inline void store_scent_sse2( value *scent, const __m128i values )
+{
+    _mm_storel_epi64( reinterpret_cast<__m128i *>( scent ), _mm_packs_epi32( values, values ) );
+}
+
+// Four bools widened to 0 or 1 in each lane
+static inline __m128i load_flags_sse2( const bool *flags )
+{
+    int32_t bytes;
+    memcpy( &bytes, flags, sizeof( bytes ) );
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16( _mm_unpacklo_epi8( _mm_cvtsi32_si128( bytes ), zero ), zero );
+}
+
+static inline __m128i weight_sse2( const bool *blocks, const bool *reduces )
+{
+    const __m128i open = _mm_sub_epi32( _mm_set1_epi32( 1 ), load_flags_sse2( blocks ) );
+    const __m128i reduced = mullo_sse2( load_flags_sse2( reduces ), _mm_set1_epi32( 8 ) );
+    return mullo_sse2( open, _mm_sub_epi32( _mm_set1_epi32( 10 ), reduced ) );
+}
+
+static inline __m128i div_10000_sse2( const __m128i value )
+{
+    const __m128d divisor = _mm_set1_pd( 10000.0 );
+    const __m128d low = _mm_div_pd( _mm_cvtepi32_pd( value ), divisor );
+    const __m128d high = _mm_div_pd( _mm_cvtepi32_pd( _mm_shuffle_epi32( value, _MM_SHUFFLE( 3, 2, 3,
+                                     2 ) ) ), divisor );
+    return _mm_unpacklo_epi64( _mm_cvttpd_epi32( low ), _mm_cvttpd_epi32( high ) );
+}
+
+static void diffuse_sse2( grid<value> &scent, const grid<bool> &blocks, const grid<bool> &reduces,
+                          const int minx, const int miny, const int maxx, const int maxy )
+{
+    constexpr int width = 4;
+    grid<int> sum_3;
+    grid<int> used_3;
+
+    for( int x = minx - 1; x <= maxx + 1; ++x ) {
+        int y = miny;
+        for( ; y + width - 1 <= maxy; y += width ) {
+            __m128i sum = _mm_setzero_si128();
+            __m128i used = _mm_setzero_si128();
+            for( int i = -1; i <= 1; ++i ) {
+                const __m128i weight = weight_sse2( &blocks[x][y + i], &reduces[x][y + i] );
+                sum = _mm_add_epi32( sum, mullo_sse2( weight, load_scent_sse2( &scent[x][y + i] ) ) );
+                used = _mm_add_epi32( used, weight );
+            }
+            _mm_storeu_si128( reinterpret_cast<__m128i *>( &sum_3[x][y] ), sum );
+            _mm_storeu_si128( reinterpret_cast<__m128i *>( &used_3[x][y] ), used );
+        }
+        for( ; y <= maxy; ++y ) {
+            sum_column_tile( scent, blocks, reduces, sum_3, used_3, x, y );
+        }
+    }
+
+    const auto load = []( const int *p ) {
+        return _mm_loadu_si128( reinterpret_cast<const __m128i *>( p ) );
+    };
+    for( int x = minx; x <= maxx; ++x ) {
+        int y = miny;
+        for( ; y + width - 1 <= maxy; y += width ) {
+            const __m128i squares_used = _mm_add_epi32( _mm_add_epi32( load( &used_3[x - 1][y] ),
+                                         load( &used_3[x][y] ) ), load( &used_3[x + 1][y] ) );
+            const __m128i sum_9 = _mm_add_epi32( _mm_add_epi32( load( &sum_3[x - 1][y] ),
+                                                 load( &sum_3[x][y] ) ), load( &sum_3[x + 1][y] ) );
+            const __m128i reduced = load_flags_sse2( &reduces[x][y] );
+            const __m128i this_diffusivity = _mm_sub_epi32( _mm_set1_epi32( diffusivity ),
+                                             mullo_sse2( reduced, _mm_set1_epi32( diffusivity - diffusivity / 5 ) ) );
+            const __m128i absorbed = _mm_sub_epi32( _mm_set1_epi32( diffusivity / 5 ),
+                                                    mullo_sse2( reduced, _mm_set1_epi32( diffusivity / 5 - diffusivity / 25 ) ) );
+            const __m128i here = load_scent_sse2( &scent[x][y] );
+            __m128i temp_scent = mullo_sse2( here, _mm_sub_epi32( _mm_set1_epi32( 10 * 1000 ),
+                                             mullo_sse2( squares_used, this_diffusivity ) ) );
+            temp_scent = _mm_sub_epi32( temp_scent, mullo_sse2( mullo_sse2( here, absorbed ),
+                                        _mm_sub_epi32( _mm_set1_epi32( 90 ), squares_used ) ) );
+            const __m128i result = div_10000_sse2( _mm_add_epi32( temp_scent,
+                                                   mullo_sse2( this_diffusivity, sum_9 ) ) );
+            // Blocking tiles end up with no scent at all
+            const __m128i blocked = _mm_cmpeq_epi32( load_flags_sse2( &blocks[x][y] ), _mm_set1_epi32( 1 ) );
+            store_scent_sse2( &scent[x][y], _mm_andnot_si128( blocked, result ) );
+        }
+        for( ; y <= maxy; ++y ) {
+            diffuse_tile( scent, blocks, reduces, sum_3, used_3, x, y );
+        }
+    }
+}
+
+#endif // SCENT_DIFFUSION_SSE2
+
+#if defined(SCENT_DIFFUSION_AVX2)
+
+#define SCENT_AVX2_TARGET __attribute__(( target( "avx2" ) ))
+
+SCENT_AVX2_TARGET
+static inline __m256i load_flags_avx2( const bool *flags )
+{
+    return _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast<const __m128i *>( flags ) ) );
+}
+
+SCENT_AVX2_TARGET
+static inline __m256i load_avx2( const int *p )
+{
+    return _mm256_loadu_si256( reinterpret_cast<const __m256i *>( p ) );
+}
+
+SCENT_AVX2_TARGET
+static inline __m256i load_scent_avx2( const value *scent )
+{
+    return _mm256_cvtepi16_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i *>( scent ) ) );
+}
+
+SCENT_AVX2_TARGET
+static inline void store_scent_avx2( value *scent, const __m256i values )
+{
+    const __m128i packed = _mm_packs_epi32( _mm256_castsi256_si128( values ),
+                                            _mm256_extracti128_si256( values, 1 ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i *>( scent ), packed );
+}
+
+SCENT_AVX2_TARGET
+static inline __m256i div_10000_avx2( const __m256i value )
+{
+    const __m256d divisor = _mm256_set1_pd( 10000.0 );
+    const __m256d low = _mm256_div_pd( _mm256_cvtepi32_pd( _mm256_castsi256_si128( value ) ), divisor );
+    const __m256d high = _mm256_div_pd( _mm256_cvtepi32_pd( _mm256_extracti128_si256( value, 1 ) ),
+                                        divisor );
+    return _mm256_inserti128_si256( _mm256_castsi128_si256( _mm256_cvttpd_epi32( low ) ),
+                                    _mm256_cvttpd_epi32( high ), 1 );
+}
+
+SCENT_AVX2_TARGET
+static void diffuse_avx2( grid<value> &scent, const grid<bool> &blocks, const grid<bool> &reduces,
+                          const int minx, const int miny, const int maxx, const int maxy )
+{
+    constexpr int width = 8;
+    grid<int> sum_3;
+    grid<int> used_3;
+
+    for( int x = minx - 1; x <= maxx + 1; ++x ) {
+        int y = miny;
+        for( ; y + width - 1 <= maxy; y += width ) {
+            __m256i sum = _mm256_setzero_si256();
+            __m256i used = _mm256_setzero_si256();
+            for( int i = -1; i <= 1; ++i ) {
+                const __m256i open = _mm256_sub_epi32( _mm256_set1_epi32( 1 ),
+                                                       load_flags_avx2( &blocks[x][y + i] ) );
+                const __m256i reduced = _mm256_slli_epi32( load_flags_avx2( &reduces[x][y + i] ), 3 );
+                const __m256i weight = _mm256_mullo_epi32( open, _mm256_sub_epi32( _mm256_set1_epi32( 10 ),
+                                       reduced ) );
+                sum = _mm256_add_epi32( sum, _mm256_mullo_epi32( weight, load_scent_avx2( &scent[x][y + i] ) ) );
+                used = _mm256_add_epi32( used, weight );
+            }
+            _mm256_storeu_si256( reinterpret_cast<__m256i *>( &sum_3[x][y] ), sum );
+            _mm256_storeu_si256( reinterpret_cast<__m256i *>( &used_3[x][y] ), used );
+        }
+        for( ; y <= maxy; ++y ) {
+            sum_column_tile( scent, blocks, reduces, sum_3, used_3, x, y );
+        }
+    }
+
+    for( int x = minx; x <= maxx; ++x ) {
+        int y = miny;
+        for( ; y + width - 1 <= maxy; y += width ) {
+            const __m256i squares_used = _mm256_add_epi32( _mm256_add_epi32( load_avx2( &used_3[x - 1][y] ),
+                                         load_avx2( &used_3[x][y] ) ), load_avx2( &used_3[x + 1][y] ) );
+            const __m256i sum_9 = _mm256_add_epi32( _mm256_add_epi32( load_avx2( &sum_3[x - 1][y] ),
+                                                    load_avx2( &sum_3[x][y] ) ), load_avx2( &sum_3[x + 1][y] ) );
+            const __m256i reduced = load_flags_avx2( &reduces[x][y] );
+            const __m256i this_diffusivity = _mm256_sub_epi32( _mm256_set1_epi32( diffusivity ),
+                                             _mm256_mullo_epi32( reduced, _mm256_set1_epi32( diffusivity - diffusivity / 5 ) ) );
+            const __m256i absorbed = _mm256_sub_epi32( _mm256_set1_epi32( diffusivity / 5 ),
+                                     _mm256_mullo_epi32( reduced, _mm256_set1_epi32( diffusivity / 5 - diffusivity / 25 ) ) );
+            const __m256i here = load_scent_avx2( &scent[x][y] );
+            __m256i temp_scent = _mm256_mullo_epi32( here, _mm256_sub_epi32( _mm256_set1_epi32( 10 * 1000 ),
+                                 _mm256_mullo_epi32( squares_used, this_diffusivity ) ) );
+            temp_scent = _mm256_sub_epi32( temp_scent, _mm256_mullo_epi32( _mm256_mullo_epi32( here, absorbed ),
+                                           _mm256_sub_epi32( _mm256_set1_epi32( 90 ), squares_used ) ) );
+            const __m256i result = div_10000_avx2( _mm256_add_epi32( temp_scent,
+                                                   _mm256_mullo_epi32( this_diffusivity, sum_9 ) ) );
+            // Blocking tiles end up with no scent at all
+            const __m256i blocked = _mm256_cmpeq_epi32( load_flags_avx2( &blocks[x][y] ),
+                                    _mm256_set1_epi32( 1 ) );
+            store_scent_avx2( &scent[x][y], _mm256_andnot_si256( blocked, result ) );
+        }
+        for( ; y <= maxy; ++y ) {
+            diffuse_tile( scent, blocks, reduces, sum_3, used_3, x, y );
+        }
+    }
+}
+
+#endif // SCENT_DIFFUSION_AVX2
+
+const char *kernel_name( const kernel k )
+{
+    switch( k ) {
+        case kernel::scalar:
+            return "scalar";
+        case kernel::sse2:
+            return "sse2";
+        case kernel::avx2:
+            return "avx2";
+    }
+    return "unknown";
+}
+
+bool kernel_supported( const kernel k )
+{
+    switch( k ) {
+        case kernel::scalar:
+            return true;
+        case kernel::sse2:
+#if defined(SCENT_DIFFUSION_SSE2)
+            return true;
+#else
+            return false;
+#endif
+        case kernel::avx2:
+#if defined(SCENT_DIFFUSION_AVX2)
+            return __builtin_cpu_supports( "avx2" );
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+kernel best_kernel()
+{
+    for( const kernel k : { kernel::avx2, kernel::sse2 } ) {
+        if( kernel_supported( k ) ) {
+            return k;
+        }
+    }
+    return kernel::scalar;
+}
+
+void diffuse( const kernel k, grid<value> &scent, const grid<bool> &blocks_scent,
+              const grid<bool> &reduces_scent, const int minx, const int miny, const int maxx,
+              const int maxy )
+{
+    switch( k ) {
+#if defined(SCENT_DIFFUSION_AVX2)
+        case kernel::avx2:
+            if( kernel_supported( k ) ) {
+                diffuse_avx2( scent, blocks_scent, reduces_scent, minx, miny, maxx, maxy );
+                return;
+            }
+            break;
+#endif
+#if defined(SCENT_DIFFUSION_SSE2)
+        case kernel::sse2:
+            diffuse_sse2( scent, blocks_scent, reduces_scent, minx, miny, maxx, maxy );
+            return;
+#endif
+        default:
+            break;
+    }
+    diffuse_scalar( scent, blocks_scent, reduces_scent, minx, miny, maxx, maxy );
+}
+
+} // namespace scent_diffusion
+
 void scent_map::reset()
 {
     for( auto &elem : grscent ) {
@@ -76,7 +502,7 @@ void scent_map::draw( const catacurses::window &win, const int div, const tripoi
 
 void scent_map::shift( const int sm_shift_x, const int sm_shift_y )
 {
-    scent_array<int> new_scent;
+    scent_array<scent_diffusion::value> new_scent;
     for( size_t x = 0; x < MAPSIZE_X; ++x ) {
         for( size_t y = 0; y < MAPSIZE_Y; ++y ) {
             const point p( x + sm_shift_x, y + sm_shift_y );
@@ -97,7 +523,7 @@ int scent_map::get( const tripoint &p ) const
 void scent_map::set( const tripoint &p, int value )
 {
     if( inbounds( p ) ) {
-        grscent[p.x][p.y] = value;
+        grscent[p.x][p.y] = std::min( std::max( value, 0 ), scent_diffusion::max_value );
     }
 }
 
@@ -135,14 +561,6 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
-    // note: the next four intermediate matrices need to be at least
-    // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+1] in size to hold enough data
-    // The code I'm modifying used [MAPSIZE_X]. I'm staying with that to avoid new bugs.
-
-    // These two matrices are transposed so that x addresses are contiguous in memory
-    scent_array<int> sum_3_scent_y;
-    scent_array<int> squares_used_y;
-
     // these are for caching flag lookups
     scent_array<bool> blocks_scent; // currently only TFLAG_WALL blocks scent
     scent_array<bool> reduces_scent;
@@ -153,73 +571,11 @@ void scent_map::update( const tripoint &center, map &m )
     const int scentmap_miny = center.y - SCENT_RADIUS;
     const int scentmap_maxy = center.y + SCENT_RADIUS;
 
-    // decrease this to reduce gas spread. Keep it under 125 for
-    // stability. This is essentially a decimal number * 1000.
-    const int diffusivity = 100;
-
     // The new scent flag searching function. Should be wayyy faster than the old one.
     m.scent_blockers( blocks_scent, reduces_scent, scentmap_minx - 1, scentmap_miny - 1,
                       scentmap_maxx + 1, scentmap_maxy + 1 );
-    // Sum neighbors in the y direction.  This way, each square gets called 3 times instead of 9
-    // times. This cost us an extra loop here, but it also eliminated a loop at the end, so there
-    // is a net performance improvement over the old code. Could probably still be better.
-    // note: this method needs an array that is one square larger on each side in the x direction
-    // than the final scent matrix. I think this is fine since SCENT_RADIUS is less than
-    // MAPSIZE_X, but if that changes, this may need tweaking.
-    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
-        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = y - 1; i <= y + 1; ++i ) {
-                if( !blocks_scent[x][i] ) {
-                    if( reduces_scent[x][i] ) {
-                        // only 20% of scent can diffuse on REDUCE_SCENT squares
-                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
-                        squares_used_y[y][x] += 2;
-                    } else {
-                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
-                        squares_used_y[y][x] += 10;
-                    }
-                }
-            }
-        }
-    }
 
-    // Rest of the scent map
-    for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
-        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            auto &scent_here = grscent[x][y];
-            if( !blocks_scent[x][y] ) {
-                // to how many neighboring squares do we diffuse out? (include our own square
-                // since we also include our own square when diffusing in)
-                const int squares_used = squares_used_y[y][x - 1]
-                                         + squares_used_y[y][x]
-                                         + squares_used_y[y][x + 1];
-
-                int this_diffusivity;
-                if( !reduces_scent[x][y] ) {
-                    this_diffusivity = diffusivity;
-                } else {
-                    this_diffusivity = diffusivity / 5; //less air movement for REDUCE_SCENT square
-                }
-                // take the old scent and subtract what diffuses out
-                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
-                // neighboring walls and reduce_scent squares absorb some scent
-                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
-                // we've already summed neighboring scent values in the y direction in the previous
-                // loop. Now we do it for the x direction, multiply by diffusion, and this is what
-                // diffuses into our current square.
-                scent_here =
-                    ( temp_scent
-                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
-                                             + sum_3_scent_y[y][x]
-                                             + sum_3_scent_y[y][x + 1] )
-                    ) / ( 1000 * 10 );
-            } else {
-                // this cell blocks scent
-                scent_here = 0;
-            }
-        }
-    }
+    static const scent_diffusion::kernel kernel = scent_diffusion::best_kernel();
+    scent_diffusion::diffuse( kernel, grscent, blocks_scent, reduces_scent,
+                              scentmap_minx, scentmap_miny, scentmap_maxx, scentmap_maxy );
 }
@@ -3,6 +3,8 @@
 #define SCENT_H
 
 #include <array>
+#include <cstdint>
+#include <limits>
 #include <string>
 
 #include "calendar.h"
@@ -20,13 +22,52 @@ namespace catacurses
 class window;
 } // namespace catacurses
 
+/**
+ * The diffusion step of @ref scent_map::update. The kernels compute exactly the same values,
+ * the vectorized ones just do it for several tiles at once.
+ */
+namespace scent_diffusion
+{
+
+/**
+ * Scent of a single tile. Player scent stays in the hundreds to low thousands, so 16 bits are
+ * plenty, halve the memory the kernels stream through and keep all intermediate products
+ * of the diffusion within an int.
+ */
+using value = int16_t;
+static constexpr int max_value = std::numeric_limits<value>::max();
+
+enum class kernel : int {
+    scalar,
+    sse2,
+    avx2
+};
+
+template<typename T>
+using grid = std::array<std::array<T, MAPSIZE_Y>, MAPSIZE_X>;
+
+const char *kernel_name( kernel k );
+/** Whether the kernel was compiled in and the CPU can run it. */
+bool kernel_supported( kernel k );
+/** The fastest supported kernel, determined once. */
+kernel best_kernel();
+
+/**
+ * Diffuses the scent of the tiles in [minx, maxx] x [miny, maxy]. The flags must be set
+ * one tile further out in every direction.
+ */
+void diffuse( kernel k, grid<value> &scent, const grid<bool> &blocks_scent,
+              const grid<bool> &reduces_scent, int minx, int miny, int maxx, int maxy );
+
+} // namespace scent_diffusion
+
 class scent_map
 {
     protected:
         template<typename T>
         using scent_array = std::array<std::array<T, MAPSIZE_Y>, MAPSIZE_X>;
 
-        scent_array<int> grscent;
+        scent_array<scent_diffusion::value> grscent;
         cata::optional<tripoint> player_last_position;
         time_point player_last_moved = calendar::before_time_starts;
 
@@ -48,6 +89,7 @@ class scent_map
         /**
          * Get the scent value at the given position.
          * An invalid position is allows and will yield a 0 value.
+         * Values are clamped to [0, @ref scent_diffusion::max_value] when set.
          * The coordinate system is the same as the @ref map (`g->m`) uses.
          */
         /**@{*/
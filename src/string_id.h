@@ -2,8 +2,10 @@
 #ifndef STRING_ID_H
 #define STRING_ID_H
 
+#include <atomic>
 #include <string>
 #include <type_traits>
+#include <utility>
 
 template<typename T>
 class int_id;
@@ -63,6 +65,19 @@ class string_id
          * to be special. Every string (including the empty one) may be a valid id.
          */
         string_id() : _cid( -1 ) {}
+        // The cached int id is atomic, so these have to be spelled out.
+        string_id( const This &other ) : _id( other._id ), _cid( other.cached_cid() ) {}
+        string_id( This &&other ) noexcept : _id( std::move( other._id ) ), _cid( other.cached_cid() ) {}
+        This &operator=( const This &other ) {
+            _id = other._id;
+            _cid.store( other.cached_cid(), std::memory_order_relaxed );
+            return *this;
+        }
+        This &operator=( This &&other ) noexcept {
+            _id = std::move( other._id );
+            _cid.store( other.cached_cid(), std::memory_order_relaxed );
+            return *this;
+        }
         /**
          * Comparison, only useful when the id is used in std::map or std::set as key. Compares
          * the string id as with the strings comparison.
@@ -183,18 +198,27 @@ class string_id
          * Assigns a new value for the cached int id.
          */
         void set_cid( const int_id<T> &cid ) const {
-            _cid = cid.to_i();
+            _cid.store( cid.to_i(), std::memory_order_relaxed );
         }
         /**
          * Returns the current value of cached id
          */
         int_id<T> get_cid() const {
-            return int_id<T>( _cid );
+            return int_id<T>( cached_cid() );
         }
 
     private:
+        int cached_cid() const {
+            return _cid.load( std::memory_order_relaxed );
+        }
+
         std::string _id;
-        mutable int _cid;
+        /**
+         * Filled in by the first lookup, which may happen on any thread (e.g. the
+         * overmap generation worker). The lookup checks the cached value, so relaxed
+         * accesses are enough to make concurrent lookups of the same id safe.
+         */
+        mutable std::atomic<int> _cid;
 };
 
 // Support hashing of string based ids by forwarding the hash of the string.
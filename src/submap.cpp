@@ -40,6 +40,13 @@ submap::submap()
     std::uninitialized_fill_n( &lum[0][0], elements, 0 );
     std::uninitialized_fill_n( &trp[0][0], elements, tr_null );
     std::uninitialized_fill_n( &rad[0][0], elements, 0 );
+    // Most tiles only ever hold a couple of items, so keep their first
+    // allocation small rather than reserving the colony default.
+    for( auto &column : itm ) {
+        for( auto &items : column ) {
+            items.change_minimum_group_size( 4 );
+        }
+    }
 
     is_uniform = false;
 }
@@ -156,6 +163,18 @@ bool submap::contains_vehicle( vehicle *veh )
     return match != vehicles.end();
 }
 
+void submap::update_field_tiles()
+{
+    for( int x = 0; x < SEEX; x++ ) {
+        field_tiles[x] = 0;
+        for( int y = 0; y < SEEY; y++ ) {
+            if( fld[x][y].field_count() > 0 ) {
+                note_field( point( x, y ) );
+            }
+        }
+    }
+}
+
 void submap::rotate( int turns )
 {
     turns = turns % 4;
@@ -200,6 +219,7 @@ void submap::rotate( int turns )
     }
 
     active_items.rotate_locations( turns, { SEEX, SEEY } );
+    update_field_tiles();
 
     for( auto &elem : cosmetics ) {
         elem.pos = rotate_point( elem.pos );
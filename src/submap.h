@@ -3,6 +3,7 @@
 #define SUBMAP_H
 
 #include <cstddef>
+#include <array>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -17,6 +18,7 @@
 #include "field.h"
 #include "game_constants.h"
 #include "item.h"
+#include "item_stack.h"
 #include "enums.h"
 #include "type_id.h"
 #include "vehicle.h"
@@ -50,7 +52,7 @@ struct maptile_soa {
     ter_id          ter[sx][sy];  // Terrain on each square
     furn_id         frn[sx][sy];  // Furniture on each square
     std::uint8_t    lum[sx][sy];  // Number of items emitting light on each square
-    std::list<item> itm[sx][sy];  // Items on each square
+    item_colony     itm[sx][sy];  // Items on each square
     field           fld[sx][sy];  // Field on each square
     trap_id         trp[sx][sy];  // Trap on each square
     int             rad[sx][sy];  // Irradiation of each square
@@ -59,6 +61,8 @@ struct maptile_soa {
     void swap_soa_tile( const point &p, maptile_soa<1, 1> &other );
 };
 
+static_assert( SEEY <= 16, "submap::field_tiles needs a bit for each tile in a column" );
+
 class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritance.
 {
     public:
@@ -172,10 +176,26 @@ class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritanc
 
         bool contains_vehicle( vehicle * );
 
+        /** Marks the tile at @p p as possibly holding fields, see @ref field_tiles. */
+        void note_field( const point &p ) {
+            field_tiles[p.x] |= 1 << p.y;
+        }
+        bool may_have_field( const point &p ) const {
+            return field_tiles[p.x] & ( 1 << p.y );
+        }
+        /** Recomputes @ref field_tiles from the fields that are actually there. */
+        void update_field_tiles();
+
         void rotate( int turns );
 
         void store( JsonOut &jsout ) const;
-        void load( JsonIn &jsin, const std::string &member_name, bool rubpow_update );
+        /**
+         * Stores everything but the terrain, furniture, trap and radiation
+         * layers, which the binary map format writes on its own.
+         */
+        void store_contents( JsonOut &jsout ) const;
+        /** @param version The savegame version the member was written with. */
+        void load( JsonIn &jsin, const std::string &member_name, int version );
 
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
@@ -186,6 +206,12 @@ class submap : public maptile_soa<SEEX, SEEY>    // TODO: Use private inheritanc
         active_item_cache active_items;
 
         int field_count = 0;
+        /**
+         * Bit y of field_tiles[x] is set when fld[x][y] may hold fields, so field
+         * processing only has to visit those tiles. Anything that adds a field
+         * sets the bit, field processing clears it once it finds the tile empty.
+         */
+        std::array<uint16_t, SEEX> field_tiles = {{}};
         time_point last_touched = calendar::time_of_cataclysm;
         std::vector<spawn_point> spawns;
         /**
@@ -258,6 +284,7 @@ struct maptile {
             const bool ret = sm->fld[x][y].add_field( field_to_add, new_density, new_age );
             if( ret ) {
                 sm->field_count++;
+                sm->note_field( pos() );
             }
 
             return ret;
@@ -289,7 +316,7 @@ struct maptile {
         }
 
         const item &get_uppermost_item() const {
-            return sm->itm[x][y].back();
+            return *std::prev( sm->itm[x][y].cend() );
         }
 };
 
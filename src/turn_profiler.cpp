@@ -0,0 +1,270 @@
+#include "turn_profiler.h"
+
+#include <algorithm>
+#include <ostream>
+#include <string>
+
+#include "cata_utility.h"
+#include "color.h"
+#include "cursesdef.h"
+#include "json.h"
+#include "output.h"
+#include "path_info.h"
+#include "translations.h"
+
+namespace turn_profiler
+{
+
+static bool option_enabled = false;
+static bool show_overlay = false;
+
+static std::array<phase_stats, num_phases> stats;
+static phase_stats turn_stats;
+/** Sum of the phases timed since the last call to @ref end_turn. */
+static std::chrono::nanoseconds current_turn = std::chrono::nanoseconds::zero();
+static bool current_turn_timed = false;
+
+static double to_ms( const std::chrono::nanoseconds &duration )
+{
+    return std::chrono::duration<double, std::milli>( duration ).count();
+}
+
+const char *phase_name( const phase p )
+{
+    switch( p ) {
+        case phase::events:
+            return "events";
+        case phase::hordes:
+            return "hordes";
+        case phase::autosave:
+            return "autosave";
+        case phase::weather:
+            return "weather";
+        case phase::activity:
+            return "activity";
+        case phase::sound_markers:
+            return "sound_markers";
+        case phase::scent:
+            return "scent";
+        case phase::floor_caches:
+            return "floor_caches";
+        case phase::vehmove:
+            return "vehmove";
+        case phase::vehicle_idle:
+            return "vehicle_idle";
+        case phase::map_prefetch:
+            return "map_prefetch";
+        case phase::process_fields:
+            return "process_fields";
+        case phase::process_active_items:
+            return "process_active_items";
+        case phase::process_sounds:
+            return "process_sounds";
+        case phase::build_map_cache:
+            return "build_map_cache";
+        case phase::monmove:
+            return "monmove";
+        case phase::overmap_npc_move:
+            return "overmap_npc_move";
+        case phase::player:
+            return "player";
+        case phase::player_items:
+            return "player_items";
+        case phase::num_phases:
+            break;
+    }
+    return "unknown";
+}
+
+void phase_stats::add( const std::chrono::nanoseconds duration )
+{
+    samples++;
+    total += duration;
+    last = duration;
+    max = std::max( max, duration );
+
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>( duration ).count();
+    int bucket = 0;
+    while( bucket < histogram_buckets - 1 && ( static_cast<int64_t>( 1 ) << bucket ) <= micros ) {
+        bucket++;
+    }
+    histogram[bucket]++;
+}
+
+void phase_stats::reset()
+{
+    *this = phase_stats();
+}
+
+double phase_stats::mean_ms() const
+{
+    if( samples == 0 ) {
+        return 0.0;
+    }
+    return to_ms( total ) / samples;
+}
+
+double phase_stats::percentile_ms( const double percentile ) const
+{
+    if( samples == 0 ) {
+        return 0.0;
+    }
+    const double wanted = samples * clamp( percentile, 0.0, 100.0 ) / 100.0;
+    uint64_t seen = 0;
+    for( int bucket = 0; bucket < histogram_buckets; bucket++ ) {
+        seen += histogram[bucket];
+        if( seen > 0 && seen >= wanted ) {
+            // Never report more than the actual maximum.
+            return std::min( ( static_cast<int64_t>( 1 ) << bucket ) / 1000.0, to_ms( max ) );
+        }
+    }
+    return to_ms( max );
+}
+
+scoped_timer::scoped_timer( const phase p ) : which( p ), active( enabled() )
+{
+    if( active ) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+scoped_timer::~scoped_timer()
+{
+    if( !active ) {
+        return;
+    }
+    const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+    stats[static_cast<int>( which )].add( elapsed );
+    current_turn += elapsed;
+    current_turn_timed = true;
+}
+
+bool enabled()
+{
+    return option_enabled || show_overlay;
+}
+
+void set_enabled( const bool value )
+{
+    option_enabled = value;
+}
+
+bool overlay_enabled()
+{
+    return show_overlay;
+}
+
+void toggle_overlay()
+{
+    show_overlay = !show_overlay;
+}
+
+void end_turn()
+{
+    if( current_turn_timed ) {
+        turn_stats.add( current_turn );
+    }
+    current_turn = std::chrono::nanoseconds::zero();
+    current_turn_timed = false;
+}
+
+void reset()
+{
+    for( phase_stats &elem : stats ) {
+        elem.reset();
+    }
+    turn_stats.reset();
+    current_turn = std::chrono::nanoseconds::zero();
+    current_turn_timed = false;
+}
+
+const phase_stats &get_stats( const phase p )
+{
+    return stats[static_cast<int>( p )];
+}
+
+const phase_stats &get_turn_stats()
+{
+    return turn_stats;
+}
+
+void draw_overlay( const catacurses::window &w )
+{
+    const auto draw_line = [&w]( const int y, const nc_color &col, const char *name,
+    const phase_stats & s ) {
+        mvwprintz( w, y, 0, col, "%-20s %8.2f %8.2f %8.2f %8.2f", name, to_ms( s.last ), s.mean_ms(),
+                   s.percentile_ms( 99 ), to_ms( s.max ) );
+    };
+
+    mvwprintz( w, 0, 0, c_white, "%-20s %8s %8s %8s %8s", "phase (ms)", "last", "mean", "p99", "max" );
+    int y = 1;
+    for( int i = 0; i < num_phases && y < getmaxy( w ); i++, y++ ) {
+        draw_line( y, c_light_gray, phase_name( static_cast<phase>( i ) ), stats[i] );
+    }
+    if( y < getmaxy( w ) ) {
+        draw_line( y, c_yellow, "turn", turn_stats );
+    }
+}
+
+static void write_csv_line( std::ostream &out, const char *name, const phase_stats &s )
+{
+    out << name << ',' << s.samples << ',' << to_ms( s.total ) << ',' << s.mean_ms() << ',' <<
+        s.percentile_ms( 50 ) << ',' << s.percentile_ms( 99 ) << ',' << to_ms( s.max );
+    for( const uint64_t count : s.histogram ) {
+        out << ',' << count;
+    }
+    out << '\n';
+}
+
+void write_csv( std::ostream &out )
+{
+    out << "phase,samples,total_ms,mean_ms,p50_ms,p99_ms,max_ms";
+    for( int bucket = 0; bucket < histogram_buckets; bucket++ ) {
+        out << ",lt_" << ( static_cast<int64_t>( 1 ) << bucket ) << "us";
+    }
+    out << '\n';
+    for( int i = 0; i < num_phases; i++ ) {
+        write_csv_line( out, phase_name( static_cast<phase>( i ) ), stats[i] );
+    }
+    write_csv_line( out, "turn", turn_stats );
+}
+
+static void write_json_stats( JsonOut &json, const phase_stats &s )
+{
+    json.start_object();
+    json.member( "samples", s.samples );
+    json.member( "total_ms", to_ms( s.total ) );
+    json.member( "mean_ms", s.mean_ms() );
+    json.member( "p50_ms", s.percentile_ms( 50 ) );
+    json.member( "p99_ms", s.percentile_ms( 99 ) );
+    json.member( "max_ms", to_ms( s.max ) );
+    json.member( "histogram_log2_us", s.histogram );
+    json.end_object();
+}
+
+void write_json( std::ostream &out )
+{
+    JsonOut json( out, true );
+    json.start_object();
+    json.member( "phases" );
+    json.start_object();
+    for( int i = 0; i < num_phases; i++ ) {
+        json.member( phase_name( static_cast<phase>( i ) ) );
+        write_json_stats( json, stats[i] );
+    }
+    json.end_object();
+    json.member( "turn" );
+    write_json_stats( json, turn_stats );
+    json.end_object();
+}
+
+void write_reports()
+{
+    if( turn_stats.samples == 0 ) {
+        return;
+    }
+    write_to_file( FILENAMES["turn_profile_csv"], write_csv, _( "turn profile" ) );
+    write_to_file( FILENAMES["turn_profile_json"], write_json, _( "turn profile" ) );
+}
+
+} // namespace turn_profiler
@@ -0,0 +1,126 @@
+#pragma once
+#ifndef TURN_PROFILER_H
+#define TURN_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+
+namespace catacurses
+{
+class window;
+} // namespace catacurses
+
+/**
+ * Built-in timing of the phases of @ref game::do_turn.
+ *
+ * Each phase is wrapped in a @ref turn_profiler::scoped_timer. While the profiler is
+ * enabled (debug option "TURN_PROFILER" or the debug menu overlay), the elapsed time of
+ * every phase is accumulated into a @ref turn_profiler::phase_stats, which keeps a
+ * log2 histogram so percentiles can be reported across the whole session.
+ * Waiting for player input is deliberately not part of any phase.
+ */
+namespace turn_profiler
+{
+
+enum class phase : int {
+    events = 0,
+    hordes,
+    autosave,
+    weather,
+    activity,
+    sound_markers,
+    scent,
+    floor_caches,
+    vehmove,
+    vehicle_idle,
+    map_prefetch,
+    process_fields,
+    process_active_items,
+    process_sounds,
+    build_map_cache,
+    monmove,
+    overmap_npc_move,
+    player,
+    player_items,
+    num_phases
+};
+
+constexpr int num_phases = static_cast<int>( phase::num_phases );
+/** Bucket `i` holds samples shorter than 2^i microseconds (and not in an earlier bucket). */
+constexpr int histogram_buckets = 32;
+
+const char *phase_name( phase p );
+
+struct phase_stats {
+    uint64_t samples = 0;
+    std::chrono::nanoseconds total = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds last = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds max = std::chrono::nanoseconds::zero();
+    std::array<uint64_t, histogram_buckets> histogram = {{}};
+
+    void add( std::chrono::nanoseconds duration );
+    void reset();
+    /** Mean duration in milliseconds, 0 if there are no samples. */
+    double mean_ms() const;
+    /**
+     * Upper bound (in milliseconds) of the histogram bucket containing the given
+     * percentile (0 - 100). This is exact to within a factor of two.
+     */
+    double percentile_ms( double percentile ) const;
+};
+
+/**
+ * Measures the time between its construction and destruction and adds it to the
+ * statistics of the given phase. Does nothing if the profiler is disabled.
+ */
+class scoped_timer
+{
+    public:
+        explicit scoped_timer( phase p );
+        ~scoped_timer();
+
+        scoped_timer( const scoped_timer & ) = delete;
+        scoped_timer &operator=( const scoped_timer & ) = delete;
+
+    private:
+        phase which;
+        bool active;
+        std::chrono::steady_clock::time_point start;
+};
+
+/** Whether timings are currently collected. */
+bool enabled();
+/** Sets the value of the "TURN_PROFILER" option, called once per turn. */
+void set_enabled( bool value );
+
+bool overlay_enabled();
+/** Toggles the on-screen overlay, the profiler collects timings while it is shown. */
+void toggle_overlay();
+
+/**
+ * Finishes a turn: the sum of all phases timed since the previous call is recorded
+ * as the duration of the whole turn.
+ */
+void end_turn();
+void reset();
+
+const phase_stats &get_stats( phase p );
+/** Statistics of whole turns (sum of all phases). */
+const phase_stats &get_turn_stats();
+
+/** Draws a table of the statistics into the top left corner of the window. */
+void draw_overlay( const catacurses::window &w );
+
+void write_csv( std::ostream &out );
+void write_json( std::ostream &out );
+/**
+ * Writes the CSV and JSON reports to the config directory, if any turn was profiled.
+ * Called when the game ends.
+ */
+void write_reports();
+
+} // namespace turn_profiler
+
+#endif
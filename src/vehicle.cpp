@@ -80,7 +80,7 @@ inline int modulo( int v, int m );
 point vehicles::cardinal_d[5] = { point( -1, 0 ), point( 1, 0 ), point( 0, -1 ), point( 0, 1 ), point_zero };
 
 // Vehicle stack methods.
-std::list<item>::iterator vehicle_stack::erase( std::list<item>::iterator it )
+vehicle_stack::iterator vehicle_stack::erase( vehicle_stack::const_iterator it )
 {
     return myorigin->remove_item( part_num, it );
 }
@@ -90,8 +90,7 @@ void vehicle_stack::push_back( const item &newitem )
     myorigin->add_item( part_num, newitem );
 }
 
-void vehicle_stack::insert_at( std::list<item>::iterator index,
-                               const item &newitem )
+void vehicle_stack::insert_at( const_iterator index, const item &newitem )
 {
     myorigin->add_item_at( part_num, index, newitem );
 }
@@ -4427,7 +4426,7 @@ bool vehicle::add_item( vehicle_part &pt, const item &obj )
     return add_item( idx, obj );
 }
 
-bool vehicle::add_item_at( int part, std::list<item>::iterator index, item itm )
+bool vehicle::add_item_at( int part, vehicle_stack::const_iterator index, item itm )
 {
     if( itm.is_bucket_nonempty() ) {
         for( auto &elem : itm.contents ) {
@@ -4437,7 +4436,7 @@ bool vehicle::add_item_at( int part, std::list<item>::iterator index, item itm )
         itm.contents.clear();
     }
 
-    const auto new_pos = parts[part].items.insert( index, itm );
+    const auto new_pos = parts[part].items.insert_before( index, itm );
     if( itm.needs_processing() ) {
         active_items.add( new_pos, parts[part].mount );
     }
@@ -4459,7 +4458,7 @@ bool vehicle::remove_item( int part, int itemdex )
 bool vehicle::remove_item( int part, const item *it )
 {
     bool rc = false;
-    std::list<item> &veh_items = parts[part].items;
+    item_colony &veh_items = parts[part].items;
 
     for( auto iter = veh_items.begin(); iter != veh_items.end(); iter++ ) {
         //delete the item if the pointer memory addresses are the same
@@ -4472,9 +4471,9 @@ bool vehicle::remove_item( int part, const item *it )
     return rc;
 }
 
-std::list<item>::iterator vehicle::remove_item( int part, std::list<item>::iterator it )
+vehicle_stack::iterator vehicle::remove_item( int part, vehicle_stack::const_iterator it )
 {
-    std::list<item> &veh_items = parts[part].items;
+    item_colony &veh_items = parts[part].items;
 
     if( active_items.has( it, parts[part].mount ) ) {
         active_items.remove( it, parts[part].mount );
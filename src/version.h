@@ -0,0 +1 @@
+#define VERSION "bf6ca1c"
@@ -11,6 +11,7 @@
 #include <unordered_map>
 #include <utility>
 
+#include "background_writer.h"
 #include "cata_utility.h"
 #include "catacharset.h"
 #include "char_validity_check.h"
@@ -205,6 +206,7 @@ WORLDPTR worldfactory::make_new_world( special_game_id special_type )
 void worldfactory::set_active_world( WORLDPTR world )
 {
     world_generator->active_world = world;
+    options_manager::note_values_changed();
 }
 
 bool WORLD::save( const bool is_conversion ) const
@@ -536,6 +538,7 @@ void worldfactory::remove_world( const std::string &worldname )
         WORLDPTR wptr = it->second.get();
         if( active_world == wptr ) {
             active_world = nullptr;
+            options_manager::note_values_changed();
         }
         all_worlds.erase( it );
     }
@@ -1378,6 +1381,7 @@ void WORLD::load_legacy_options( std::istream &fin )
 bool WORLD::load_options()
 {
     WORLD_OPTIONS = get_options().get_world_defaults();
+    options_manager::note_values_changed();
 
     using namespace std::placeholders;
     const auto path = folder_path() + "/" + FILENAMES["worldoptions"];
@@ -1465,6 +1469,12 @@ static bool isForbidden( const std::string &candidate )
 
 void worldfactory::delete_world( const std::string &worldname, const bool delete_folder )
 {
+    // Files of the last autosave may still be queued, they would come back afterwards.
+    try {
+        background_writer::wait();
+    } catch( const std::exception & ) {
+        // Failing to write files that are deleted anyway doesn't matter.
+    }
     std::string worldpath = get_world( worldname )->folder_path();
     std::set<std::string> directory_paths;
 
@@ -0,0 +1,111 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include "catch/catch.hpp"
+#include "background_writer.h"
+#include "filesystem.h"
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapbuffer.h"
+#include "overmapbuffer.h"
+#include "path_info.h"
+#include "type_id.h"
+#include "worldfactory.h"
+
+static std::string read_whole_file( const std::string &path )
+{
+    std::ifstream fin( path, std::ios::binary );
+    return std::string( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+}
+
+TEST_CASE( "background_writer_writes_files_in_queue_order", "[background_writer]" )
+{
+    const std::string dir = FILENAMES["savedir"] + "background_writer_test";
+    REQUIRE( assure_dir_exist( dir ) );
+    const std::string first = dir + "/first.txt";
+    const std::string second = dir + "/second.txt";
+    remove_file( first );
+    remove_file( second );
+
+    // Like an evicted map quad, the first file is only serialized on the worker,
+    // and here not before the test allows it.
+    std::atomic<bool> release( false );
+    background_writer::write( first, [&release]() {
+        while( !release ) {
+            std::this_thread::yield();
+        }
+        return std::string( "first" );
+    } );
+    background_writer::write( second, std::string( "second" ) );
+    CHECK( background_writer::is_pending( first ) );
+    CHECK( background_writer::is_pending( second ) );
+    CHECK_FALSE( background_writer::idle() );
+
+    // Like the player file behind the maps, the second file waits for the first.
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    CHECK_FALSE( file_exist( second ) );
+
+    release = true;
+    background_writer::wait_for( second );
+    CHECK_FALSE( background_writer::is_pending( first ) );
+    CHECK( read_whole_file( first ) == "first" );
+    CHECK( read_whole_file( second ) == "second" );
+
+    // The last write of a file wins.
+    background_writer::write( second, std::string( "older" ) );
+    background_writer::write( second, std::string( "newer" ) );
+    background_writer::wait();
+    CHECK( background_writer::idle() );
+    CHECK( read_whole_file( second ) == "newer" );
+
+    remove_file( first );
+    remove_file( second );
+    remove_directory( dir );
+}
+
+TEST_CASE( "background_writer_reports_failed_writes", "[background_writer]" )
+{
+    const std::string path = FILENAMES["savedir"] + "background_writer_no_such_dir/file.txt";
+    background_writer::write( path, std::string( "lost" ) );
+    CHECK_THROWS( background_writer::wait() );
+    // wait() took the error, it is not reported twice.
+    CHECK( background_writer::take_errors().empty() );
+    CHECK_FALSE( file_exist( path ) );
+}
+
+TEST_CASE( "maps_saved_in_the_background_can_be_loaded_at_once", "[background_writer]" )
+{
+    clear_map();
+    const tripoint spot( 50, 50, 0 );
+    g->m.ter_set( spot, ter_id( "t_dirt" ) );
+    // clear_map() leaves the items of earlier tests.
+    g->m.i_clear( spot );
+    g->m.add_item( spot, item( "rock" ) );
+
+    // The files of the save queue up behind this one, so they are still being
+    // written when the map is loaded again.
+    const std::string slow = g->get_world_base_save_path() + "/background_writer_slow.txt";
+    background_writer::write( slow, []() {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+        return std::string( "slow" );
+    } );
+    REQUIRE( g->save( true ) );
+    CHECK_FALSE( background_writer::idle() );
+
+    MAPBUFFER.reset();
+    overmap_buffer.clear();
+    g->m.load( g->get_levx(), g->get_levy(), g->get_levz(), false );
+    CHECK( g->m.ter( spot ) == ter_id( "t_dirt" ) );
+    REQUIRE( g->m.i_at( spot ).size() == 1 );
+    CHECK( g->m.i_at( spot ).begin()->typeId() == "rock" );
+
+    background_writer::wait();
+    // Later tests would load the overmaps of this save instead of generating them.
+    world_generator->delete_world( world_generator->active_world->world_name, false );
+}
@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "calendar.h"
+#include "field.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+
+TEST_CASE( "field_keeps_one_entry_per_type", "[field]" )
+{
+    field fld;
+    CHECK( fld.field_count() == 0 );
+    CHECK( fld.field_symbol() == fd_null );
+
+    CHECK( fld.add_field( fd_smoke, 1 ) );
+    CHECK( fld.add_field( fd_blood, 1 ) );
+    CHECK( fld.add_field( fd_fire, 2 ) );
+    // Adding an existing type only raises its density.
+    CHECK_FALSE( fld.add_field( fd_smoke, 1 ) );
+    REQUIRE( fld.field_count() == 3 );
+    REQUIRE( fld.find_field( fd_smoke ) != nullptr );
+    CHECK( fld.find_field( fd_smoke )->get_field_intensity() == 2 );
+    CHECK( fld.find_field( fd_acid ) == nullptr );
+
+    // Iteration is ordered by type, whatever order the fields were added in.
+    std::vector<field_id> types;
+    for( const auto &entry : fld ) {
+        types.push_back( entry.first );
+    }
+    CHECK( types.size() == 3 );
+    CHECK( std::is_sorted( types.begin(), types.end() ) );
+
+    CHECK( fld.remove_field( fd_fire ) );
+    CHECK_FALSE( fld.remove_field( fd_fire ) );
+    CHECK( fld.field_count() == 2 );
+
+    auto it = fld.begin();
+    while( it != fld.end() ) {
+        it = fld.remove_field( it );
+    }
+    CHECK( fld.field_count() == 0 );
+    CHECK( fld.field_symbol() == fd_null );
+}
+
+TEST_CASE( "field_processing_keeps_changes_to_the_processed_entry", "[field]" )
+{
+    clear_map();
+    const tripoint pos( 65, 65, 0 );
+    // A weak fire vent turns itself off and starts a flame burst on its tile, which
+    // is processed in the same pass and weakens itself.
+    REQUIRE( g->m.add_field( pos, fd_fire_vent, 1, 1_turns ) );
+    g->m.process_fields();
+
+    CHECK( g->m.get_field( pos, fd_fire_vent ) == nullptr );
+    const field_entry *const burst = g->m.get_field( pos, fd_flame_burst );
+    REQUIRE( burst != nullptr );
+    CHECK( burst->get_field_intensity() == 2 );
+    CHECK( burst->get_field_age() == 2_turns );
+}
@@ -1,7 +1,9 @@
 #include <initializer_list>
 #include <limits>
 #include <list>
-
+#include <sstream>
+#include <string>
+#include <vector>
 #include "catch/catch.hpp"
 #include "calendar.h"
 #include "itype.h"
@@ -10,6 +12,8 @@
 #include "item.h"
 #include "enums.h"
 #include "optional.h"
+#include "flag.h"
+#include "json.h"
 
 TEST_CASE( "item_volume", "[item]" )
 {
@@ -147,3 +151,63 @@ TEST_CASE( "stacking_over_time", "[item]" )
         }
     }
 }
+
+TEST_CASE( "item_flags_by_name_and_id", "[item]" )
+{
+    item i( "tshirt" );
+    const flag_id varsize( "VARSIZE" );
+    const flag_id fit( "FIT" );
+    REQUIRE( i.has_flag( "VARSIZE" ) );
+    CHECK( i.has_flag( varsize ) );
+    CHECK_FALSE( i.has_flag( fit ) );
+
+    i.item_tags.insert( "FIT" );
+    CHECK( i.has_flag( "FIT" ) );
+    CHECK( i.has_flag( fit ) );
+    CHECK( i.item_tags.count( fit ) == 1 );
+
+    i.item_tags.erase( fit );
+    CHECK_FALSE( i.has_flag( "FIT" ) );
+
+    // Looking up a name that no flag set ever held does not intern it.
+    CHECK_FALSE( i.has_flag( "NOT_A_FLAG_ANYWHERE" ) );
+    CHECK_FALSE( flag_id::find( "NOT_A_FLAG_ANYWHERE" ) );
+    CHECK( flag_id( "FIT" ) == fit );
+    CHECK( fit.str() == "FIT" );
+}
+
+TEST_CASE( "item_flags_written_sorted_by_name", "[item]" )
+{
+    // Interned after the data was loaded, so they get the highest ids and are
+    // only found through the locked part of the registry.
+    flag_set flags;
+    flags.insert( "ZZZ_TEST_FLAG_LATE" );
+    flags.insert( "AAA_TEST_FLAG_LATE" );
+    flags.insert( "VARSIZE" );
+    CHECK( flag_id::find( "AAA_TEST_FLAG_LATE" ) );
+    CHECK( flag_id( "ZZZ_TEST_FLAG_LATE" ).str() == "ZZZ_TEST_FLAG_LATE" );
+
+    std::ostringstream os;
+    JsonOut jsout( os );
+    flags.serialize( jsout );
+    CHECK( os.str() == R"(["AAA_TEST_FLAG_LATE","VARSIZE","ZZZ_TEST_FLAG_LATE"])" );
+
+    std::istringstream is( os.str() );
+    JsonIn jsin( is );
+    flag_set read;
+    read.deserialize( jsin );
+    CHECK( read == flags );
+
+    // The same flags added in another order give the same names and JSON.
+    flag_set reversed;
+    reversed.insert( "VARSIZE" );
+    reversed.insert( "AAA_TEST_FLAG_LATE" );
+    reversed.insert( "ZZZ_TEST_FLAG_LATE" );
+    const std::vector<std::string> expected_names = { "AAA_TEST_FLAG_LATE", "VARSIZE", "ZZZ_TEST_FLAG_LATE" };
+    CHECK( flags.sorted_names() == expected_names );
+    CHECK( reversed.sorted_names() == expected_names );
+    std::ostringstream reversed_os;
+    JsonOut reversed_jsout( reversed_os );
+    reversed.serialize( reversed_jsout );
+    CHECK( reversed_os.str() == os.str() );
+}
@@ -0,0 +1,156 @@
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "filesystem.h"
+#include "init.h"
+#include "json.h"
+#include "parallel.h"
+#include "string_formatter.h"
+
+static const std::string sample_json =
+    "[\n"
+    "  {\n"
+    "    \"type\": \"test\", \"id\": \"plain\", \"//\": \"first\", \"//\": \"second\",\n"
+    "    \"escaped\": \"tab\\there \\\"quoted\\\" \\u00e9\",\n"
+    "    \"number\": -12.5e1, \"int\": 42, \"flag\": true, \"nothing\": null,\n"
+    "    \"list\": [ 1, 2, 3 ], \"nested\": { \"name\": \"inner\" }\n"
+    "  },\n"
+    "  { \"type\": \"test\", \"id\": \"second\", \"tags\": \"single\" }\n"
+    "]\n";
+
+struct sample_contents {
+    std::vector<std::string> ids;
+    std::string escaped;
+    double number = 0;
+    int int_value = 0;
+    bool flag = false;
+    bool has_null = false;
+    std::vector<int> list;
+    std::string nested_name;
+    std::set<std::string> member_names;
+    std::set<std::string> tags;
+};
+
+static sample_contents read_sample( JsonIn &jsin )
+{
+    sample_contents ret;
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        JsonObject jo = jsin.get_object();
+        ret.ids.push_back( jo.get_string( "id" ) );
+        if( jo.has_member( "escaped" ) ) {
+            ret.escaped = jo.get_string( "escaped" );
+            ret.number = jo.get_float( "number" );
+            ret.int_value = jo.get_int( "int" );
+            ret.flag = jo.get_bool( "flag" );
+            ret.has_null = jo.has_null( "nothing" );
+            ret.list = jo.get_int_array( "list" );
+            ret.nested_name = jo.get_object( "nested" ).get_string( "name" );
+            ret.member_names = jo.get_member_names();
+        } else {
+            ret.tags = jo.get_tags( "tags" );
+        }
+        CHECK( jo.get_int( "missing", 7 ) == 7 );
+        CHECK_FALSE( jo.has_member( "missing" ) );
+    }
+    return ret;
+}
+
+static void check_sample( const sample_contents &contents )
+{
+    CHECK( contents.ids == std::vector<std::string> { "plain", "second" } );
+    CHECK( contents.escaped == "tab\there \"quoted\" \xc3\xa9" );
+    CHECK( contents.number == Approx( -125.0 ) );
+    CHECK( contents.int_value == 42 );
+    CHECK( contents.flag );
+    CHECK( contents.has_null );
+    CHECK( contents.list == std::vector<int> { 1, 2, 3 } );
+    CHECK( contents.nested_name == "inner" );
+    CHECK( contents.member_names.size() == 10 );
+    CHECK( contents.tags == std::set<std::string> { "single" } );
+}
+
+TEST_CASE( "json_stream_and_buffer_readers_agree", "[json]" )
+{
+    SECTION( "stream" ) {
+        std::istringstream stream( sample_json );
+        JsonIn jsin( stream );
+        check_sample( read_sample( jsin ) );
+        jsin.eat_whitespace();
+        CHECK_FALSE( jsin.good() );
+    }
+    SECTION( "buffer" ) {
+        JsonIn jsin( sample_json.data(), sample_json.size() );
+        check_sample( read_sample( jsin ) );
+        jsin.eat_whitespace();
+        CHECK_FALSE( jsin.good() );
+    }
+}
+
+TEST_CASE( "json_buffer_reader_reports_errors", "[json]" )
+{
+    const std::string duplicate = "{ \"id\": \"a\",\n  \"id\": \"b\" }";
+    JsonIn dup_jsin( duplicate.data(), duplicate.size() );
+    CHECK_THROWS_WITH( dup_jsin.get_object(), Catch::Contains( "line 2" ) &&
+                       Catch::Contains( "duplicate entry in json object" ) );
+
+    const std::string unterminated = "[ \"never closed ]";
+    JsonIn str_jsin( unterminated.data(), unterminated.size() );
+    str_jsin.start_array();
+    CHECK_THROWS_AS( str_jsin.get_string(), JsonError );
+
+    const std::string bad_bool = "[ trve ]";
+    JsonIn bool_jsin( bad_bool.data(), bad_bool.size() );
+    bool_jsin.start_array();
+    CHECK_THROWS_WITH( bool_jsin.get_bool(), Catch::Contains( "expected \"true\"" ) );
+}
+
+TEST_CASE( "json_objects_kept_in_a_growing_vector", "[json]" )
+{
+    std::string data = "[";
+    for( int i = 0; i < 100; i++ ) {
+        data += string_format( "%s{ \"n\": %d }", i == 0 ? "" : ", ", i );
+    }
+    data += "]";
+    JsonIn jsin( data.data(), data.size() );
+    // Growing the vector moves the objects it already holds, which must not move the stream.
+    std::vector<JsonObject> objects;
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        objects.push_back( jsin.get_object() );
+    }
+    REQUIRE( objects.size() == 100 );
+    for( int i = 0; i < 100; i++ ) {
+        CHECK( objects[i].get_int( "n" ) == i );
+    }
+}
+
+TEST_CASE( "json_files_load_in_the_same_order_in_parallel", "[json]" )
+{
+    const std::vector<std::string> files = get_files_from_path( ".json", "data/json/items", true,
+                                           true );
+    REQUIRE( files.size() > 16 );
+    const auto load_all = [&files]() {
+        std::vector<std::string> loaded;
+        load_json_files_in_order( files, [&loaded]( const std::string & file, JsonObject & jo ) {
+            loaded.push_back( file + ": " + jo.str() );
+        } );
+        return loaded;
+    };
+
+    std::vector<std::string> serial;
+    {
+        cata::scoped_worker_count workers( 1 );
+        serial = load_all();
+    }
+    std::vector<std::string> parallel;
+    {
+        cata::scoped_worker_count workers( 4 );
+        parallel = load_all();
+    }
+    CHECK( serial.size() > files.size() );
+    CHECK( serial == parallel );
+}
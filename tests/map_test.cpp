@@ -1,14 +1,24 @@
+#include <iterator>
+#include <list>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "avatar.h"
 #include "catch/catch.hpp"
+#include "coordinate_conversions.h"
 #include "game.h"
+#include "item.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "mapbuffer.h"
 #include "player.h"
+#include "rng.h"
+#include "submap.h"
 #include "enums.h"
 #include "game_constants.h"
 #include "type_id.h"
+#include "vehicle.h"
 
 TEST_CASE( "destroy_grabbed_furniture" )
 {
@@ -78,3 +88,186 @@ TEST_CASE( "tinymap_bounds_checking" )
         }
     }
 }
+
+TEST_CASE( "map_stack_items_keep_their_address" )
+{
+    clear_map();
+    const tripoint pos( 60, 60, 0 );
+    for( int i = 0; i < 20; i++ ) {
+        g->m.add_item( pos, item( i % 2 ? "rock" : "apple" ) );
+    }
+    map_stack stack = g->m.i_at( pos );
+    REQUIRE( stack.size() == 20 );
+
+    std::vector<item *> kept;
+    for( auto it = stack.begin(); it != stack.end(); ) {
+        if( it->typeId() == "rock" ) {
+            it = stack.erase( it );
+        } else {
+            kept.push_back( &*it );
+            ++it;
+        }
+    }
+    CHECK( stack.size() == 10 );
+    for( item *it : kept ) {
+        CHECK( it->typeId() == "apple" );
+        CHECK( &*stack.get_iterator_from_pointer( it ) == it );
+    }
+
+    // New items go on top, even when they take the slot of an erased one.
+    item &added = g->m.add_item( pos, item( "rock" ) );
+    CHECK( &*std::prev( stack.end() ) == &added );
+    CHECK( g->m.maptile_at( pos ).get_uppermost_item().typeId() == "rock" );
+    for( item *it : kept ) {
+        CHECK( it->typeId() == "apple" );
+    }
+    g->m.i_clear( pos );
+    CHECK( g->m.i_at( pos ).empty() );
+}
+
+TEST_CASE( "map_stack_keeps_insertion_order" )
+{
+    clear_map();
+    const tripoint pos( 60, 60, 0 );
+    const std::vector<std::string> types = { "rock", "apple", "bread", "rock", "apple", "2x4", "bread" };
+    for( const std::string &type : types ) {
+        g->m.add_item( pos, item( type ) );
+    }
+    map_stack stack = g->m.i_at( pos );
+    const auto current_types = [&stack]() {
+        std::vector<std::string> result;
+        for( const item &it : stack ) {
+            result.push_back( it.typeId() );
+        }
+        return result;
+    };
+    REQUIRE( current_types() == types );
+    CHECK( g->m.maptile_at( pos ).get_uppermost_item().typeId() == "bread" );
+
+    // Processing takes the food out and puts it back where it was.
+    for( int i = 0; i < 5; i++ ) {
+        g->m.process_active_items();
+    }
+    CHECK( current_types() == types );
+
+    // Items put back in front of the item after them end up where they were.
+    for( size_t i = 0; i < types.size(); i++ ) {
+        auto it = std::next( stack.begin(), i );
+        const item copy = *it;
+        stack.insert_at( stack.erase( it ), copy );
+        CHECK( current_types() == types );
+    }
+    g->m.i_clear( pos );
+}
+
+static std::vector<int> charges_of( const item_colony &items )
+{
+    std::vector<int> result;
+    for( const item &it : items ) {
+        result.push_back( it.charges );
+    }
+    return result;
+}
+
+TEST_CASE( "item_colony_keeps_insertion_order" )
+{
+    // Erasing frees colony slots that later insertions reuse, which must not change the order.
+    item_colony items;
+    items.change_minimum_group_size( 4 );
+    std::list<int> expected;
+    item rock( "rock" );
+    for( int i = 0; i < 1000; i++ ) {
+        rock.charges = i;
+        if( !expected.empty() && one_in( 3 ) ) {
+            const int index = rng( 0, expected.size() - 1 );
+            const auto erased = items.erase( std::next( items.cbegin(), index ) );
+            const auto next = expected.erase( std::next( expected.begin(), index ) );
+            CHECK( ( erased == items.end() ) == ( next == expected.end() ) );
+        } else if( !expected.empty() && one_in( 2 ) ) {
+            const int index = rng( 0, expected.size() );
+            const auto added = items.insert_before( std::next( items.cbegin(), index ), rock );
+            expected.insert( std::next( expected.begin(), index ), i );
+            CHECK( &*items.get_iterator_from_pointer( &*added ) == &*added );
+        } else {
+            items.insert( rock );
+            expected.push_back( i );
+        }
+    }
+    const std::vector<int> order( expected.begin(), expected.end() );
+    REQUIRE( items.size() == expected.size() );
+    CHECK( charges_of( items ) == order );
+
+    std::vector<int> reversed;
+    for( auto it = items.crbegin(); it != items.crend(); ++it ) {
+        reversed.push_back( it->charges );
+    }
+    CHECK( reversed == std::vector<int>( order.rbegin(), order.rend() ) );
+
+    const item_colony copy = items;
+    CHECK( charges_of( copy ) == order );
+    const item *const last = &*std::prev( items.end() );
+    const item_colony moved = std::move( items );
+    CHECK( charges_of( moved ) == order );
+    CHECK( &*std::prev( moved.end() ) == last );
+    CHECK( items.empty() );
+}
+
+TEST_CASE( "mapbuffer_visits_submaps_with_vehicles" )
+{
+    clear_map();
+    const auto visited = []( const vehicle * veh ) {
+        bool found = false;
+        MAPBUFFER.for_each_vehicle_submap( [&]( const tripoint &, submap & sm ) {
+            for( const auto &elem : sm.vehicles ) {
+                found = found || elem.get() == veh;
+            }
+        } );
+        return found;
+    };
+
+    tripoint vehicle_pos( 60, 60, 0 );
+    vehicle *veh = g->m.add_vehicle( vproto_id( "bicycle" ), vehicle_pos, 0, 0, 0 );
+    REQUIRE( veh != nullptr );
+    CHECK( visited( veh ) );
+
+    // Moving it onto another submap keeps it visible.
+    veh = g->m.displace_vehicle( vehicle_pos, tripoint( SEEX * 2, 0, 0 ) );
+    REQUIRE( veh != nullptr );
+    CHECK( visited( veh ) );
+
+    clear_map();
+    CHECK_FALSE( visited( veh ) );
+}
+
+TEST_CASE( "field_processing_tracks_tiles_with_fields" )
+{
+    clear_map();
+    const tripoint pos( 65, 65, 0 );
+    const tripoint abs_pos = g->m.getabs( pos );
+    submap *const sm = MAPBUFFER.lookup_submap( tripoint( ms_to_sm_copy( abs_pos.x, abs_pos.y ),
+                       abs_pos.z ) );
+    REQUIRE( sm != nullptr );
+    const point local( pos.x % SEEX, pos.y % SEEY );
+    REQUIRE_FALSE( sm->may_have_field( local ) );
+
+    REQUIRE( g->m.add_field( pos, fd_smoke, 3 ) );
+    CHECK( sm->may_have_field( local ) );
+
+    // The smoke gets processed, and the tile forgotten once it is gone.
+    for( int i = 0; i < 10000 && sm->field_count > 0; i++ ) {
+        g->m.process_fields();
+    }
+    CHECK( sm->field_count == 0 );
+    CHECK_FALSE( sm->may_have_field( local ) );
+}
+
+TEST_CASE( "prefetch_shift_prepares_the_submaps_a_shift_loads" )
+{
+    clear_map();
+    const tripoint abs_sub = g->m.get_abs_sub();
+    const int mapsize = g->m.getmapsize();
+    g->m.prefetch_shift( 1, 0, mapsize );
+    for( int gridy = 0; gridy < mapsize; gridy++ ) {
+        CHECK( MAPBUFFER.is_stored( abs_sub + tripoint( mapsize, gridy, 0 ) ) );
+    }
+}
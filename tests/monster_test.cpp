@@ -1,4 +1,6 @@
 #include <math.h>
+#include <algorithm>
+#include <array>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -15,7 +17,10 @@
 #include "map_helpers.h"
 #include "monster.h"
 #include "options.h"
+#include "parallel.h"
 #include "player.h"
+#include "player_helpers.h"
+#include "rng.h"
 #include "test_statistics.h"
 #include "enums.h"
 #include "game_constants.h"
@@ -336,3 +341,106 @@ TEST_CASE( "monster_speed_trig", "[speed]" )
     trigdist = true;
     monster_check();
 }
+
+// Hostile zombies around the player, and some friendly ones they may go for instead.
+// All of them are a few turns away from a fight.
+static std::vector<monster *> spawn_monmove_scenario( const bool with_pets = true )
+{
+    clear_map();
+    // The zombies of an earlier run may have hurt or grabbed the player.
+    clear_player();
+    g->u.clear_effects();
+    g->u.healall( 1000 );
+    std::vector<monster *> monsters;
+    const std::array<int, 4> columns{{ -14, -7, 7, 14 }};
+    for( int i = 0; i < 12; i++ ) {
+        const tripoint offset( columns[i % 4], ( i / 4 - 1 ) * 10, 0 );
+        monster &mon = spawn_test_monster( "mon_zombie", g->u.pos() + offset );
+        if( with_pets && i % 3 == 0 ) {
+            mon.friendly = -1;
+        }
+        monsters.push_back( &mon );
+    }
+    return monsters;
+}
+
+// Same as in game::monmove
+static mfactions monster_factions()
+{
+    mfactions factions;
+    for( monster &critter : g->all_monsters() ) {
+        factions[critter.friendly == 0 ? critter.faction : mfaction_str_id( "player" )].insert( &critter );
+    }
+    return factions;
+}
+
+TEST_CASE( "monster_targets_do_not_depend_on_the_workers", "[monster]" )
+{
+    // Targets chosen up front, as game::monmove does, and the destinations planned with them.
+    const auto plan_ahead = []( const unsigned int workers, std::vector<tripoint> &targets ) {
+        const std::vector<monster *> monsters = spawn_monmove_scenario();
+        const mfactions factions = monster_factions();
+        std::vector<monster::target_selection> selections( monsters.size() );
+        {
+            cata::scoped_worker_count count( workers );
+            cata::parallel_for( monsters.size(), [&]( const size_t i ) {
+                selections[i] = monsters[i]->find_target( factions );
+            }, 1 );
+        }
+        std::vector<tripoint> destinations;
+        for( size_t i = 0; i < monsters.size(); i++ ) {
+            const Creature *target = selections[i].target;
+            targets.push_back( target == nullptr ? tripoint_min : target->pos() );
+            monsters[i]->plan( factions, selections[i] );
+            destinations.push_back( monsters[i]->move_target() );
+        }
+        return destinations;
+    };
+
+    std::vector<tripoint> serial_targets;
+    std::vector<tripoint> parallel_targets;
+    const std::vector<tripoint> serial = plan_ahead( 1, serial_targets );
+    const std::vector<tripoint> parallel = plan_ahead( 4, parallel_targets );
+    // Some of them have something to go for
+    CHECK( std::count( serial_targets.begin(), serial_targets.end(), tripoint_min ) < 12 );
+    CHECK( serial_targets == parallel_targets );
+    CHECK( serial == parallel );
+
+    // Same as choosing the target in monster::plan itself
+    const std::vector<monster *> monsters = spawn_monmove_scenario();
+    const mfactions factions = monster_factions();
+    std::vector<tripoint> planned;
+    for( monster *mon : monsters ) {
+        mon->plan( factions );
+        planned.push_back( mon->move_target() );
+    }
+    CHECK( planned == serial );
+}
+
+TEST_CASE( "monmove_does_not_depend_on_the_workers", "[monster]" )
+{
+    // Hostile monsters only: the monsters of a faction are ordered by their address, which
+    // decides between equally good targets and differs between the runs.
+    const auto positions_after_monmove = []( const unsigned int workers ) {
+        spawn_monmove_scenario( false );
+        cata::scoped_worker_count count( workers );
+        rng_set_engine_seed( 1234 );
+        for( int turn = 0; turn < 3; turn++ ) {
+            for( monster &critter : g->all_monsters() ) {
+                critter.mod_moves( critter.get_speed() );
+            }
+            g->monmove();
+        }
+        std::vector<tripoint> positions;
+        for( monster &critter : g->all_monsters() ) {
+            positions.push_back( critter.pos() );
+        }
+        return positions;
+    };
+
+    const std::vector<tripoint> serial = positions_after_monmove( 1 );
+    const std::vector<tripoint> parallel = positions_after_monmove( 4 );
+    REQUIRE( serial.size() == 12 );
+    CHECK( serial == parallel );
+    clear_creatures();
+}
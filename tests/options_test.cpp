@@ -0,0 +1,22 @@
+#include "catch/catch.hpp"
+#include "options.h"
+
+TEST_CASE( "option_handle_follows_option_changes", "[options]" )
+{
+    options_manager::cOpt &opt = get_options().get_option( "FORCE_REDRAW" );
+    const std::string old_value = opt.getValue();
+
+    const option_handle<bool> handle( "FORCE_REDRAW" );
+    opt.setValue( "true" );
+    CHECK( handle.get() );
+    CHECK( handle.get() == get_option<bool>( "FORCE_REDRAW" ) );
+
+    opt.setValue( "false" );
+    CHECK_FALSE( handle.get() );
+
+    opt.setNext();
+    CHECK( handle.get() );
+
+    opt.setValue( old_value );
+    CHECK( handle.get() == get_option<bool>( "FORCE_REDRAW" ) );
+}
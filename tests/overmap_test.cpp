@@ -1,11 +1,17 @@
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "catch/catch.hpp"
 #include "map.h"
+#include "mongroup.h"
+#include "options.h"
 #include "overmap.h"
 #include "overmapbuffer.h"
+#include "overmap_pregen.h"
+#include "parallel.h"
+#include "rng.h"
 #include "calendar.h"
 #include "common_types.h"
 #include "enums.h"
@@ -103,3 +109,127 @@ TEST_CASE( "default_overmap_generation_has_non_mandatory_specials_at_origin" )
     CHECK( found_optional == true );
 }
 
+
+TEST_CASE( "find_closest_and_find_all_see_terrain_changes", "[overmap]" )
+{
+    overmap_buffer.get( 0, 0 );
+    const tripoint origin( OMAPX / 2, OMAPY / 2, 0 );
+    const tripoint near_spot = origin + tripoint( 5, 3, 0 );
+    const tripoint far_spot = origin + tripoint( -7, 0, 0 );
+    const oter_id near_old = overmap_buffer.ter( near_spot );
+    const oter_id far_old = overmap_buffer.ter( far_spot );
+    overmap_buffer.ter_set( near_spot, oter_id( "tutorial" ) );
+    overmap_buffer.ter_set( far_spot, oter_id( "tutorial" ) );
+
+    CHECK( overmap_buffer.find_closest( origin, "tutorial", 20, false, false, true ) == near_spot );
+    const std::vector<tripoint> found = overmap_buffer.find_all( origin, "tutorial", 20, false,
+                                        false, true );
+    CHECK( found == std::vector<tripoint>( { far_spot, near_spot } ) );
+
+    overmap_buffer.ter_set( near_spot, near_old );
+    CHECK( overmap_buffer.find_closest( origin, "tutorial", 20, false, false, true ) == far_spot );
+    overmap_buffer.ter_set( far_spot, far_old );
+    CHECK( overmap_buffer.find_closest( origin, "tutorial", 20, false, false,
+                                        true ) == overmap::invalid_tripoint );
+
+    // The indexed search finds the same roads as looking at every tile.
+    std::vector<tripoint> roads;
+    for( int x = -30; x <= 30; x++ ) {
+        for( int y = -30; y <= 30; y++ ) {
+            const tripoint p = origin + tripoint( x, y, 0 );
+            if( is_ot_type( "road", overmap_buffer.ter( p ) ) ) {
+                roads.push_back( p );
+            }
+        }
+    }
+    CHECK( overmap_buffer.find_all( origin, "road", 30, false, false, true ) == roads );
+}
+
+TEST_CASE( "overmaps_ahead_are_generated_in_the_background", "[overmap]" )
+{
+    const point home( 50, 50 );
+    overmap_buffer.get( home.x, home.y );
+    const point ahead = home + point( 1, 0 );
+    const point behind = home + point( -1, 0 );
+    REQUIRE_FALSE( overmap_buffer.has( ahead.x, ahead.y ) );
+
+    // Close to the east edge, heading east.
+    const tripoint omt_pos( home.x * OMAPX + OMAPX - 10, home.y * OMAPY + OMAPY / 2, 0 );
+    overmap_buffer.pregenerate_near( omt_pos, point( 1, 0 ) );
+    CHECK( overmap_pregen::is_pending( ahead ) );
+    CHECK_FALSE( overmap_pregen::is_pending( behind ) );
+
+    // Getting it takes the one from the background (or generates it if that failed).
+    const overmap &om = overmap_buffer.get( ahead.x, ahead.y );
+    CHECK( om.pos() == ahead );
+    CHECK_FALSE( overmap_pregen::is_pending( ahead ) );
+    CHECK( overmap_buffer.has( ahead.x, ahead.y ) );
+}
+
+TEST_CASE( "planned_horde_moves_do_not_depend_on_the_workers", "[overmap]" )
+{
+    // Moves the hordes of fresh overmaps a few times and returns the overmaps as saved.
+    const auto move_hordes = []( const unsigned int workers, const int turns ) {
+        std::vector<std::unique_ptr<overmap>> overmaps;
+        std::vector<overmap *> pointers;
+        for( int i = 0; i < 4; i++ ) {
+            overmaps.push_back( std::make_unique<overmap>( 100 + i, 100 ) );
+            pointers.push_back( overmaps.back().get() );
+            for( int h = 0; h < 20; h++ ) {
+                mongroup group( mongroup_id( "GROUP_ZOMBIE" ), 10 + h * 3, 20 + h * 2, 0, 1, 10 );
+                group.horde = true;
+                overmaps.back()->add_mon_group( group );
+            }
+        }
+        cata::scoped_worker_count count( workers );
+        rng_set_engine_seed( 4321 );
+        for( int turn = 0; turn < turns; turn++ ) {
+            overmap_buffer.move_hordes( pointers );
+        }
+        std::vector<std::string> saved;
+        for( const std::unique_ptr<overmap> &om : overmaps ) {
+            std::ostringstream os;
+            om->serialize( os );
+            saved.push_back( os.str() );
+        }
+        return saved;
+    };
+
+    get_options().get_option( "PARALLEL_HORDES" ).setValue( "true" );
+    const std::vector<std::string> unmoved = move_hordes( 1, 0 );
+    const std::vector<std::string> serial = move_hordes( 1, 20 );
+    const std::vector<std::string> parallel = move_hordes( 4, 20 );
+    get_options().get_option( "PARALLEL_HORDES" ).setValue( "false" );
+    CHECK( serial != unmoved );
+    CHECK( serial == parallel );
+}
+
+TEST_CASE( "map_layer_only_allocates_what_differs", "[overmap]" )
+{
+    const oter_id air( "open_air" );
+    const oter_id field( "field" );
+    map_layer layer;
+    layer.fill( air );
+    CHECK( layer.is_uniform() );
+    CHECK( layer.get_ter( 10, 20 ) == air );
+
+    layer.ter( 10, 20 ) = field;
+    CHECK_FALSE( layer.is_uniform() );
+    CHECK( layer.get_ter( 10, 20 ) == field );
+    CHECK( layer.get_ter( 20, 10 ) == air );
+    layer.compact();
+    CHECK_FALSE( layer.is_uniform() );
+
+    layer.ter( 10, 20 ) = air;
+    layer.compact();
+    CHECK( layer.is_uniform() );
+    CHECK( layer.get_ter( 10, 20 ) == air );
+
+    CHECK_FALSE( layer.is_visible( 5, 6 ) );
+    layer.set_visible( 5, 6, true );
+    layer.set_explored( 6, 5, true );
+    CHECK( layer.is_visible( 5, 6 ) );
+    CHECK_FALSE( layer.is_visible( 6, 5 ) );
+    CHECK( layer.is_explored( 6, 5 ) );
+    CHECK_FALSE( layer.is_explored( 5, 6 ) );
+}
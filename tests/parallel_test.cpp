@@ -0,0 +1,31 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "parallel.h"
+
+TEST_CASE( "parallel_for_visits_every_index_once", "[parallel]" )
+{
+    for( const size_t count : { 0, 1, 31, 1000 } ) {
+        std::vector<int> visits( count, 0 );
+        cata::parallel_for( count, [&visits]( const size_t i ) {
+            visits[i]++;
+        } );
+        for( const int v : visits ) {
+            CHECK( v == 1 );
+        }
+    }
+}
+
+TEST_CASE( "parallel_for_rethrows", "[parallel]" )
+{
+    std::atomic<int> calls( 0 );
+    CHECK_THROWS_AS( cata::parallel_for( 1000, [&calls]( const size_t i ) {
+        calls++;
+        if( i == 500 ) {
+            throw std::runtime_error( "failed" );
+        }
+    }, 1 ), std::runtime_error );
+    CHECK( calls > 0 );
+}
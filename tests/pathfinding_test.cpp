@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "game.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "pathfinding.h"
+#include "enums.h"
+#include "type_id.h"
+
+static const pathfinding_settings walking( 0, 1000, 1000, 0, false, false, true, false );
+
+// A wall across the whole map with a single gap far away from the direct line.
+static void build_wall_with_gap( const int wall_x, const int gap_y )
+{
+    const int mapsize = g->m.getmapsize() * SEEY;
+    for( int y = 0; y < mapsize; y++ ) {
+        if( y != gap_y ) {
+            g->m.ter_set( tripoint( wall_x, y, 0 ), ter_id( "t_rock" ) );
+        }
+    }
+}
+
+static bool is_connected( const tripoint &from, const std::vector<tripoint> &route )
+{
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        if( square_dist( prev, p ) != 1 || g->m.impassable( p ) ) {
+            return false;
+        }
+        prev = p;
+    }
+    return true;
+}
+
+TEST_CASE( "route_around_long_wall", "[pathfinding]" )
+{
+    clear_map();
+    const int mapsize = g->m.getmapsize() * SEEX;
+    const int wall_x = mapsize / 2;
+    const int gap_y = mapsize - 3;
+    build_wall_with_gap( wall_x, gap_y );
+
+    const tripoint from( wall_x - 30, mapsize / 2, 0 );
+    const tripoint to( wall_x + 30, mapsize / 2, 0 );
+    const std::vector<tripoint> route = g->m.route( from, to, walking );
+    REQUIRE_FALSE( route.empty() );
+    CHECK( route.back() == to );
+    CHECK( is_connected( from, route ) );
+    CHECK( std::find( route.begin(), route.end(), tripoint( wall_x, gap_y, 0 ) ) != route.end() );
+
+    // The search workspace is reused, repeated searches must give the same result.
+    CHECK( g->m.route( from, to, walking ) == route );
+
+    SECTION( "closing the gap makes the destination unreachable" ) {
+        g->m.ter_set( tripoint( wall_x, gap_y, 0 ), ter_id( "t_rock" ) );
+        CHECK( g->m.route( from, to, walking ).empty() );
+    }
+}
+
+TEST_CASE( "pathfinding_regions_split_at_walls", "[pathfinding]" )
+{
+    clear_map();
+    build_wall_with_gap( SEEX + 5, -1 );
+
+    const pathfinding_regions &regions = g->m.get_pathfinding_regions( 0 );
+    const short left = regions.tile_region[SEEX + 1][SEEY];
+    const short right = regions.tile_region[SEEX + 8][SEEY];
+    REQUIRE( left != pathfinding_regions::no_region );
+    REQUIRE( right != pathfinding_regions::no_region );
+    CHECK( left != right );
+    CHECK( regions.tile_region[SEEX + 5][SEEY] == pathfinding_regions::no_region );
+    CHECK( regions.regions[left].cluster == point( 1, 1 ) );
+    CHECK( regions.regions[right].cluster == point( 1, 1 ) );
+    // Both halves connect to the neighboring submaps, but not to each other.
+    CHECK( std::find( regions.regions[left].neighbors.begin(), regions.regions[left].neighbors.end(),
+                      right ) == regions.regions[left].neighbors.end() );
+    // The wall splits the submaps above and below as well, so the left half links
+    // to the three open submaps to the west and the left halves above and below.
+    std::vector<int> expected_neighbors;
+    for( const point &p : {
+             point( SEEX - 1, SEEY - 1 ), point( SEEX - 1, SEEY ), point( SEEX - 1, SEEY * 2 ),
+             point( SEEX + 1, SEEY - 1 ), point( SEEX + 1, SEEY * 2 )
+         } ) {
+        expected_neighbors.push_back( regions.tile_region[p.x][p.y] );
+    }
+    std::sort( expected_neighbors.begin(), expected_neighbors.end() );
+    CHECK( regions.regions[left].neighbors == expected_neighbors );
+}
+
+TEST_CASE( "route_cache_reuse_and_invalidation", "[pathfinding]" )
+{
+    clear_map();
+    const tripoint from( 20, 20, 0 );
+    const tripoint to( 40, 25, 0 );
+    // A wall in the way, so the straight line shortcut doesn't apply.
+    for( int y = 10; y <= 30; y++ ) {
+        g->m.ter_set( tripoint( 30, y, 0 ), ter_id( "t_rock" ) );
+    }
+
+    const std::vector<tripoint> route = g->m.route( from, to, walking );
+    REQUIRE( route.size() > 3 );
+    CHECK( is_connected( from, route ) );
+
+    // Starting anywhere on a known route gives the rest of it. This must be
+    // before the wall, from behind it the straight line shortcut applies.
+    const tripoint on_route = route[1];
+    REQUIRE( on_route.x < 30 );
+    const std::vector<tripoint> rest = g->m.route( on_route, to, walking );
+    CHECK( rest == std::vector<tripoint>( route.begin() + 2, route.end() ) );
+
+    // Changing the terrain invalidates cached routes.
+    for( int y = 0; y < g->m.getmapsize() * SEEY; y++ ) {
+        g->m.ter_set( tripoint( 35, y, 0 ), ter_id( "t_rock" ) );
+    }
+    CHECK( g->m.route( from, to, walking ).empty() );
+}
+
+TEST_CASE( "flow_route_matches_route_cost", "[pathfinding]" )
+{
+    clear_map();
+    const tripoint goal( 60, 60, 0 );
+    // Short enough for map::route to get around within its search area.
+    for( int y = 50; y <= 70; y++ ) {
+        g->m.ter_set( tripoint( 55, y, 0 ), ter_id( "t_rock" ) );
+    }
+
+    // Moves onto flat ground cost 2, diagonal ones 1 more.
+    const auto cost = []( const tripoint & from, const std::vector<tripoint> &route ) {
+        int total = 0;
+        tripoint prev = from;
+        for( const tripoint &p : route ) {
+            total += 2 + ( p.x != prev.x && p.y != prev.y ? 1 : 0 );
+            prev = p;
+        }
+        return total;
+    };
+
+    for( const tripoint &start : {
+             tripoint( 40, 60, 0 ), tripoint( 45, 50, 0 ), tripoint( 80, 70, 0 )
+         } ) {
+        const std::vector<tripoint> flow = g->m.flow_route( start, goal, walking );
+        const std::vector<tripoint> route = g->m.route( start, goal, walking );
+        REQUIRE_FALSE( flow.empty() );
+        CHECK( flow.back() == goal );
+        CHECK( is_connected( start, flow ) );
+        CHECK( cost( start, flow ) <= cost( start, route ) );
+    }
+
+    // Out of reach of max_length
+    const pathfinding_settings short_walk( 0, 1000, 10, 0, false, false, true, false );
+    CHECK( g->m.flow_route( tripoint( 40, 60, 0 ), goal, short_walk ).empty() );
+}
+
+TEST_CASE( "long_route_through_door", "[pathfinding]" )
+{
+    clear_map();
+    const int mapsize = g->m.getmapsize() * SEEX;
+    const int wall_x = mapsize / 2;
+    const int gap_y = mapsize - 3;
+    build_wall_with_gap( wall_x, gap_y );
+    const tripoint door( wall_x, mapsize / 2, 0 );
+    g->m.ter_set( door, ter_id( "t_door_c" ) );
+
+    const tripoint from( wall_x - 30, mapsize / 2, 0 );
+    const tripoint to( wall_x + 30, mapsize / 2, 0 );
+    // Far enough for the region corridor, which doesn't know about doors.
+    const pathfinding_settings opening( 0, 1000, 1000, 0, true, false, true, false );
+    const std::vector<tripoint> route = g->m.route( from, to, opening );
+    REQUIRE_FALSE( route.empty() );
+    CHECK( route.back() == to );
+    CHECK( std::find( route.begin(), route.end(), door ) != route.end() );
+    // Same as the search padded around the straight line, which is the line itself.
+    CHECK( static_cast<int>( route.size() ) == rl_dist( from, to ) );
+
+    // Without opening doors the gap is the only way through.
+    const std::vector<tripoint> around = g->m.route( from, to, walking );
+    REQUIRE_FALSE( around.empty() );
+    CHECK( std::find( around.begin(), around.end(), tripoint( wall_x, gap_y, 0 ) ) != around.end() );
+}
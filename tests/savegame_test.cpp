@@ -1,5 +1,6 @@
 #include <fstream>
 #include <memory>
+#include <sstream>
 #include <algorithm>
 #include <string>
 #include <utility>
@@ -7,6 +8,7 @@
 
 #include "catch/catch.hpp"
 #include "filesystem.h"
+#include "json.h"
 #include "mongroup.h"
 #include "npc.h"
 #include "overmap.h"
@@ -250,3 +252,24 @@ TEST_CASE( "Reading a legacy overmap save." )
     // Now clean up.
     remove_file( new_save_name );
 }
+
+TEST_CASE( "horde_behaviour_survives_saving" )
+{
+    const std::vector<mongroup::behaviour> behaviours = {
+        mongroup::behaviour::none, mongroup::behaviour::city, mongroup::behaviour::roam
+    };
+    for( const mongroup::behaviour behaviour : behaviours ) {
+        mongroup group( mongroup_id( "GROUP_ZOMBIE" ), 1, 2, 0, 1, 10 );
+        group.horde = true;
+        group.horde_behaviour = behaviour;
+
+        std::ostringstream os;
+        JsonOut jsout( os );
+        group.serialize( jsout );
+        std::istringstream is( os.str() );
+        JsonIn jsin( is );
+        mongroup loaded;
+        loaded.deserialize( jsin );
+        CHECK( loaded.horde_behaviour == behaviour );
+    }
+}
@@ -0,0 +1,108 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+#include "catch/catch.hpp"
+#include "game_constants.h"
+#include "rng.h"
+#include "scent_map.h"
+
+using scent_diffusion::grid;
+using scent_diffusion::kernel;
+using scent_grid = grid<scent_diffusion::value>;
+
+// Constants setting the ratio of set to unset tiles.
+constexpr int BLOCKS_DENOMINATOR = 10;
+constexpr int REDUCES_DENOMINATOR = 5;
+// Same as the area scent_map::update diffuses.
+constexpr int SCENT_RADIUS = 40;
+
+struct scent_fixture {
+    scent_grid scent;
+    grid<bool> blocks_scent;
+    grid<bool> reduces_scent;
+};
+
+static void randomly_fill_scent( scent_fixture &fixture )
+{
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            fixture.scent[x][y] = one_in( 4 ) ? 0 : rng( 0, scent_diffusion::max_value );
+            fixture.blocks_scent[x][y] = one_in( BLOCKS_DENOMINATOR );
+            fixture.reduces_scent[x][y] = one_in( REDUCES_DENOMINATOR );
+        }
+    }
+}
+
+static bool grids_are_equal( const scent_grid &control, const scent_grid &experiment,
+                             const kernel k )
+{
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            if( control[x][y] != experiment[x][y] ) {
+                printf( "%s kernel differs at (%d,%d): %d != %d\n", scent_diffusion::kernel_name( k ),
+                        x, y, experiment[x][y], control[x][y] );
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void scent_diffusion_runoff( const int iterations, const bool report, const int minx,
+                                    const int miny, const int maxx, const int maxy )
+{
+    // These are too big for the stack.
+    std::unique_ptr<scent_fixture> fixture( new scent_fixture() );
+    randomly_fill_scent( *fixture );
+    std::unique_ptr<scent_grid> control( new scent_grid( fixture->scent ) );
+    std::unique_ptr<scent_grid> experiment( new scent_grid() );
+
+    for( const kernel k : {
+             kernel::scalar, kernel::sse2, kernel::avx2
+         } ) {
+        if( !scent_diffusion::kernel_supported( k ) ) {
+            continue;
+        }
+        *experiment = fixture->scent;
+        const auto start = std::chrono::high_resolution_clock::now();
+        for( int i = 0; i < iterations; i++ ) {
+            scent_diffusion::diffuse( k, *experiment, fixture->blocks_scent, fixture->reduces_scent,
+                                      minx, miny, maxx, maxy );
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        if( k == kernel::scalar ) {
+            *control = *experiment;
+        }
+
+        if( report ) {
+            const long diff = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+            printf( "%s scent diffusion executed %d times in %ld microseconds.\n",
+                    scent_diffusion::kernel_name( k ), iterations, diff );
+        }
+
+        REQUIRE( grids_are_equal( *control, *experiment, k ) );
+    }
+}
+
+TEST_CASE( "scent_diffusion_kernels_are_equivalent", "[scent]" )
+{
+    const int center = MAPSIZE_X / 2;
+    SECTION( "full scent radius" ) {
+        scent_diffusion_runoff( 3, false, center - SCENT_RADIUS, center - SCENT_RADIUS,
+                                center + SCENT_RADIUS, center + SCENT_RADIUS );
+    }
+    SECTION( "columns that are not a multiple of the vector width" ) {
+        scent_diffusion_runoff( 3, false, 5, 7, 20, 17 );
+    }
+    SECTION( "columns shorter than the vector width" ) {
+        scent_diffusion_runoff( 3, false, 10, 10, 13, 12 );
+    }
+}
+
+TEST_CASE( "scent_diffusion_performance", "[.]" )
+{
+    const int center = MAPSIZE_X / 2;
+    scent_diffusion_runoff( 10000, true, center - SCENT_RADIUS, center - SCENT_RADIUS,
+                            center + SCENT_RADIUS, center + SCENT_RADIUS );
+}
@@ -1,7 +1,10 @@
+#include <sstream>
 #include <string>
 
 #include "catch/catch.hpp"
+#include "mapbuffer.h"
 #include "submap.h"
+#include "trap.h"
 #include "vehicle.h"
 
 
@@ -88,3 +91,48 @@ TEST_CASE( "submap rotation", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap binary round trip", "[submap]" )
+{
+    const ter_id t_dirt = ter_str_id( "t_dirt" ).id();
+    const ter_id t_floor = ter_str_id( "t_floor" ).id();
+    const furn_id f_chair = furn_str_id( "f_chair" ).id();
+    const trap_id tr_bubblewrap = trap_str_id( "tr_bubblewrap" ).id();
+
+    submap sm;
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            sm.set_ter( { x, y }, y < SEEY / 2 ? t_dirt : t_floor );
+        }
+    }
+    sm.set_furn( { 3, 4 }, f_chair );
+    sm.set_trap( { SEEX - 1, SEEY - 1 }, tr_bubblewrap );
+    sm.set_radiation( { 5, 6 }, 42 );
+    sm.set_temperature( 17 );
+    sm.itm[2][2].insert( item( "rock", 0 ) );
+
+    const tripoint pos( 10, -20, 1 );
+    std::ostringstream out;
+    serialize_submaps_binary( out, { { pos, &sm } } );
+    const std::string data = out.str();
+    REQUIRE( is_binary_submap_data( data ) );
+
+    binary_submap_list loaded = deserialize_submaps_binary( data );
+    REQUIRE( loaded.size() == 1 );
+    CHECK( loaded[0].first == pos );
+    const submap &copy = *loaded[0].second;
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            const point p( x, y );
+            CHECK( copy.get_ter( p ) == sm.get_ter( p ) );
+            CHECK( copy.get_furn( p ) == sm.get_furn( p ) );
+            CHECK( copy.get_trap( p ) == sm.get_trap( p ) );
+            CHECK( copy.get_radiation( p ) == sm.get_radiation( p ) );
+            CHECK( copy.itm[x][y].size() == sm.itm[x][y].size() );
+        }
+    }
+    CHECK( copy.get_temperature() == 17 );
+
+    CHECK_FALSE( is_binary_submap_data( "[{\"version\":27}]" ) );
+    CHECK_THROWS( deserialize_submaps_binary( data.substr( 0, data.size() / 2 ) ) );
+}
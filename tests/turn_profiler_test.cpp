@@ -0,0 +1,66 @@
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include "catch/catch.hpp"
+#include "turn_profiler.h"
+
+using std::chrono::microseconds;
+
+TEST_CASE( "phase_stats_histogram", "[turn_profiler]" )
+{
+    turn_profiler::phase_stats stats;
+    CHECK( stats.mean_ms() == 0.0 );
+    CHECK( stats.percentile_ms( 50 ) == 0.0 );
+
+    for( int i = 0; i < 99; i++ ) {
+        stats.add( microseconds( 100 ) );
+    }
+    stats.add( microseconds( 5000 ) );
+
+    CHECK( stats.samples == 100 );
+    CHECK( stats.max == microseconds( 5000 ) );
+    CHECK( stats.last == microseconds( 5000 ) );
+    CHECK( stats.mean_ms() == Approx( 0.149 ) );
+    // 100us lands in the [64us, 128us) bucket.
+    CHECK( stats.histogram[7] == 99 );
+    CHECK( stats.percentile_ms( 50 ) == Approx( 0.128 ) );
+    CHECK( stats.percentile_ms( 99 ) == Approx( 0.128 ) );
+    // The upper bound of the top bucket is clamped to the real maximum.
+    CHECK( stats.percentile_ms( 100 ) == Approx( 5.0 ) );
+
+    stats.reset();
+    CHECK( stats.samples == 0 );
+    CHECK( stats.max == microseconds( 0 ) );
+}
+
+TEST_CASE( "turn_profiler_disabled_records_nothing", "[turn_profiler]" )
+{
+    turn_profiler::reset();
+    turn_profiler::set_enabled( false );
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::scent );
+    }
+    turn_profiler::end_turn();
+    CHECK( turn_profiler::get_stats( turn_profiler::phase::scent ).samples == 0 );
+    CHECK( turn_profiler::get_turn_stats().samples == 0 );
+
+    turn_profiler::set_enabled( true );
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::scent );
+    }
+    {
+        turn_profiler::scoped_timer timer( turn_profiler::phase::monmove );
+    }
+    turn_profiler::end_turn();
+    turn_profiler::set_enabled( false );
+    CHECK( turn_profiler::get_stats( turn_profiler::phase::scent ).samples == 1 );
+    CHECK( turn_profiler::get_stats( turn_profiler::phase::monmove ).samples == 1 );
+    CHECK( turn_profiler::get_turn_stats().samples == 1 );
+
+    std::ostringstream csv;
+    turn_profiler::write_csv( csv );
+    CHECK( csv.str().find( "\nscent,1," ) != std::string::npos );
+    CHECK( csv.str().find( "\nturn,1," ) != std::string::npos );
+    turn_profiler::reset();
+}
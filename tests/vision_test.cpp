@@ -2,6 +2,7 @@
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <array>
 #include <list>
 #include <memory>
 #include <string>
@@ -16,6 +17,7 @@
 #include "map.h"
 #include "mapdata.h"
 #include "map_helpers.h"
+#include "parallel.h"
 #include "calendar.h"
 #include "enums.h"
 #include "item.h"
@@ -488,3 +490,101 @@ TEST_CASE( "vision_see_wall_in_moonlight", "[shadowcasting][vision]" )
 
     t.test_all();
 }
+
+TEST_CASE( "seen_cache_partial_update_matches_full_rebuild", "[shadowcasting][vision]" )
+{
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_floor( "t_floor" );
+
+    g->place_player( tripoint( 60, 60, 0 ) );
+    clear_map();
+    const tripoint &origin = g->u.pos();
+    // Scatter some pillars so that the octants shadow each other.
+    for( int x = 0; x < MAPSIZE_X; x += 7 ) {
+        for( int y = 3; y < MAPSIZE_Y; y += 5 ) {
+            if( tripoint( x, y, 0 ) != origin ) {
+                g->m.ter_set( tripoint( x, y, 0 ), t_brick_wall );
+            }
+        }
+    }
+    g->m.build_map_cache( 0, true );
+
+    // Open some pillars and add walls, near the player, on an octant edge and far away.
+    g->m.ter_set( origin + tripoint( 3, 0, 0 ), t_brick_wall );
+    g->m.ter_set( origin + tripoint( -5, -5, 0 ), t_brick_wall );
+    g->m.ter_set( tripoint( 63, 53, 0 ), t_floor );
+    g->m.ter_set( tripoint( 14, 100, 0 ), t_brick_wall );
+    g->m.build_map_cache( 0, true );
+
+    const level_cache &cache = g->m.access_cache( 0 );
+    std::unique_ptr<float[]> updated( new float[MAPSIZE_X * MAPSIZE_Y] );
+    std::copy_n( &cache.seen_cache[0][0], MAPSIZE_X * MAPSIZE_Y, updated.get() );
+
+    g->m.invalidate_map_cache( 0 );
+    g->m.build_map_cache( 0, true );
+
+    int mismatches = 0;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            if( cache.seen_cache[x][y] != updated[x * MAPSIZE_Y + y] ) {
+                mismatches++;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+}
+
+TEST_CASE( "vision_lightmap_same_in_parallel", "[shadowcasting][vision]" )
+{
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_utility_light( "t_utility_light" );
+
+    g->place_player( tripoint( 60, 60, 0 ) );
+    g->u.worn.clear();
+    clear_map();
+    g->reset_light_level();
+    calendar::turn = midnight;
+
+    // Enough bulk light sources for four workers, with walls casting shadows
+    // across the parts of the map the workers split between them.
+    for( int i = 0; i < 96; i++ ) {
+        g->m.ter_set( tripoint( 4 + i * 37 % ( MAPSIZE_X - 8 ), 4 + i * 53 % ( MAPSIZE_Y - 8 ), 0 ),
+                      t_utility_light );
+    }
+    for( int i = 10; i < MAPSIZE_X - 10; i++ ) {
+        g->m.ter_set( tripoint( i, 30, 0 ), t_brick_wall );
+        g->m.ter_set( tripoint( 90, i, 0 ), t_brick_wall );
+    }
+
+    const auto build = []() {
+        g->m.invalidate_map_cache( 0 );
+        g->m.build_map_cache( 0 );
+        return &g->m.access_cache( 0 );
+    };
+    std::vector<std::array<float, 4>> serial_lm;
+    std::vector<float> serial_sm;
+    {
+        cata::scoped_worker_count workers( 1 );
+        const level_cache &cache = *build();
+        for( int x = 0; x < MAPSIZE_X; x++ ) {
+            for( int y = 0; y < MAPSIZE_Y; y++ ) {
+                serial_lm.push_back( cache.lm[x][y].values );
+                serial_sm.push_back( cache.sm[x][y] );
+            }
+        }
+    }
+    REQUIRE( *std::max_element( serial_sm.begin(), serial_sm.end() ) > 0.0f );
+
+    cata::scoped_worker_count workers( 4 );
+    const level_cache &cache = *build();
+    int mismatches = 0;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            const size_t i = x * MAPSIZE_Y + y;
+            if( cache.lm[x][y].values != serial_lm[i] || cache.sm[x][y] != serial_sm[i] ) {
+                mismatches++;
+            }
+        }
+    }
+    CHECK( mismatches == 0 );
+}